@@ -3,6 +3,7 @@
 #include <string.h>
 #include <stdarg.h>
 #include "ast.h"
+#include "saida.h"
 
 NoAST* criarNo(TipoAST tipo, char* valor, char* tipoDado, int n_filhos, ...) {
     NoAST* no = malloc(sizeof(NoAST));
@@ -10,6 +11,8 @@ NoAST* criarNo(TipoAST tipo, char* valor, char* tipoDado, int n_filhos, ...) {
     no->valor     = valor     ? strdup(valor)     : NULL;
     no->tipoDado  = tipoDado  ? strdup(tipoDado)  : NULL;
     no->n_filhos  = n_filhos;
+    no->linha     = 0;
+    no->coluna    = 0;
 
     if (n_filhos > 0) {
         // calloc já zera todos os ponteiros
@@ -37,6 +40,14 @@ void adicionarFilho(NoAST* pai, NoAST* filho) {
     pai->n_filhos++;
 }
 
+// Registra a posição (linha/coluna do fonte C) de um nó.
+// Aceita NULL para simplificar o uso nas ações do parser.
+void marcarPosicao(NoAST* no, int linha, int coluna) {
+    if (!no) return;
+    no->linha  = linha;
+    no->coluna = coluna;
+}
+
 void liberarNo(NoAST* no) {
     if (!no) return;
     free(no->valor);
@@ -53,27 +64,40 @@ void liberarAST(NoAST* raiz) {
     liberarNo(raiz);
 }
 
+static const char* nomesTipoAST[] = {
+    "AST_DECL", "AST_ATRIB", "AST_PRINT", "AST_IF", "AST_IF_ELSE", "AST_WHILE",
+    "AST_FOR", "AST_DO_WHILE", "AST_BLOCO", "AST_EXPR", "AST_ID", "AST_NUM",
+    "AST_CHAR", "AST_STRING", "AST_LISTA_ARGS", "AST_CALL", "AST_FUNC_DEF",
+    "AST_RETURN", "AST_BREAK", "AST_CONTINUE"
+};
+
+const char* nomeTipoAST(TipoAST tipo) {
+    if ((unsigned)tipo < sizeof(nomesTipoAST) / sizeof(nomesTipoAST[0])) return nomesTipoAST[tipo];
+    return "AST_?";
+}
+
+// Escreve a árvore na saída do compilador (--emit=ast). A saída não contém
+// endereços de memória: a mesma entrada sempre produz o mesmo texto.
 void imprimirAST(NoAST* no, int nivel) {
     // 1) se o nó for NULL, só imprime e volta
     if (!no) {
-        printf("%*s[NULL]\n", nivel*2, "");
+        saida_printf("%*s[NULL]\n", nivel*2, "");
         return;
     }
 
-    // 2) imprime o próprio nó com endereço e quantidade de filhos
-    printf("%*sNode %p → Tipo: %d, n_filhos: %d",
-           nivel*2, "", (void*)no, no->tipo, no->n_filhos);
-    if (no->valor)    printf(", Valor: %s",    no->valor);
-    if (no->tipoDado) printf(", TipoDado: %s", no->tipoDado);
-    printf("\n");
+    // 2) imprime o próprio nó com tipo, quantidade de filhos e posição
+    saida_printf("%*sTipo: %s, n_filhos: %d",
+                 nivel*2, "", nomeTipoAST(no->tipo), no->n_filhos);
+    if (no->valor)     saida_printf(", Valor: %s",    no->valor);
+    if (no->tipoDado)  saida_printf(", TipoDado: %s", no->tipoDado);
+    if (no->linha > 0) saida_printf(", Pos: %d:%d",   no->linha, no->coluna);
+    saida_char('\n');
 
     // 3) se não há vetor de filhos, encerra aqui
     if (!no->filhos) return;
 
-    // 4) para cada filho, imprime o ponteiro antes de chamar recursão
+    // 4) filhos um nível abaixo
     for (int i = 0; i < no->n_filhos; i++) {
-        printf("%*s─ filho[%d] ptr: %p\n",
-               nivel*2, "", i, (void*)no->filhos[i]);
         imprimirAST(no->filhos[i], nivel + 1);
     }
 }
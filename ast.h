@@ -19,7 +19,9 @@ typedef enum {
     AST_LISTA_ARGS,
     AST_CALL,
     AST_FUNC_DEF, 
-    AST_RETURN 
+    AST_RETURN,
+    AST_BREAK,
+    AST_CONTINUE
 } TipoAST;
 
 typedef struct NoAST {
@@ -28,12 +30,16 @@ typedef struct NoAST {
     char* tipoDado;   
     struct NoAST **filhos; 
     int n_filhos;
+    int linha;        // Posição no fonte C (0 = desconhecida)
+    int coluna;
 } NoAST;
 
 NoAST*    criarNo      (TipoAST tipo, char* valor, char* tipoDado, int n_filhos, ...);
 void      adicionarFilho(NoAST* pai, NoAST* filho);
+void      marcarPosicao(NoAST* no, int linha, int coluna);
 void      liberarNo    (NoAST* no);
 void      liberarAST   (NoAST* raiz);
 void      imprimirAST  (NoAST* no, int nivel);
+const char* nomeTipoAST(TipoAST tipo);
 
 #endif
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+# Benchmark das chamadas à biblioteca padrão no Python gerado: o mesmo laço
+# quente com sqrt, fabs, floor e rand, com as ligações locais (--ligar=1,
+# `_sqrt = _math.sqrt` no início da função) e sem elas (--ligar=0, busca do
+# módulo e do atributo a cada chamada), em .py e, no Python 3.11, em .pyc.
+#
+# Uso (a partir da raiz, com ./compiler já compilado):
+#   python3 benchmarks/bench_biblioteca.py [repetições]
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+COMPILADOR = "./compiler"
+
+NUCLEO = """
+int main() {
+    int i; double s; double x;
+    srand(7);
+    s = 0.0;
+    for (i = 0; i < 200000; i = i + 1) {
+        x = rand() % 1000 - 500.0;
+        s = s + sqrt(fabs(x)) + floor(x / 7.0);
+    }
+    printf("%.3f\\n", s);
+    return 0;
+}
+"""
+
+# (nome, opções do compilador, formato)
+CASOS = [
+    ("py  --ligar=0", ["--ligar=0"], "py"),
+    ("py  --ligar=1", ["--ligar=1"], "py"),
+    ("pyc --ligar=0", ["--ligar=0"], "pyc"),
+    ("pyc --ligar=1", ["--ligar=1"], "pyc"),
+]
+
+
+def executar(programa, repeticoes):
+    melhor, saida = None, None
+    for _ in range(repeticoes):
+        inicio = time.perf_counter()
+        r = subprocess.run([sys.executable, programa], capture_output=True, text=True, check=True)
+        t = time.perf_counter() - inicio
+        melhor = t if melhor is None else min(melhor, t)
+        saida = r.stdout.strip()
+    return melhor, saida
+
+
+def main():
+    repeticoes = int(sys.argv[1]) if len(sys.argv) > 1 else 3
+    if not os.path.exists(COMPILADOR):
+        sys.exit(f"Erro: {COMPILADOR} não encontrado (compile o projeto antes).")
+    # O .pyc é do CPython 3.11
+    casos = [c for c in CASOS if c[2] == "py" or sys.version_info[:2] == (3, 11)]
+
+    with tempfile.TemporaryDirectory() as tmp:
+        fonte = os.path.join(tmp, "nucleo.c")
+        with open(fonte, "w") as f:
+            f.write(NUCLEO)
+        base = None
+        for nome, opcoes, formato in casos:
+            programa = os.path.join(tmp, "nucleo." + formato)
+            subprocess.run([COMPILADOR, *opcoes, f"--emit={formato}", fonte, "-o", programa], check=True)
+            t, saida = executar(programa, repeticoes)
+            base = base or t
+            print(f"{nome:<14} {t * 1e3:8.1f} ms  ({t / base:.2f}x)  saída: {saida}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+# Benchmark do desenrolamento de laços (--desenrolar): gera núcleos com laços
+# curtos aninhados, traduz cada um para Python com o passo desligado e com
+# fatores diferentes, confere que a saída é a mesma e compara o tempo de
+# execução do Python gerado.
+#
+# Uso (a partir da raiz, com ./compiler já compilado):
+#   python3 benchmarks/bench_desenrolar.py [repetições] [fatores...]
+#   python3 benchmarks/bench_desenrolar.py 5 1 2 4 8
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+COMPILADOR = "./compiler"
+
+# Cada núcleo repete `externo` vezes um trabalho feito com laços curtos
+NUCLEOS = {
+    # 3 níveis de trip count conhecido (4 x 4 x 4): viram código reto
+    "aninhado_4x4x4": """
+int main() {
+    int r; int i; int j; int k; int soma;
+    soma = 0;
+    for (r = 0; r < 20000; r = r + 1) {
+        for (i = 0; i < 4; i = i + 1) {
+            for (j = 0; j < 4; j = j + 1) {
+                for (k = 0; k < 4; k = k + 1) {
+                    soma = soma + i * j - k;
+                }
+            }
+        }
+    }
+    printf("%d\\n", soma);
+    return 0;
+}
+""",
+    # Produto 8x8 linearizado: o laço interno tem 8 iterações
+    "produto_8x8": """
+int main() {
+    int r; int i; int j; int acc; int total;
+    total = 0;
+    for (r = 0; r < 20000; r = r + 1) {
+        for (i = 0; i < 8; i = i + 1) {
+            acc = 0;
+            for (j = 0; j < 8; j = j + 1) {
+                acc = acc + i * j + r;
+            }
+            total = total + acc % 7;
+        }
+    }
+    printf("%d\\n", total);
+    return 0;
+}
+""",
+    # Limite em variável: só o desenrolamento parcial se aplica
+    "limite_variavel": """
+int main() {
+    int r; int i; int n; int soma;
+    soma = 0;
+    n = 50;
+    for (r = 0; r < 20000; r = r + 1) {
+        i = 0;
+        while (i < n) {
+            soma = soma + i;
+            i = i + 1;
+        }
+    }
+    printf("%d\\n", soma);
+    return 0;
+}
+""",
+}
+
+
+def traduzir(fonte, fator, destino):
+    subprocess.run([COMPILADOR, f"--desenrolar={fator}", "--emit=py", fonte, "-o", destino], check=True)
+
+
+def executar(programa, repeticoes):
+    melhor, saida = None, None
+    for _ in range(repeticoes):
+        inicio = time.perf_counter()
+        r = subprocess.run([sys.executable, programa], capture_output=True, text=True, check=True)
+        t = time.perf_counter() - inicio
+        melhor = t if melhor is None else min(melhor, t)
+        saida = r.stdout
+    return melhor, saida
+
+
+def main():
+    repeticoes = int(sys.argv[1]) if len(sys.argv) > 1 else 3
+    fatores = [int(f) for f in sys.argv[2:]] or [1, 2, 4, 8]
+    if not os.path.exists(COMPILADOR):
+        sys.exit(f"Erro: {COMPILADOR} não encontrado (compile o projeto antes).")
+
+    with tempfile.TemporaryDirectory() as tmp:
+        for nome, codigo in NUCLEOS.items():
+            fonte = os.path.join(tmp, nome + ".c")
+            with open(fonte, "w") as f:
+                f.write(codigo)
+
+            base = os.path.join(tmp, nome + "_0.py")
+            traduzir(fonte, 0, base)
+            t0, esperado = executar(base, repeticoes)
+            print(f"{nome:<18} sem desenrolar   {t0 * 1e3:8.1f} ms")
+
+            for fator in fatores:
+                programa = os.path.join(tmp, f"{nome}_{fator}.py")
+                traduzir(fonte, fator, programa)
+                t, saida = executar(programa, repeticoes)
+                if saida != esperado:
+                    sys.exit(f"Erro: saída diferente em {nome} com --desenrolar={fator}")
+                linhas = sum(1 for _ in open(programa))
+                print(f"{'':<18} --desenrolar={fator:<3} {t * 1e3:8.1f} ms  "
+                      f"({t0 / t:.2f}x, {linhas} linhas)")
+
+
+if __name__ == "__main__":
+    main()
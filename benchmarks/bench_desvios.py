@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# Benchmark dos laços com saída antecipada no Python gerado: a mesma busca
+# (o primeiro divisor de cada número) e o mesmo filtro escritos com uma
+# variável de controle testada na condição do laço, como era preciso antes
+# de break/continue, e com break/continue nativos, em .py e, no Python 3.11,
+# em .pyc.
+#
+# Uso (a partir da raiz, com ./compiler já compilado):
+#   python3 benchmarks/bench_desvios.py [repetições]
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+COMPILADOR = "./compiler"
+
+BUSCA_FLAG = """
+int main() {
+    int n; int d; int achou; int s;
+    s = 0;
+    for (n = 2; n < 20000; n = n + 1) {
+        achou = 0;
+        d = 2;
+        while (d * d <= n && achou == 0) {
+            if (n % d == 0) {
+                achou = d;
+            }
+            d = d + 1;
+        }
+        s = s + achou;
+    }
+    printf("%d\\n", s);
+    return 0;
+}
+"""
+
+BUSCA_BREAK = """
+int main() {
+    int n; int d; int achou; int s;
+    s = 0;
+    for (n = 2; n < 20000; n = n + 1) {
+        achou = 0;
+        for (d = 2; d * d <= n; d = d + 1) {
+            if (n % d == 0) {
+                achou = d;
+                break;
+            }
+        }
+        s = s + achou;
+    }
+    printf("%d\\n", s);
+    return 0;
+}
+"""
+
+FILTRO_FLAG = """
+int main() {
+    int i; int s; int pula;
+    s = 0;
+    for (i = 0; i < 300000; i = i + 1) {
+        pula = i % 3 == 0 || i % 5 == 0;
+        if (pula == 0) {
+            s = s + i % 7;
+        }
+    }
+    printf("%d\\n", s);
+    return 0;
+}
+"""
+
+FILTRO_CONTINUE = """
+int main() {
+    int i; int s;
+    s = 0;
+    for (i = 0; i < 300000; i = i + 1) {
+        if (i % 3 == 0 || i % 5 == 0) {
+            continue;
+        }
+        s = s + i % 7;
+    }
+    printf("%d\\n", s);
+    return 0;
+}
+"""
+
+# (nome, fonte); cada caso nativo é comparado com o caso com variável antes dele
+CASOS = [
+    ("busca com flag", BUSCA_FLAG),
+    ("busca com break", BUSCA_BREAK),
+    ("filtro com flag", FILTRO_FLAG),
+    ("filtro com continue", FILTRO_CONTINUE),
+]
+
+
+def executar(programa, repeticoes):
+    melhor, saida = None, None
+    for _ in range(repeticoes):
+        inicio = time.perf_counter()
+        r = subprocess.run([sys.executable, programa], capture_output=True, text=True, check=True)
+        t = time.perf_counter() - inicio
+        melhor = t if melhor is None else min(melhor, t)
+        saida = r.stdout.strip()
+    return melhor, saida
+
+
+def main():
+    repeticoes = int(sys.argv[1]) if len(sys.argv) > 1 else 3
+    if not os.path.exists(COMPILADOR):
+        sys.exit(f"Erro: {COMPILADOR} não encontrado (compile o projeto antes).")
+    # O .pyc é do CPython 3.11
+    formatos = ["py"] + (["pyc"] if sys.version_info[:2] == (3, 11) else [])
+
+    with tempfile.TemporaryDirectory() as tmp:
+        for formato in formatos:
+            base = None
+            for k, (nome, texto) in enumerate(CASOS):
+                fonte = os.path.join(tmp, "nucleo.c")
+                programa = os.path.join(tmp, "nucleo." + formato)
+                with open(fonte, "w") as f:
+                    f.write(texto)
+                subprocess.run([COMPILADOR, f"--emit={formato}", fonte, "-o", programa], check=True)
+                t, saida = executar(programa, repeticoes)
+                base = t if k % 2 == 0 else base
+                print(f"{formato:<3} {nome:<20} {t * 1e3:8.1f} ms  ({t / base:.2f}x)  saída: {saida}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+# Benchmark do passo de eliminação de código morto (--eliminar): gera um
+# programa grande no estilo de código gerado (valores calculados e nunca
+# lidos, ramos de depuração desligados por macro, braços vazios e sobras depois de
+# return), traduz com o passo desligado e ligado, confere que a saída é a
+# mesma e compara o tempo do compilador, o tamanho do Python gerado, o tempo
+# de compilação dele para bytecode e o tempo de execução.
+#
+# Uso (a partir da raiz, com ./compiler já compilado):
+#   python3 benchmarks/bench_eliminar.py [repetições] [blocos]
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+COMPILADOR = "./compiler"
+
+
+def gerar(n_blocos):
+    # Uma função só: as chamadas não são comandos na gramática
+    decl = "".join(f"    int s{b}; int lixo{b}; int t{b};\n" for b in range(n_blocos))
+    blocos = []
+    for b in range(n_blocos):
+        blocos.append(f"""
+    s{b} = {b};
+    for (i = 0; i < 500; i = i + 1) {{
+        lixo{b} = i * 7 + s{b};
+        t{b} = i ^ {b + 3};
+        lixo{b} = lixo{b} + t{b} * 3;
+        if (DEPURAR) {{
+            printf("{b} %d %d\\n", i, lixo{b});
+        }}
+        if (0) {{
+            printf("nunca %d\\n", t{b});
+        }}
+        if (t{b} > 5) {{
+        }} else {{
+        }}
+        s{b} = (s{b} + t{b}) & 65535;
+    }}
+    printf("{b}: %d\\n", s{b});
+""")
+    return ("#define DEPURAR 0\nint main() {\n    int i;\n" + decl + "".join(blocos) +
+            "    return 0;\n    printf(\"inalcançável\\n\");\n}\n")
+
+
+def traduzir(fonte, eliminar, destino, repeticoes):
+    melhor = None
+    for _ in range(repeticoes):
+        inicio = time.perf_counter()
+        subprocess.run([COMPILADOR, f"--eliminar={eliminar}", "--emit=py", fonte, "-o", destino], check=True)
+        t = time.perf_counter() - inicio
+        melhor = t if melhor is None else min(melhor, t)
+    return melhor
+
+
+def bytecode(programa, repeticoes):
+    with open(programa) as f:
+        codigo = f.read()
+    melhor = None
+    for _ in range(repeticoes):
+        inicio = time.perf_counter()
+        compile(codigo, programa, "exec")
+        t = time.perf_counter() - inicio
+        melhor = t if melhor is None else min(melhor, t)
+    return melhor
+
+
+def executar(programa, repeticoes):
+    melhor, saida = None, None
+    for _ in range(repeticoes):
+        inicio = time.perf_counter()
+        r = subprocess.run([sys.executable, programa], capture_output=True, text=True, check=True)
+        t = time.perf_counter() - inicio
+        melhor = t if melhor is None else min(melhor, t)
+        saida = r.stdout
+    return melhor, saida
+
+
+def main():
+    repeticoes = int(sys.argv[1]) if len(sys.argv) > 1 else 3
+    n_blocos = int(sys.argv[2]) if len(sys.argv) > 2 else 200
+    if not os.path.exists(COMPILADOR):
+        sys.exit(f"Erro: {COMPILADOR} não encontrado (compile o projeto antes).")
+
+    with tempfile.TemporaryDirectory() as tmp:
+        fonte = os.path.join(tmp, "mortos.c")
+        with open(fonte, "w") as f:
+            f.write(gerar(n_blocos))
+
+        medidas = {}
+        for eliminar in (0, 1):
+            programa = os.path.join(tmp, f"mortos_{eliminar}.py")
+            t_comp = traduzir(fonte, eliminar, programa, repeticoes)
+            t_byte = bytecode(programa, repeticoes)
+            t_exec, saida = executar(programa, repeticoes)
+            medidas[eliminar] = (t_comp, os.path.getsize(programa), t_byte, t_exec, saida)
+        if medidas[0][4] != medidas[1][4]:
+            sys.exit("Erro: saída diferente com --eliminar=1")
+
+        print(f"{n_blocos} blocos")
+        print(f"{'':<14}{'compilador':>12}{'tamanho':>12}{'bytecode':>12}{'execução':>12}")
+        for eliminar in (0, 1):
+            t_comp, tamanho, t_byte, t_exec, _ = medidas[eliminar]
+            print(f"--eliminar={eliminar:<3}{t_comp * 1e3:9.1f} ms{tamanho:>9d} B "
+                  f"{t_byte * 1e3:9.1f} ms{t_exec * 1e3:9.1f} ms")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,169 @@
+// Benchmark de carga do HLIR: compara reler a listagem em texto (--emit=hlir)
+// com abrir o HLIR binário (--emit=bin) do mesmo programa.
+//
+//   texto  lê o arquivo e separa cada linha em opcode e operandos (cópia de
+//          cada operando), o trabalho mínimo de quem consome o texto
+//   mmap   mapeia o binário e percorre as quádruplas direto do mapa
+//   lista  mapeia e reconstrói as quádruplas em memória (hlirbin_carregar_funcao),
+//          como faz o compilador ao receber um .bin
+//
+// Compilação (a partir da raiz):
+//   gcc -O2 -I. benchmarks/bench_hlir.c hlirbin.c codegen.c saida.c ast.c tabela.c -o bench_hlir
+// Uso:
+//   ./compiler programa.c -o programa.hlir
+//   ./compiler --emit=bin programa.c -o programa.bin
+//   ./bench_hlir programa.hlir programa.bin [repetições]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "codegen.h"
+#include "hlirbin.h"
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static long tamanho_arquivo(const char* caminho) {
+    struct stat st;
+    return stat(caminho, &st) == 0 ? (long)st.st_size : -1;
+}
+
+// Opcode pelo nome, como o texto o imprime (ex.: "MUL", "BREAK_IF_FALSE")
+static int opcode_do_nome(const char* s, size_t n) {
+    for (int op = 0; op < CG_NUM_OPCODES; op++) {
+        const char* nome = nomeOpcode((OpCodeCG)op);
+        if (strlen(nome) == n && memcmp(nome, s, n) == 0) return op;
+    }
+    return -1;
+}
+
+// Lê a listagem em texto; retorna o número de quádruplas
+static long carregar_texto(const char* caminho, long* soma) {
+    FILE* f = fopen(caminho, "r");
+    if (!f) return -1;
+    char linha[4096];
+    long n = 0;
+    while (fgets(linha, sizeof(linha), f)) {
+        // "  12: @16:5 GT      t0 = x > 0"
+        char* p = linha;
+        while (*p == ' ') p++;
+        if (!isdigit((unsigned char)*p)) continue;  // cabeçalho/rodapé
+        while (isdigit((unsigned char)*p)) p++;
+        if (*p++ != ':') continue;
+        while (*p == ' ') p++;
+        if (*p == '@') while (*p && *p != ' ') p++;
+        while (*p == ' ') p++;
+
+        char* inicio = p;
+        while (*p && !isspace((unsigned char)*p)) p++;
+        int op = opcode_do_nome(inicio, (size_t)(p - inicio));
+
+        // Operandos: palavras e strings; "=", "," e operadores são pulados
+        while (*p) {
+            while (*p && (isspace((unsigned char)*p) || *p == ',')) p++;
+            if (!*p) break;
+            inicio = p;
+            if (*p == '"') {
+                for (p++; *p && *p != '"'; p++) if (*p == '\\' && p[1]) p++;
+                if (*p) p++;
+            } else {
+                while (*p && !isspace((unsigned char)*p) && *p != ',') p++;
+            }
+            if (isalnum((unsigned char)*inicio) || *inicio == '_' || *inicio == '"' ||
+                (*inicio == '-' && isdigit((unsigned char)inicio[1]))) {
+                char* operando = strndup(inicio, (size_t)(p - inicio));
+                *soma += operando[0];
+                free(operando);
+            }
+        }
+        *soma += op;
+        n++;
+    }
+    fclose(f);
+    return n;
+}
+
+// Percorre as quádruplas direto do mapa
+static long percorrer_binario(const char* caminho, long* soma) {
+    HlirArquivo arq;
+    if (!hlirbin_abrir(caminho, &arq)) return -1;
+    long n = 0;
+    for (uint32_t i = 0; i < arq.rodape->n_funcoes; i++) {
+        const HlirQuad* quads;
+        const HlirBloco* b = hlirbin_funcao(&arq, i, &quads);
+        for (uint32_t k = 0; k < b->n_quadruplas; k++) {
+            const HlirQuad* q = &quads[k];
+            *soma += q->op + q->resultado + q->arg1 + q->arg2;
+            for (int j = 0; j < 3; j++) {
+                int tipo = HLIRBIN_OPERANDO(q, j);
+                uint64_t valor = j == 0 ? q->resultado : j == 1 ? q->arg1 : q->arg2;
+                if (tipo == ADDR_VAR || tipo == ADDR_CONST_STR) {
+                    const char* texto = hlirbin_texto(&arq, valor);
+                    if (texto) *soma += texto[0];
+                }
+            }
+        }
+        n += b->n_quadruplas;
+    }
+    hlirbin_fechar(&arq);
+    return n;
+}
+
+// Reconstrói cada função como lista de quádruplas
+static long carregar_binario(const char* caminho, long* soma) {
+    HlirArquivo arq;
+    if (!hlirbin_abrir(caminho, &arq)) return -1;
+    long n = 0;
+    for (uint32_t i = 0; i < arq.rodape->n_funcoes; i++) {
+        if (!hlirbin_carregar_funcao(&arq, i)) n = -1;
+        for (Quadrupla* q = code_head; q && n >= 0; q = q->next, n++) *soma += q->op;
+        liberarCodigoIntermediario();
+        if (n < 0) break;
+    }
+    hlirbin_fechar(&arq);
+    return n;
+}
+
+typedef long (*Carga)(const char*, long*);
+
+static double medir(const char* nome, Carga carga, const char* caminho, int repeticoes) {
+    long soma = 0, n = 0;
+    double melhor = 1e30;
+    for (int r = 0; r < repeticoes; r++) {
+        double t0 = agora();
+        n = carga(caminho, &soma);
+        double t = agora() - t0;
+        if (n < 0) {
+            fprintf(stderr, "Erro: falha ao carregar '%s'.\n", caminho);
+            exit(1);
+        }
+        if (t < melhor) melhor = t;
+    }
+    printf("%-6s %10ld quádruplas  %9.2f ms  (%.0f quádruplas/ms)  [%ld]\n",
+           nome, n, melhor * 1e3, n / (melhor * 1e3), soma % 1000);
+    return melhor;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Uso: %s programa.hlir programa.bin [repetições]\n", argv[0]);
+        return 1;
+    }
+    int repeticoes = argc > 3 ? atoi(argv[3]) : 5;
+    if (repeticoes < 1) repeticoes = 1;
+
+    long tam_texto = tamanho_arquivo(argv[1]), tam_bin = tamanho_arquivo(argv[2]);
+    printf("tamanho: texto %ld bytes, binário %ld bytes (%.0f%%)\n",
+           tam_texto, tam_bin, tam_texto > 0 ? 100.0 * tam_bin / tam_texto : 0.0);
+
+    double t = medir("texto", carregar_texto, argv[1], repeticoes);
+    double m = medir("mmap", percorrer_binario, argv[2], repeticoes);
+    double l = medir("lista", carregar_binario, argv[2], repeticoes);
+    printf("mmap %.1fx e lista %.1fx mais rápidos que o texto\n", t / m, t / l);
+    return 0;
+}
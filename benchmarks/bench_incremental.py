@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+# Benchmark do modo incremental (./compiler --incremental): latência de
+# cada pedido em um arquivo grande (por padrão 1.000 funções, ~13 mil
+# linhas), comparada com traduzir o arquivo inteiro de novo a cada edição.
+# Edições: um dígito trocado no meio de uma função, uma linha inserida no
+# topo (todas as funções mudam de linha, nenhuma de texto) e a mesma troca
+# de dígito pedindo só os diagnósticos ("saida": false).
+#
+# Uso (a partir da raiz, com ./compiler já compilado):
+#   python3 benchmarks/bench_incremental.py [funções] [edições] [opções do compilador...]
+import json
+import os
+import subprocess
+import sys
+import time
+
+COMPILADOR = "./compiler"
+
+FUNCAO = """
+int f%(i)d() {
+    int i; int s; int x;
+    s = %(i)d;
+    for (i = 0; i < 10; i = i + 1) {
+        x = s * 3 + i;
+        if (x > 100) {
+            s = x %% 97;
+        } else {
+            s = x - 1;
+        }
+    }
+    return s;
+}
+"""
+
+
+def gerar(n):
+    partes = [FUNCAO % {"i": i} for i in range(n)]
+    partes.append('int main() {\n    printf("%%d\\n", %d);\n    return 0;\n}\n' % n)
+    return "".join(partes)
+
+
+class Sessao:
+    def __init__(self, opcoes):
+        self.p = subprocess.Popen([COMPILADOR, "--incremental", *opcoes],
+                                  stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+        self.id = 0
+
+    def pedir(self, **campos):
+        self.id += 1
+        campos["id"] = self.id
+        inicio = time.perf_counter()
+        self.p.stdin.write((json.dumps(campos) + "\n").encode())
+        self.p.stdin.flush()
+        r = json.loads(self.p.stdout.readline())
+        return r, time.perf_counter() - inicio
+
+    def fechar(self):
+        self.p.stdin.close()
+        self.p.wait()
+
+
+def mediana(valores):
+    valores = sorted(valores)
+    return valores[len(valores) // 2]
+
+
+def main():
+    n_funcoes = int(sys.argv[1]) if len(sys.argv) > 1 else 1000
+    n_edicoes = int(sys.argv[2]) if len(sys.argv) > 2 else 50
+    opcoes = sys.argv[3:]
+    if not os.path.exists(COMPILADOR):
+        sys.exit(f"Erro: {COMPILADOR} não encontrado (compile o projeto antes).")
+
+    texto = gerar(n_funcoes).encode()
+    linhas = texto.count(b"\n")
+    print(f"{n_funcoes} funções, {linhas} linhas, {len(texto)} bytes")
+
+    # Referência: o arquivo inteiro traduzido por um processo novo
+    tempos = []
+    for _ in range(5):
+        inicio = time.perf_counter()
+        completo = subprocess.run([COMPILADOR, *opcoes], input=texto, capture_output=True, check=True).stdout
+        tempos.append(time.perf_counter() - inicio)
+    print(f"{'tradução completa':<28} {mediana(tempos) * 1e3:8.2f} ms")
+
+    s = Sessao(opcoes)
+    r, t = s.pedir(metodo="abrir", texto=texto.decode())
+    assert r["ok"] and r["saida"].encode() == completo, "saída diferente da tradução completa"
+    print(f"{'abrir':<28} {t * 1e3:8.2f} ms  (compilador: {r['ms']:.2f} ms)")
+
+    # Troca o dígito da atribuição "s = N;" de uma função do meio, e desfaz
+    meio = texto.index(b"s = %d;" % (n_funcoes // 2)) + 4
+    casos = [
+        ("dígito, com a saída", lambda k: dict(inicio=meio, fim=meio + 1, texto=str(k % 10))),
+        ("linha no topo, com a saída", lambda k: dict(inicio=0, fim=1 if k % 2 else 0, texto="" if k % 2 else "\n")),
+        ("dígito, só diagnósticos", lambda k: dict(inicio=meio, fim=meio + 1, texto=str(k % 10), saida=False)),
+    ]
+    for nome, edicao in casos:
+        totais, internos, reanalisados = [], [], 0
+        for k in range(n_edicoes):
+            r, t = s.pedir(metodo="editar", **edicao(k))
+            assert r["ok"], r.get("diagnosticos")
+            totais.append(t)
+            internos.append(r["ms"])
+            reanalisados += r["reanalisados"]
+        print(f"{nome:<28} {mediana(totais) * 1e3:8.2f} ms  (compilador: {mediana(internos):.2f} ms, "
+              f"{reanalisados / n_edicoes:.1f} trecho(s) reanalisado(s) por edição)")
+    s.fechar()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,119 @@
+// Benchmark do pré-processador: um header compartilhado incluído por 1.000
+// unidades de tradução, com e sem o cache de headers.
+//
+//   gcc -O2 -I. benchmarks/bench_preproc.c preproc.c -o bench_preproc
+//   ./bench_preproc [n_unidades] [n_macros_no_header]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "preproc.h"
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Header realista: include guard, header aninhado, macros simples e com
+// parâmetros, condicionais e comentários.
+static void gerar_headers(const char* dir, int n_macros) {
+    char caminho[512];
+    snprintf(caminho, sizeof caminho, "%s/tipos.h", dir);
+    FILE* f = fopen(caminho, "w");
+    fprintf(f, "#pragma once\n#define TIPO_BASE int\n#define LARGURA 32\n");
+    fclose(f);
+
+    snprintf(caminho, sizeof caminho, "%s/comum.h", dir);
+    f = fopen(caminho, "w");
+    fprintf(f, "#ifndef COMUM_H\n#define COMUM_H\n#include \"tipos.h\"\n");
+    for (int i = 0; i < n_macros; i++) {
+        fprintf(f, "/* constante %d */\n#define CONST_%d (%d * LARGURA)\n", i, i, i);
+        fprintf(f, "#define ESCALA_%d(x, y) ((x) * %d + (y))\n", i, i);
+        if (i % 10 == 0) {
+            fprintf(f, "#if LARGURA > 16 && defined(TIPO_BASE)\n#define LARGO_%d 1\n#else\n#define LARGO_%d 0\n#endif\n", i, i);
+        }
+    }
+    fprintf(f, "#endif\n");
+    fclose(f);
+}
+
+// Pré-processa uma unidade e devolve um hash do texto visível ao parser.
+// Marcadores de linha e quebras ficam de fora: com o cache, a segunda
+// inclusão do header nem é lida, então só a numeração difere.
+static unsigned long long pre_processar(const char* fonte, size_t n, const char* dir, size_t* bytes) {
+    static char buf[8192];
+    unsigned long long soma = 1469598103934665603ULL;
+    int inicio_linha = 1, marcador = 0;
+    preproc_inicializar();
+    preproc_adicionar_caminho(dir);
+    preproc_abrir_memoria("unidade.c", fonte, n);
+    size_t lidos;
+    while ((lidos = preproc_ler(buf, sizeof buf)) > 0) {
+        for (size_t i = 0; i < lidos; i++) {
+            char c = buf[i];
+            if (inicio_linha && c == '#') marcador = 1;
+            inicio_linha = (c == '\n');
+            if (inicio_linha) { marcador = 0; continue; }
+            if (!marcador) soma = (soma ^ (unsigned char)c) * 1099511628211ULL;
+        }
+        *bytes += lidos;
+    }
+    if (preproc_erros()) {
+        fprintf(stderr, "Erro: o pré-processador reportou erros.\n");
+        exit(1);
+    }
+    return soma;
+}
+
+int main(int argc, char** argv) {
+    int n_unidades = argc > 1 ? atoi(argv[1]) : 1000;
+    int n_macros = argc > 2 ? atoi(argv[2]) : 2000;
+
+    char dir[] = "/tmp/bench_preproc_XXXXXX";
+    if (!mkdtemp(dir)) { perror("mkdtemp"); return 1; }
+    gerar_headers(dir, n_macros);
+
+    const char* fonte =
+        "#include \"comum.h\"\n"
+        "#include \"comum.h\"\n"
+        "int main() {\n"
+        "    int x;\n"
+        "    x = ESCALA_7(CONST_3, CONST_5) + LARGO_10;\n"
+        "    printf(\"%d\\n\", x);\n"
+        "    return 0;\n"
+        "}\n";
+    size_t n = strlen(fonte);
+
+    printf("%d unidades de tradução, header com %d macros\n", n_unidades, n_macros * 2);
+    unsigned long long referencia = 0;
+    for (int modo = 0; modo < 2; modo++) {
+        preproc_liberar_cache();
+        preproc_habilitar_cache(modo);
+        size_t bytes = 0;
+        double ini = agora();
+        for (int i = 0; i < n_unidades; i++) {
+            unsigned long long soma = pre_processar(fonte, n, dir, &bytes);
+            if (modo == 0 && i == 0) referencia = soma;
+            if (soma != referencia) {
+                fprintf(stderr, "Erro: saída difere entre os modos (unidade %d).\n", i);
+                return 1;
+            }
+        }
+        double total = agora() - ini;
+        unsigned long acertos, falhas;
+        preproc_estatisticas(&acertos, &falhas);
+        printf("  %-9s %8.2f ms total  %8.2f us/unidade  (%zu bytes, cache: %lu acertos / %lu falhas)\n",
+               modo ? "com cache" : "sem cache", total * 1e3, total * 1e6 / n_unidades, bytes, acertos, falhas);
+    }
+    preproc_finalizar();
+    preproc_liberar_cache();
+
+    char caminho[600];
+    snprintf(caminho, sizeof caminho, "%s/comum.h", dir); unlink(caminho);
+    snprintf(caminho, sizeof caminho, "%s/tipos.h", dir); unlink(caminho);
+    rmdir(dir);
+    return 0;
+}
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+# Benchmark da emissão direta de .pyc (--emit=pyc): gera um programa grande
+# (muitas funções e um main longo, com pouco trabalho em tempo de execução),
+# traduz para .py e para .pyc, confere que a saída é a mesma e compara o
+# tempo até o programa terminar. Rodado como script, o .py é tokenizado,
+# analisado e compilado pelo CPython a cada execução; o .pyc é só carregado.
+#
+# Uso (a partir da raiz, com ./compiler já compilado e python3 = CPython 3.11):
+#   python3 benchmarks/bench_pyc.py [repetições] [funções] [blocos do main]
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+COMPILADOR = "./compiler"
+
+
+def gerar(n_funcoes, n_blocos):
+    partes = []
+    for f in range(n_funcoes):
+        partes.append(f"""
+int f{f}() {{
+    int a; int b; int c;
+    a = {f};
+    b = a * 3 + 1;
+    if (b > 10) {{
+        c = b - a;
+    }} else {{
+        c = a + 7;
+    }}
+    while (c > 100) {{
+        c = c / 2;
+    }}
+    return c;
+}}
+""")
+    decl = "".join(f"    int v{b};\n" for b in range(n_blocos))
+    blocos = "".join(f"""
+    v{b} = {b} * 7 + 3;
+    if (v{b} % 3 == 0) {{
+        v{b} = v{b} / 3;
+    }} else {{
+        v{b} = v{b} - 1;
+    }}
+    s = s + v{b};
+""" for b in range(n_blocos))
+    partes.append(f"\nint main() {{\n    int s;\n{decl}    s = 0;\n{blocos}"
+                  f"    printf(\"%d\\n\", s);\n    return 0;\n}}\n")
+    return "".join(partes)
+
+
+def medir(comando, repeticoes):
+    melhor, saida = None, None
+    for _ in range(repeticoes):
+        inicio = time.perf_counter()
+        r = subprocess.run(comando, capture_output=True, text=True, check=True)
+        t = time.perf_counter() - inicio
+        melhor = t if melhor is None else min(melhor, t)
+        saida = r.stdout
+    return melhor, saida
+
+
+def main():
+    repeticoes = int(sys.argv[1]) if len(sys.argv) > 1 else 5
+    n_funcoes = int(sys.argv[2]) if len(sys.argv) > 2 else 2000
+    n_blocos = int(sys.argv[3]) if len(sys.argv) > 3 else 2000
+    if not os.path.exists(COMPILADOR):
+        sys.exit(f"Erro: {COMPILADOR} não encontrado (compile o projeto antes).")
+    if sys.version_info[:2] != (3, 11):
+        sys.exit("Erro: o .pyc gerado é do CPython 3.11.")
+
+    with tempfile.TemporaryDirectory() as tmp:
+        fonte = os.path.join(tmp, "grande.c")
+        with open(fonte, "w") as f:
+            f.write(gerar(n_funcoes, n_blocos))
+
+        medidas = {}
+        for formato in ("py", "pyc"):
+            programa = os.path.join(tmp, "grande." + formato)
+            t_comp, _ = medir([COMPILADOR, f"--emit={formato}", fonte, "-o", programa], repeticoes)
+            t_exec, saida = medir([sys.executable, programa], repeticoes)
+            medidas[formato] = (t_comp, os.path.getsize(programa), t_exec, saida)
+        if medidas["py"][3] != medidas["pyc"][3]:
+            sys.exit("Erro: saída diferente entre o .py e o .pyc")
+        t_vazio, _ = medir([sys.executable, "-c", "pass"], repeticoes)
+
+        print(f"{n_funcoes} funções, main com {n_blocos} blocos "
+              f"(interpretador vazio: {t_vazio * 1e3:.1f} ms)")
+        print(f"{'':<14}{'compilador':>12}{'tamanho':>12}{'execução':>12}")
+        for formato in ("py", "pyc"):
+            t_comp, tamanho, t_exec, _ = medidas[formato]
+            print(f"--emit={formato:<7}{t_comp * 1e3:9.1f} ms{tamanho:>10d} B {t_exec * 1e3:9.1f} ms")
+        print(f"execução do .pyc: {medidas['py'][2] / medidas['pyc'][2]:.2f}x mais rápida")
+
+
+if __name__ == "__main__":
+    main()
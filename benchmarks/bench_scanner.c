@@ -0,0 +1,107 @@
+// Benchmark e comparação dos lexers. O mesmo programa é ligado com o lexer
+// do Flex ou com o scanner vetorizado; a entrada vem direto da memória (no
+// lugar do pré-processador), então só o lexer é medido.
+//
+// Compilação (a partir da raiz, depois de `bison -d parser.y` e `flex lexer.l`):
+//   gcc -O2 -I. benchmarks/bench_scanner.c lex.yy.c -o bench_flex
+//   gcc -O2 -I. benchmarks/bench_scanner.c scanner.c -o bench_simd
+// Uso:
+//   ./bench_simd arquivo.c [repetições]    MB/s do lexer sobre o arquivo
+//   ./bench_simd --tokens arquivo.c        lista os tokens (um por linha)
+// teste/fuzz_scanner.py usa --tokens para conferir que os dois lexers
+// produzem a mesma sequência.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ast.h"
+#include "parser.tab.h"
+#include "scanner.h"
+
+YYSTYPE yylval;
+YYLTYPE yylloc;
+
+int yylex(void);
+void lexer_reiniciar(void);
+
+// Só existe quando ligado com scanner.c
+const char* scanner_implementacao(void) __attribute__((weak));
+
+// Substitui o pré-processador: entrega o arquivo em blocos, como YY_INPUT
+static const char* entrada;
+static size_t tam_entrada, lido;
+
+size_t preproc_ler(char* buf, size_t max) {
+    size_t n = tam_entrada - lido;
+    if (n > max) n = max;
+    memcpy(buf, entrada + lido, n);
+    lido += n;
+    return n;
+}
+
+static void reiniciar(void) {
+    lido = 0;
+    lexer_reiniciar();
+}
+
+static int tem_texto(int token) {
+    return token == ID || token == NUMBER || token == STRING || token == CHAR;
+}
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+    int listar = argc > 1 && strcmp(argv[1], "--tokens") == 0;
+    if (argc < 2 + listar) {
+        fprintf(stderr, "Uso: %s [--tokens] arquivo.c [repetições]\n", argv[0]);
+        return 1;
+    }
+    FILE* f = fopen(argv[1 + listar], "rb");
+    if (!f) { perror(argv[1 + listar]); return 1; }
+    fseek(f, 0, SEEK_END);
+    tam_entrada = (size_t)ftell(f);
+    rewind(f);
+    char* dados = malloc(tam_entrada + 1);
+    if (fread(dados, 1, tam_entrada, f) != tam_entrada) { perror("fread"); return 1; }
+    fclose(f);
+    entrada = dados;
+
+    if (listar) {
+        int token;
+        reiniciar();
+        while ((token = yylex()) != 0) {
+            printf("%d:%d-%d %d", yylloc.first_line, yylloc.first_column, yylloc.last_column, token);
+            if (tem_texto(token)) {
+                printf(" %s", yylval.str);
+                free(yylval.str);
+            }
+            putchar('\n');
+        }
+        free(dados);
+        return 0;
+    }
+
+    int repeticoes = argc > 2 ? atoi(argv[2]) : 10;
+    long tokens = 0;
+    double melhor = 1e30;
+    for (int r = 0; r < repeticoes; r++) {
+        int token;
+        tokens = 0;
+        reiniciar();
+        double t0 = agora();
+        while ((token = yylex()) != 0) {
+            if (tem_texto(token)) free(yylval.str);
+            tokens++;
+        }
+        double t = agora() - t0;
+        if (t < melhor) melhor = t;
+    }
+    printf("%-8s %8.1f MB/s  (%zu bytes, %ld tokens, melhor de %d: %.2f ms)\n",
+           scanner_implementacao ? scanner_implementacao() : "flex", tam_entrada / melhor / 1e6, tam_entrada, tokens, repeticoes, melhor * 1e3);
+    free(dados);
+    return 0;
+}
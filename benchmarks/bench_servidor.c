@@ -0,0 +1,147 @@
+// Benchmark do servidor de compilação: latência por arquivo ao criar um
+// processo do compilador para cada tradução vs. enviar o pedido ao servidor
+// residente (sequencial e com vários clientes simultâneos).
+//
+// Compilação:
+//   gcc -O2 -I. benchmarks/bench_servidor.c servidor.c -o bench_servidor
+// Uso:
+//   ./bench_servidor [./compiler] [teste/teste.c] [pedidos] [clientes]
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include "servidor.h"
+
+static double agora_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int comparar(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static char* ler_arquivo(const char* caminho, size_t* n) {
+    FILE* f = fopen(caminho, "rb");
+    if (!f) { perror(caminho); exit(1); }
+    fseek(f, 0, SEEK_END);
+    long tam = ftell(f);
+    rewind(f);
+    char* buf = malloc((size_t)tam + 1);
+    *n = fread(buf, 1, (size_t)tam, f);
+    fclose(f);
+    return buf;
+}
+
+// Um pedido completo pelo protocolo do servidor; devolve o tamanho da saída
+static long pedir(const char* sock, const char* entrada, size_t n) {
+    struct sockaddr_un end;
+    memset(&end, 0, sizeof(end));
+    end.sun_family = AF_UNIX;
+    strncpy(end.sun_path, sock, sizeof(end.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&end, sizeof(end)) != 0) { perror("connect"); exit(1); }
+
+    char cwd[4096];
+    if (!getcwd(cwd, sizeof(cwd))) exit(1);
+    uint32_t status;
+    size_t n_saida = 0, n_erro = 0;
+    int ok = protocolo_escrever(fd, SERVIDOR_MAGICO, 4)
+          && protocolo_escrever_u32(fd, 1)
+          && protocolo_escrever_bloco(fd, "compiler", 8)
+          && protocolo_escrever_bloco(fd, cwd, strlen(cwd))
+          && protocolo_escrever_u32(fd, 1)
+          && protocolo_escrever_bloco(fd, entrada, n)
+          && protocolo_ler_u32(fd, &status);
+    char* saida = ok ? protocolo_ler_bloco(fd, &n_saida) : NULL;
+    char* erro  = saida ? protocolo_ler_bloco(fd, &n_erro) : NULL;
+    close(fd);
+    if (!erro) { fprintf(stderr, "pedido falhou\n"); exit(1); }
+    free(saida);
+    free(erro);
+    return (long)n_saida;
+}
+
+static void relatorio(const char* nome, double* t, int n) {
+    double soma = 0;
+    for (int i = 0; i < n; i++) soma += t[i];
+    qsort(t, n, sizeof(double), comparar);
+    printf("%-28s média %9.1f µs   p50 %9.1f µs   p99 %9.1f µs\n",
+           nome, soma / n, t[n / 2], t[(int)(n * 0.99)]);
+}
+
+int main(int argc, char** argv) {
+    const char* compilador = argc > 1 ? argv[1] : "./compiler";
+    const char* fonte      = argc > 2 ? argv[2] : "teste/teste.c";
+    int pedidos            = argc > 3 ? atoi(argv[3]) : 500;
+    int clientes           = argc > 4 ? atoi(argv[4]) : 4;
+    char sock[64];
+    size_t n;
+    char* entrada = ler_arquivo(fonte, &n);
+    double* t = malloc(sizeof(double) * pedidos);
+
+    snprintf(sock, sizeof(sock), "/tmp/bench_compilador_%d.sock", (int)getpid());
+
+    // 1) Um processo por tradução (como ./compiler < arquivo)
+    for (int i = 0; i < pedidos; i++) {
+        double t0 = agora_us();
+        pid_t pid = fork();
+        if (pid == 0) {
+            int in = open(fonte, O_RDONLY), out = open("/dev/null", O_WRONLY);
+            dup2(in, 0); dup2(out, 1); dup2(out, 2);
+            execl(compilador, compilador, (char*)NULL);
+            _exit(127);
+        }
+        waitpid(pid, NULL, 0);
+        t[i] = agora_us() - t0;
+    }
+    relatorio("processo por arquivo", t, pedidos);
+
+    // 2) Servidor residente
+    pid_t servidor = fork();
+    if (servidor == 0) {
+        int out = open("/dev/null", O_WRONLY);
+        dup2(out, 2);
+        execl(compilador, compilador, "--servir", sock, "--workers", "0", (char*)NULL);
+        _exit(127);
+    }
+    for (int tentativa = 0; access(sock, F_OK) != 0 && tentativa < 500; tentativa++) usleep(2000);
+    usleep(20000);   // workers prontos
+
+    long saida = 0;
+    for (int i = 0; i < 20; i++) pedir(sock, entrada, n);   // aquecimento
+    for (int i = 0; i < pedidos; i++) {
+        double t0 = agora_us();
+        saida = pedir(sock, entrada, n);
+        t[i] = agora_us() - t0;
+    }
+    relatorio("servidor (1 cliente)", t, pedidos);
+
+    // 3) Vários clientes simultâneos
+    double t0 = agora_us();
+    for (int c = 0; c < clientes; c++) {
+        if (fork() == 0) {
+            for (int i = 0; i < pedidos; i++) pedir(sock, entrada, n);
+            _exit(0);
+        }
+    }
+    for (int c = 0; c < clientes; c++) wait(NULL);
+    double total = agora_us() - t0;
+    printf("servidor (%d clientes)        %9.0f traduções/s (%ld bytes de saída cada)\n",
+           clientes, clientes * pedidos / (total / 1e6), saida);
+
+    kill(servidor, SIGTERM);
+    waitpid(servidor, NULL, 0);
+    free(t);
+    free(entrada);
+    return 0;
+}
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# Benchmark do passo de simplificação (--simplificar): traduz núcleos com
+# hashing bit a bit, divisão/resto por potência de dois e índices lineares
+# com o passo desligado e ligado, confere que a saída é a mesma e compara o
+# tempo de execução do Python gerado.
+#
+# Uso (a partir da raiz, com ./compiler já compilado):
+#   python3 benchmarks/bench_simplificar.py [repetições] [fator de desenrolamento]
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+COMPILADOR = "./compiler"
+
+NUCLEOS = {
+    # Hash multiplicativo mascarado: deslocamentos, xor e and
+    "hash": """
+int main() {
+    int i; int h; int x;
+    h = 5381;
+    for (i = 0; i < 300000; i = i + 1) {
+        x = h * 33 + i;
+        h = (x ^ (x >> 7)) & 1048575;
+    }
+    printf("%d\\n", h);
+    return 0;
+}
+""",
+    # Divisão e resto por potências de dois, com e sem sinal
+    "pot2": """
+int main() {
+    int i; int s; int d;
+    s = 0;
+    for (i = 0; i < 200000; i = i + 1) {
+        d = i - 100000;
+        s = s + i / 16 + i % 8 + d / 4 + d % 32;
+    }
+    printf("%d\\n", s);
+    return 0;
+}
+""",
+    # Índice linear i * 64 + j + 1: acumulador fora do laço interno
+    "inducao": """
+int main() {
+    int i; int j; int s; int idx;
+    s = 0;
+    for (i = 0; i < 600; i = i + 1) {
+        for (j = 0; j < 500; j = j + 1) {
+            idx = i * 64 + 1 + j;
+            s = s ^ idx;
+        }
+    }
+    printf("%d\\n", s);
+    return 0;
+}
+""",
+}
+
+
+def traduzir(fonte, simplificar, fator, destino):
+    subprocess.run([COMPILADOR, f"--simplificar={simplificar}", f"--desenrolar={fator}",
+                    "--emit=py", fonte, "-o", destino], check=True)
+
+
+def executar(programa, repeticoes):
+    melhor, saida = None, None
+    for _ in range(repeticoes):
+        inicio = time.perf_counter()
+        r = subprocess.run([sys.executable, programa], capture_output=True, text=True, check=True)
+        t = time.perf_counter() - inicio
+        melhor = t if melhor is None else min(melhor, t)
+        saida = r.stdout
+    return melhor, saida
+
+
+def main():
+    repeticoes = int(sys.argv[1]) if len(sys.argv) > 1 else 3
+    fator = int(sys.argv[2]) if len(sys.argv) > 2 else 0
+    if not os.path.exists(COMPILADOR):
+        sys.exit(f"Erro: {COMPILADOR} não encontrado (compile o projeto antes).")
+
+    with tempfile.TemporaryDirectory() as tmp:
+        for nome, codigo in NUCLEOS.items():
+            fonte = os.path.join(tmp, nome + ".c")
+            with open(fonte, "w") as f:
+                f.write(codigo)
+
+            base = os.path.join(tmp, nome + "_0.py")
+            traduzir(fonte, 0, fator, base)
+            t0, esperado = executar(base, repeticoes)
+
+            programa = os.path.join(tmp, nome + "_1.py")
+            traduzir(fonte, 1, fator, programa)
+            t1, saida = executar(programa, repeticoes)
+            if saida != esperado:
+                sys.exit(f"Erro: saída diferente em {nome} com --simplificar=1")
+            print(f"{nome:<10} --simplificar=0 {t0 * 1e3:8.1f} ms   "
+                  f"--simplificar=1 {t1 * 1e3:8.1f} ms  ({t0 / t1:.2f}x)")
+
+
+if __name__ == "__main__":
+    main()
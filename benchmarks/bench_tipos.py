@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+# Benchmark do custo de cada semântica de tipo no Python gerado: o mesmo
+# núcleo com int (nativo, divisão por int(a / b)), unsigned (máscara depois
+# de +, - e *), long long (divisão exata em 64 bits) e, para ponto
+# flutuante, double, float calculado como double (--float32=0) e float
+# arredondado para 32 bits a cada operação (--float32=1).
+#
+# Uso (a partir da raiz, com ./compiler já compilado):
+#   python3 benchmarks/bench_tipos.py [repetições]
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+COMPILADOR = "./compiler"
+
+# Hash com divisão e resto; os valores ficam pequenos, então todas as
+# versões imprimem o mesmo e só muda o que o tipo obriga o Python a fazer
+INTEIRO = """
+int main() {
+    %(tipo)s i; %(tipo)s s; %(tipo)s x;
+    s = 1;
+    for (i = 0; i < 200000; i = i + 1) {
+        x = s * 33 + i;
+        s = x %% 65521 + x / 65521;
+    }
+    printf("%%d\\n", s);
+    return 0;
+}
+"""
+
+# Recorrência com soma, produto e divisão
+REAL = """
+int main() {
+    int i; %(tipo)s x; %(tipo)s y;
+    x = 0.5%(sufixo)s;
+    y = 0.0%(sufixo)s;
+    for (i = 0; i < 200000; i = i + 1) {
+        x = x * 1.0001%(sufixo)s + 0.25%(sufixo)s;
+        if (x > 100.0%(sufixo)s) {
+            x = x - 99.0%(sufixo)s;
+        }
+        y = y + x / 3.0%(sufixo)s;
+    }
+    printf("%%.6g\\n", y);
+    return 0;
+}
+"""
+
+# (nome, modelo, valores, opções do compilador)
+CASOS = [
+    ("int", INTEIRO, {"tipo": "int"}, []),
+    ("unsigned", INTEIRO, {"tipo": "unsigned int"}, []),
+    ("long long", INTEIRO, {"tipo": "long long"}, []),
+    ("double", REAL, {"tipo": "double", "sufixo": ""}, []),
+    ("float", REAL, {"tipo": "float", "sufixo": "f"}, ["--float32=0"]),
+    ("float32", REAL, {"tipo": "float", "sufixo": "f"}, ["--float32=1"]),
+]
+
+
+def executar(programa, repeticoes):
+    melhor, saida = None, None
+    for _ in range(repeticoes):
+        inicio = time.perf_counter()
+        r = subprocess.run([sys.executable, programa], capture_output=True, text=True, check=True)
+        t = time.perf_counter() - inicio
+        melhor = t if melhor is None else min(melhor, t)
+        saida = r.stdout.strip()
+    return melhor, saida
+
+
+def main():
+    repeticoes = int(sys.argv[1]) if len(sys.argv) > 1 else 3
+    if not os.path.exists(COMPILADOR):
+        sys.exit(f"Erro: {COMPILADOR} não encontrado (compile o projeto antes).")
+
+    referencias = {}
+    with tempfile.TemporaryDirectory() as tmp:
+        for nome, modelo, valores, opcoes in CASOS:
+            fonte = os.path.join(tmp, "nucleo.c")
+            programa = os.path.join(tmp, "nucleo.py")
+            with open(fonte, "w") as f:
+                f.write(modelo % valores)
+            subprocess.run([COMPILADOR, *opcoes, "--emit=py", fonte, "-o", programa], check=True)
+            t, saida = executar(programa, repeticoes)
+
+            # Cada núcleo é comparado com o primeiro caso do mesmo modelo
+            base = referencias.setdefault(id(modelo), t)
+            print(f"{nome:<10} {t * 1e3:8.1f} ms  ({t / base:.2f}x)  saída: {saida}")
+
+
+if __name__ == "__main__":
+    main()
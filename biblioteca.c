@@ -0,0 +1,267 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "biblioteca.h"
+
+int ligar_biblioteca = 1;
+
+// Ligações: `_nome = valor`. Os valores leem _math e _sys, importados pelo
+// preâmbulo, ou as funções auxiliares.
+static const struct {
+    const char* nome;
+    const char* valor;
+} ligacoes[] = {
+    { "sqrt",     "_math.sqrt" },
+    { "exp",      "_math.exp" },
+    { "log",      "_math.log" },
+    { "log10",    "_math.log10" },
+    { "sin",      "_math.sin" },
+    { "cos",      "_math.cos" },
+    { "atan2",    "_math.atan2" },
+    { "fmod",     "_math.fmod" },
+    { "fabs",     "_math.fabs" },
+    { "floor",    "_math.floor" },
+    { "ceil",     "_math.ceil" },
+    { "trunc",    "_math.trunc" },
+    { "copysign", "_math.copysign" },
+    { "inf",      "_math.inf" },
+    { "nan",      "_math.nan" },
+    { "pow",      "_c_pow" },
+    { "abs",      "abs" },
+    { "rand",     "_c_rand" },
+    { "srand",    "_c_srand" },
+    { "write",    "_sys.stdout.write" },
+    { "chr",      "chr" },
+};
+#define N_LIGACOES ((int)(sizeof(ligacoes) / sizeof(ligacoes[0])))
+
+// math.pow levanta exceção onde o C devolve infinito (estouro, 0 elevado a
+// negativo) ou NaN (base negativa com expoente fracionário)
+static const char AUX_POW[] =
+    "def _c_pow(x, y):\n"
+    "    try:\n"
+    "        return _math.pow(x, y)\n"
+    "    except OverflowError:\n"
+    "        return -_math.inf if x < 0.0 and y % 2.0 == 1.0 else _math.inf\n"
+    "    except ValueError:\n"
+    "        if x == 0.0:\n"
+    "            return _math.copysign(_math.inf, x) if y % 2.0 == 1.0 else _math.inf\n"
+    "        return _math.nan\n";
+
+// Gerador aditivo da glibc (TYPE_3: x[i] = x[i-3] + x[i-31], 31 palavras
+// semeadas por 16807 * x mod 2**31 - 1, 310 valores descartados): a mesma
+// sequência do rand() de um programa C compilado com gcc. As posições f e r
+// ficam no fim da lista.
+static const char AUX_RAND[] =
+    "_c_rand_estado = [0] * 33\n"
+    "def _c_srand(semente, _s=_c_rand_estado):\n"
+    "    w = semente & 0xffffffff or 1\n"
+    "    if w > 0x7fffffff:\n"
+    "        w -= 0x100000000\n"
+    "    _s[0] = w & 0xffffffff\n"
+    "    for i in range(1, 31):\n"
+    "        hi = w // 127773 if w >= 0 else -(-w // 127773)\n"
+    "        w = 16807 * (w - hi * 127773) - 2836 * hi\n"
+    "        if w < 0:\n"
+    "            w += 2147483647\n"
+    "        _s[i] = w\n"
+    "    _s[31], _s[32] = 3, 0\n"
+    "    for _ in range(310):\n"
+    "        _c_rand()\n"
+    "def _c_rand(_s=_c_rand_estado):\n"
+    "    f = _s[31]\n"
+    "    r = _s[32]\n"
+    "    v = _s[f] = (_s[f] + _s[r]) & 0xffffffff\n"
+    "    _s[31] = f + 1 if f < 30 else 0\n"
+    "    _s[32] = r + 1 if r < 30 else 0\n"
+    "    return v >> 1\n"
+    "_c_srand(1)\n";
+
+// floor, ceil e trunc: o math devolve int (e falha com infinito e NaN); de
+// 2**52 em diante todo double já é inteiro. copysign mantém o sinal de -0.0
+// e de ceil(-0.5).
+#define ARREDONDAR(f) "(@copysign(@" f "($0), $0) if -4503599627370496.0 < $0 < 4503599627370496.0 else $0)"
+
+static const FuncaoBiblioteca funcoes[] = {
+    // <math.h>: fora do domínio, NaN; polos e estouro, infinito
+    { "sqrt",  TIPO_DOUBLE, 1, { TIPO_DOUBLE }, "(@sqrt($0) if $0 >= 0.0 else @nan)", NULL },
+    { "pow",   TIPO_DOUBLE, 2, { TIPO_DOUBLE, TIPO_DOUBLE }, "@pow($0, $1)", AUX_POW },
+    { "exp",   TIPO_DOUBLE, 1, { TIPO_DOUBLE }, "(@inf if $0 > 709.782712893384 else @exp($0))", NULL },
+    { "log",   TIPO_DOUBLE, 1, { TIPO_DOUBLE }, "(@log($0) if $0 > 0.0 else -@inf if $0 == 0.0 else @nan)", NULL },
+    { "log10", TIPO_DOUBLE, 1, { TIPO_DOUBLE }, "(@log10($0) if $0 > 0.0 else -@inf if $0 == 0.0 else @nan)", NULL },
+    { "sin",   TIPO_DOUBLE, 1, { TIPO_DOUBLE }, "(@sin($0) if -@inf < $0 < @inf else @nan)", NULL },
+    { "cos",   TIPO_DOUBLE, 1, { TIPO_DOUBLE }, "(@cos($0) if -@inf < $0 < @inf else @nan)", NULL },
+    { "atan2", TIPO_DOUBLE, 2, { TIPO_DOUBLE, TIPO_DOUBLE }, "@atan2($0, $1)", NULL },
+    { "fmod",  TIPO_DOUBLE, 2, { TIPO_DOUBLE, TIPO_DOUBLE },
+      "(@fmod($0, $1) if $1 != 0.0 and -@inf < $0 < @inf else @nan)", NULL },
+    { "fabs",  TIPO_DOUBLE, 1, { TIPO_DOUBLE }, "@fabs($0)", NULL },
+    { "floor", TIPO_DOUBLE, 1, { TIPO_DOUBLE }, ARREDONDAR("floor"), NULL },
+    { "ceil",  TIPO_DOUBLE, 1, { TIPO_DOUBLE }, ARREDONDAR("ceil"), NULL },
+    { "trunc", TIPO_DOUBLE, 1, { TIPO_DOUBLE }, ARREDONDAR("trunc"), NULL },
+
+    // <stdlib.h>
+    { "abs",   TIPO_INT,   1, { TIPO_INT },   "@abs($0)", NULL },
+    { "labs",  TIPO_LONG,  1, { TIPO_LONG },  "@abs($0)", NULL },
+    { "llabs", TIPO_LLONG, 1, { TIPO_LLONG }, "@abs($0)", NULL },
+    { "rand",  TIPO_INT,   0, { TIPO_NENHUM }, "@rand()", AUX_RAND },
+    { "srand", TIPO_VOID,  1, { TIPO_UINT },  "@srand($0)", AUX_RAND },
+
+    // <stdio.h>: print() e write() escrevem no mesmo sys.stdout do printf;
+    // puts devolve o tamanho escrito, como na glibc
+    { "puts",    TIPO_INT, 1, { TIPO_STRING }, "(print($0) or len($0) + 1)", NULL },
+    { "putchar", TIPO_INT, 1, { TIPO_INT }, "(@write(@chr($0 & 255)) and $0 & 255)", NULL },
+};
+#define N_FUNCOES ((int)(sizeof(funcoes) / sizeof(funcoes[0])))
+
+const FuncaoBiblioteca* biblioteca_buscar(const char* nome) {
+    if (!nome) return NULL;
+    for (int i = 0; i < N_FUNCOES; i++) {
+        if (strcmp(funcoes[i].nome, nome) == 0) return &funcoes[i];
+    }
+    return NULL;
+}
+
+int biblioteca_indice(const FuncaoBiblioteca* f) {
+    return (int)(f - funcoes);
+}
+
+const FuncaoBiblioteca* biblioteca_funcao(int indice) {
+    return indice >= 0 && indice < N_FUNCOES ? &funcoes[indice] : NULL;
+}
+
+// Ligação nomeada em `s` (depois do '@'); *n recebe o tamanho do nome
+static int ligacaoEm(const char* s, size_t* n) {
+    size_t k = 0;
+    while (isalnum((unsigned char)s[k]) || s[k] == '_') k++;
+    *n = k;
+    for (int i = 0; i < N_LIGACOES; i++) {
+        if (strlen(ligacoes[i].nome) == k && strncmp(ligacoes[i].nome, s, k) == 0) return i;
+    }
+    return -1;
+}
+
+ConjuntoBiblioteca biblioteca_ligacoes(const FuncaoBiblioteca* f) {
+    ConjuntoBiblioteca c = 0;
+    for (const char* s = f->modelo; (s = strchr(s, '@')); ) {
+        size_t n;
+        int i = ligacaoEm(++s, &n);
+        if (i >= 0) c |= 1ULL << i;
+        s += n;
+    }
+    return c;
+}
+
+const char* biblioteca_chamada_direta(const FuncaoBiblioteca* f) {
+    static char nome[32];
+    size_t n;
+    const char* s = f->modelo;
+    if (*s++ != '@') return NULL;
+    int i = ligacaoEm(s, &n);
+    if (i < 0 || s[n] != '(') return NULL;
+    s += n + 1;
+    for (int a = 0; a < f->n_args; a++) {
+        if (a > 0 && strncmp(s, ", ", 2) == 0) s += 2;
+        if (s[0] != '$' || s[1] != '0' + a) return NULL;
+        s += 2;
+    }
+    if (strcmp(s, ")") != 0) return NULL;
+    snprintf(nome, sizeof(nome), "_%s", ligacoes[i].nome);
+    return nome;
+}
+
+// --- Textos ---
+
+typedef struct {
+    char* d;
+    size_t n, cap;
+} Texto;
+
+static void t_dados(Texto* t, const char* s, size_t n) {
+    if (t->n + n + 1 > t->cap) {
+        size_t cap = t->cap ? t->cap : 256;
+        while (t->n + n + 1 > cap) cap *= 2;
+        char* d = realloc(t->d, cap);
+        if (!d) {
+            fprintf(stderr, "Erro: Falha ao alocar memória para a biblioteca padrão.\n");
+            exit(1);
+        }
+        t->d = d;
+        t->cap = cap;
+    }
+    memcpy(t->d + t->n, s, n);
+    t->n += n;
+    t->d[t->n] = '\0';
+}
+
+static void t_texto(Texto* t, const char* s) { t_dados(t, s, strlen(s)); }
+
+// Um texto vazio também precisa de memória própria
+static char* t_fim(Texto* t) {
+    if (!t->d) t_dados(t, "", 0);
+    return t->d;
+}
+
+char* biblioteca_expressao(const FuncaoBiblioteca* f, const char* const* args, int ligar) {
+    Texto t = { NULL, 0, 0 };
+    for (const char* s = f->modelo; *s; ) {
+        if (s[0] == '$' && s[1] >= '0' && s[1] < '0' + f->n_args) {
+            t_texto(&t, args[s[1] - '0']);
+            s += 2;
+        } else if (s[0] == '@') {
+            size_t n;
+            int i = ligacaoEm(++s, &n);
+            if (i < 0) t_dados(&t, s, n);
+            else if (ligar) { t_texto(&t, "_"); t_texto(&t, ligacoes[i].nome); }
+            else t_texto(&t, ligacoes[i].valor);
+            s += n;
+        } else {
+            t_dados(&t, s++, 1);
+        }
+    }
+    return t_fim(&t);
+}
+
+char* biblioteca_ligar(ConjuntoBiblioteca c, const char* indentacao) {
+    Texto t = { NULL, 0, 0 };
+    for (int i = 0; i < N_LIGACOES; i++) {
+        if (!(c & (1ULL << i))) continue;
+        t_texto(&t, indentacao);
+        t_texto(&t, "_");
+        t_texto(&t, ligacoes[i].nome);
+        t_texto(&t, " = ");
+        t_texto(&t, ligacoes[i].valor);
+        t_texto(&t, "\n");
+    }
+    return t_fim(&t);
+}
+
+char* biblioteca_parametros(ConjuntoBiblioteca c) {
+    Texto t = { NULL, 0, 0 };
+    for (int i = 0; i < N_LIGACOES; i++) {
+        if (!(c & (1ULL << i))) continue;
+        if (t.n) t_texto(&t, ", ");
+        t_texto(&t, "_");
+        t_texto(&t, ligacoes[i].nome);
+        t_texto(&t, "=_");
+        t_texto(&t, ligacoes[i].nome);
+    }
+    return t_fim(&t);
+}
+
+char* biblioteca_preambulo(ConjuntoBiblioteca c) {
+    Texto t = { NULL, 0, 0 };
+    if (!c) return t_fim(&t);
+    t_texto(&t, "_math = __import__('math')\n"
+                "_sys = __import__('sys')\n");
+    // Um auxiliar compartilhado (rand e srand) sai uma vez só
+    for (int i = 0; i < N_FUNCOES; i++) {
+        if (!(c & (1ULL << i)) || !funcoes[i].auxiliar) continue;
+        int repetido = 0;
+        for (int j = 0; j < i; j++) {
+            if ((c & (1ULL << j)) && funcoes[j].auxiliar == funcoes[i].auxiliar) repetido = 1;
+        }
+        if (!repetido) t_texto(&t, funcoes[i].auxiliar);
+    }
+    return t_fim(&t);
+}
@@ -0,0 +1,55 @@
+#ifndef BIBLIOTECA_H
+#define BIBLIOTECA_H
+
+#include "codegen.h"
+
+// --- Biblioteca padrão do C ---
+// Funções de <math.h>, <stdlib.h> e <stdio.h> aceitas em chamadas e a
+// tradução de cada uma para Python com a semântica do C: sqrt(-1) é NaN e
+// não ValueError, floor() devolve double, rand() reproduz a sequência da
+// glibc, puts() acrescenta a quebra de linha... (printf continua tratado à
+// parte, em AST_PRINT e nos geradores).
+//
+// Cada tradução é um modelo de expressão Python: $0, $1 são os argumentos
+// e @x, uma ligação (`_x = valor`, ex: _sqrt = _math.sqrt). Com as ligações
+// ativas (--ligar=1, o padrão), os geradores atribuem `_x = valor` uma vez
+// no início de cada função que as usa e o corpo só lê variáveis locais;
+// com --ligar=0, cada chamada refaz a busca do atributo (ex: _math.sqrt).
+
+typedef struct {
+    const char* nome;           // nome em C
+    TipoDadoCG  retorno;        // TIPO_VOID: sem valor
+    int         n_args;
+    TipoDadoCG  args[2];        // TIPO_STRING: literal de string (puts)
+    const char* modelo;         // expressão Python
+    const char* auxiliar;       // definições de nível de módulo (ou NULL)
+} FuncaoBiblioteca;
+
+// Conjuntos de funções (bit = biblioteca_indice) e de ligações
+typedef unsigned long long ConjuntoBiblioteca;
+
+extern int ligar_biblioteca;    // --ligar: ligações em variáveis locais
+
+const FuncaoBiblioteca* biblioteca_buscar(const char* nome);
+int biblioteca_indice(const FuncaoBiblioteca* f);
+const FuncaoBiblioteca* biblioteca_funcao(int indice);  // NULL depois da última
+
+// Ligações que o modelo de `f` usa
+ConjuntoBiblioteca biblioteca_ligacoes(const FuncaoBiblioteca* f);
+// Nome local (ex: "_sqrt") de uma ligação que é chamada direto, sem
+// guardas, pelo modelo de `f` (ex: fabs), ou NULL
+const char* biblioteca_chamada_direta(const FuncaoBiblioteca* f);
+
+// Os textos abaixo são alocados com malloc e terminam em '\n' (exceto a
+// expressão).
+// Expressão de `f` com os argumentos dados (texto Python de cada um)
+char* biblioteca_expressao(const FuncaoBiblioteca* f, const char* const* args, int ligar);
+// `_x = valor` para cada ligação do conjunto, com a indentação dada
+char* biblioteca_ligar(ConjuntoBiblioteca ligacoes, const char* indentacao);
+// `_x=_x` para cada ligação, separados por vírgula: parâmetros com valor
+// padrão, que tornam as ligações locais a uma função definida no módulo
+char* biblioteca_parametros(ConjuntoBiblioteca ligacoes);
+// Nível de módulo para as funções do conjunto: imports e auxiliares
+char* biblioteca_preambulo(ConjuntoBiblioteca funcoes);
+
+#endif
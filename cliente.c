@@ -0,0 +1,108 @@
+// Cliente do servidor de compilação (`./compiler --servir`).
+// Aceita os mesmos argumentos do compilador e pode substituí-lo na linha de
+// comando:   ./cliente < teste/teste.c > teste/test.txt
+// O socket é lido de $COMPILADOR_SOCKET (padrão: /tmp/compilador.sock).
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "servidor.h"
+
+// Lê toda a entrada padrão para memória
+static char* ler_entrada(size_t* n) {
+    size_t cap = 1 << 16, tam = 0;
+    char* buf = malloc(cap);
+    size_t k;
+    while (buf && (k = fread(buf + tam, 1, cap - tam, stdin)) > 0) {
+        tam += k;
+        if (tam == cap) {
+            cap *= 2;
+            buf = realloc(buf, cap);
+        }
+    }
+    *n = tam;
+    return buf;
+}
+
+// O compilador só lê a entrada padrão quando não recebe um arquivo
+static int tem_arquivo(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-I") == 0 || strcmp(argv[i], "-D") == 0)) i++;
+        else if (argv[i][0] != '-') return 1;
+    }
+    return 0;
+}
+
+static int conectar(const char* caminho) {
+    struct sockaddr_un endereco;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+    if (connect(fd, (struct sockaddr*)&endereco, sizeof(endereco)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int main(int argc, char** argv) {
+    const char* caminho = getenv("COMPILADOR_SOCKET");
+    char cwd[PATH_MAX];
+    char* entrada = NULL;
+    size_t n_entrada = 0;
+
+    if (!caminho || !*caminho) caminho = SERVIDOR_SOCKET_PADRAO;
+    if (!getcwd(cwd, sizeof(cwd))) {
+        perror("Erro: getcwd");
+        return 1;
+    }
+    if (!tem_arquivo(argc, argv)) {
+        entrada = ler_entrada(&n_entrada);
+        if (!entrada) {
+            fprintf(stderr, "Erro: falha ao ler a entrada padrão\n");
+            return 1;
+        }
+    }
+
+    int fd = conectar(caminho);
+    if (fd < 0) {
+        fprintf(stderr, "Erro: servidor de compilação indisponível em %s "
+                        "(inicie com ./compiler --servir %s)\n", caminho, caminho);
+        return 1;
+    }
+
+    int ok = protocolo_escrever(fd, SERVIDOR_MAGICO, 4)
+          && protocolo_escrever_u32(fd, (uint32_t)argc);
+    for (int i = 0; ok && i < argc; i++) ok = protocolo_escrever_bloco(fd, argv[i], strlen(argv[i]));
+    ok = ok && protocolo_escrever_bloco(fd, cwd, strlen(cwd))
+            && protocolo_escrever_u32(fd, entrada != NULL)
+            && (!entrada || protocolo_escrever_bloco(fd, entrada, n_entrada));
+    free(entrada);
+
+    uint32_t status = 1;
+    size_t n_saida = 0, n_erro = 0;
+    char* saida = NULL;
+    char* erro = NULL;
+    ok = ok && protocolo_ler_u32(fd, &status)
+            && (saida = protocolo_ler_bloco(fd, &n_saida)) != NULL
+            && (erro = protocolo_ler_bloco(fd, &n_erro)) != NULL;
+    close(fd);
+    if (!ok) {
+        fprintf(stderr, "Erro: comunicação com o servidor de compilação falhou\n");
+        free(saida);
+        free(erro);
+        return 1;
+    }
+
+    fwrite(saida, 1, n_saida, stdout);
+    fwrite(erro, 1, n_erro, stderr);
+    free(saida);
+    free(erro);
+    return (int)status;
+}
@@ -1,21 +1,33 @@
 #include "codegen.h"
 #include "tabela.h" // Se você tiver uma tabela de símbolos
+#include "saida.h"
+#include "biblioteca.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <limits.h>
 
 // --- Variáveis Globais ---
 Quadrupla* code_head = NULL;
 Quadrupla* code_tail = NULL;
 int temp_count = 0;
+int emular_float32 = 0;
+
+// Posição C corrente, carimbada em cada quádrupla emitida
+static int linha_atual = 0;
+static int coluna_atual = 0;
+
+// Laço mais interno em tradução (break/continue)
+static NoAST* laco_atual = NULL;
 
 // --- Funções Auxiliares de Memória (robustas) ---
-Endereco criarEnderecoVazio() { Endereco e = {ADDR_EMPTY}; return e; }
-Endereco criarEnderecoVar(const char* n) { Endereco e = {ADDR_VAR}; e.val.varName = strdup(n); return e; }
-Endereco criarEnderecoTemp() { Endereco e = {ADDR_TEMP}; e.val.tempId = temp_count++; return e; }
-Endereco criarEnderecoConstInt(int v) { Endereco e = {ADDR_CONST_INT}; e.val.constInt = v; return e; }
-Endereco criarEnderecoConstFlt(float v) { Endereco e = {ADDR_CONST_FLT}; e.val.constFlt = v; return e; }
-Endereco criarEnderecoString(const char* s) { Endereco e = {ADDR_CONST_STR}; e.val.varName = strdup(s); return e; }
+Endereco criarEnderecoVazio() { Endereco e = {.tipo = ADDR_EMPTY}; return e; }
+Endereco criarEnderecoVar(const char* n) { Endereco e = {.tipo = ADDR_VAR}; e.val.varName = strdup(n); return e; }
+Endereco criarEnderecoTemp() { Endereco e = {.tipo = ADDR_TEMP}; e.val.tempId = temp_count++; return e; }
+Endereco criarEnderecoConstInt(long long v) { Endereco e = {.tipo = ADDR_CONST_INT}; e.val.constInt = v; return e; }
+Endereco criarEnderecoConstFlt(double v) { Endereco e = {.tipo = ADDR_CONST_FLT}; e.val.constFlt = v; return e; }
+Endereco criarEnderecoString(const char* s) { Endereco e = {.tipo = ADDR_CONST_STR}; e.val.varName = strdup(s); return e; }
 
 void liberarEndereco(Endereco* end) {
     if (end && (end->tipo == ADDR_VAR || end->tipo == ADDR_CONST_STR)) {
@@ -34,9 +46,12 @@ Endereco duplicarEndereco(Endereco end) {
 void emitir(OpCodeCG op, Endereco arg1, Endereco arg2, Endereco resultado) {
     Quadrupla* nova = (Quadrupla*)malloc(sizeof(Quadrupla));
     nova->op = op;
+    nova->tipo = TIPO_NENHUM;
     nova->arg1 = duplicarEndereco(arg1);
     nova->arg2 = duplicarEndereco(arg2);
     nova->resultado = duplicarEndereco(resultado);
+    nova->linha = linha_atual;
+    nova->coluna = coluna_atual;
     nova->next = NULL;
 
     if (!code_head) {
@@ -47,21 +62,301 @@ void emitir(OpCodeCG op, Endereco arg1, Endereco arg2, Endereco resultado) {
     }
 }
 
+// Tipos C: largura em bits (0: não é número), sem sinal, flutuante e posto
+// de conversão dos inteiros (char 1, short 2, int 3, long 4, long long 5)
+static const struct {
+    const char* nome;
+    int bits, sem_sinal, flutuante, posto;
+} tiposC[] = {
+    [TIPO_NENHUM] = { "",                   0,  0, 0, 0 },
+    [TIPO_INT]    = { "int",                32, 0, 0, 3 },
+    [TIPO_FLOAT]  = { "float",              32, 0, 1, 0 },
+    [TIPO_CHAR]   = { "char",               8,  0, 0, 1 },
+    [TIPO_VOID]   = { "void",               0,  0, 0, 0 },
+    [TIPO_STRING] = { "string",             0,  0, 0, 0 },
+    [TIPO_SCHAR]  = { "signed char",        8,  0, 0, 1 },
+    [TIPO_UCHAR]  = { "unsigned char",      8,  1, 0, 1 },
+    [TIPO_SHORT]  = { "short",              16, 0, 0, 2 },
+    [TIPO_USHORT] = { "unsigned short",     16, 1, 0, 2 },
+    [TIPO_UINT]   = { "unsigned int",       32, 1, 0, 3 },
+    [TIPO_LONG]   = { "long",               64, 0, 0, 4 },
+    [TIPO_ULONG]  = { "unsigned long",      64, 1, 0, 4 },
+    [TIPO_LLONG]  = { "long long",          64, 0, 0, 5 },
+    [TIPO_ULLONG] = { "unsigned long long", 64, 1, 0, 5 },
+    [TIPO_DOUBLE] = { "double",             64, 0, 1, 0 },
+};
+#define N_TIPOS_C ((int)(sizeof(tiposC) / sizeof(tiposC[0])))
+
+TipoDadoCG tipoDadoDeNome(const char* nome) {
+    if (!nome) return TIPO_NENHUM;
+    for (int t = TIPO_INT; t < N_TIPOS_C; t++) {
+        if (strcmp(nome, tiposC[t].nome) == 0) return (TipoDadoCG)t;
+    }
+    return TIPO_NENHUM;
+}
+
+const char* nomeTipoDado(TipoDadoCG tipo) {
+    if ((unsigned)tipo < (unsigned)N_TIPOS_C) return tiposC[tipo].nome;
+    return "";
+}
+
+static int tipoValido(TipoDadoCG tipo) { return (unsigned)tipo < (unsigned)N_TIPOS_C; }
+
+int tipoInteiro(TipoDadoCG tipo)    { return tipoValido(tipo) && tiposC[tipo].bits > 0 && !tiposC[tipo].flutuante; }
+int tipoFlutuante(TipoDadoCG tipo)  { return tipoValido(tipo) && tiposC[tipo].flutuante; }
+int tipoAritmetico(TipoDadoCG tipo) { return tipoValido(tipo) && tiposC[tipo].bits > 0; }
+int tipoSemSinal(TipoDadoCG tipo)   { return tipoValido(tipo) && tiposC[tipo].sem_sinal; }
+int bitsTipo(TipoDadoCG tipo)       { return tipoValido(tipo) ? tiposC[tipo].bits : 0; }
+
+// Inteiros menores que int cabem em int e viram int nas operações
+TipoDadoCG tipoPromovido(TipoDadoCG tipo) {
+    return tipoInteiro(tipo) && tiposC[tipo].posto < tiposC[TIPO_INT].posto ? TIPO_INT : tipo;
+}
+
+static TipoDadoCG semSinalDe(TipoDadoCG tipo) {
+    switch (tipo) {
+        case TIPO_INT:   return TIPO_UINT;
+        case TIPO_LONG:  return TIPO_ULONG;
+        case TIPO_LLONG: return TIPO_ULLONG;
+        default:         return tipo;
+    }
+}
+
+TipoDadoCG tipoComum(TipoDadoCG a, TipoDadoCG b) {
+    if (a == TIPO_DOUBLE || b == TIPO_DOUBLE) return TIPO_DOUBLE;
+    if (a == TIPO_FLOAT || b == TIPO_FLOAT) return TIPO_FLOAT;
+    a = tipoPromovido(a);
+    b = tipoPromovido(b);
+    if (a == b) return a;
+    if (tiposC[a].sem_sinal == tiposC[b].sem_sinal) return tiposC[a].posto >= tiposC[b].posto ? a : b;
+    TipoDadoCG u = tiposC[a].sem_sinal ? a : b, s = tiposC[a].sem_sinal ? b : a;
+    if (tiposC[u].posto >= tiposC[s].posto) return u;
+    if (tiposC[s].bits > tiposC[u].bits) return s;
+    return semSinalDe(s);
+}
+
+int cabeEm(TipoDadoCG de, TipoDadoCG para) {
+    if (de == para) return 1;
+    if (!tipoInteiro(de) || !tipoInteiro(para)) return 0;
+    if (tiposC[de].sem_sinal) return tiposC[para].sem_sinal ? tiposC[de].bits <= tiposC[para].bits
+                                                           : tiposC[de].bits < tiposC[para].bits;
+    return !tiposC[para].sem_sinal && tiposC[de].bits <= tiposC[para].bits;
+}
+
+int ajustarInteiro(long long valor, TipoDadoCG tipo, long long* resultado) {
+    int bits = bitsTipo(tipo);
+    if (bits >= 64) {
+        if (tipoSemSinal(tipo) && valor < 0) return 0;
+        *resultado = valor;
+        return 1;
+    }
+    unsigned long long mascara = (1ULL << bits) - 1, v = (unsigned long long)valor & mascara;
+    if (!tipoSemSinal(tipo) && (v >> (bits - 1))) {
+        *resultado = (long long)v - (long long)(1ULL << bits);
+    } else {
+        *resultado = (long long)v;
+    }
+    return 1;
+}
+
+void formatarFloat(double valor, char* buf, size_t tam) {
+    if (isnan(valor)) { snprintf(buf, tam, "float('nan')"); return; }
+    if (isinf(valor)) { snprintf(buf, tam, valor < 0 ? "-1e999" : "1e999"); return; }
+    for (int precisao = 1; precisao <= 17; precisao++) {
+        snprintf(buf, tam, "%.*g", precisao, valor);
+        if (strtod(buf, NULL) == valor) break;
+    }
+    if (!strpbrk(buf, ".e")) strncat(buf, ".0", tam - strlen(buf) - 1);
+}
+
+// Anota o tipo C (tipoDado de um nó da AST) na última quádrupla emitida
+static void marcarTipo(const NoAST* no) {
+    if (code_tail && no) code_tail->tipo = tipoDadoDeNome(no->tipoDado);
+}
+
+static TipoDadoCG tipoDoNo(const NoAST* no) {
+    return no ? tipoDadoDeNome(no->tipoDado) : TIPO_NENHUM;
+}
+
+// `resultado = op valor` com o tipo de destino; consome `valor`
+static Endereco emitirConversao(OpCodeCG op, Endereco valor, TipoDadoCG para) {
+    Endereco res = criarEnderecoTemp();
+    emitir(op, valor, criarEnderecoVazio(), res);
+    code_tail->tipo = para;
+    liberarEndereco(&valor);
+    return res;
+}
+
+// Converte `valor` (do tipo `de`) para `para`, emitindo código só quando o
+// valor pode mudar: inteiros que não cabem no destino, inteiro para ponto
+// flutuante e, com --float32=1, qualquer coisa para float. Constantes são
+// convertidas aqui. Com `operando`, a conversão de inteiro para double é
+// omitida: a aritmética mista do Python já a faz. Consome `valor`.
+static Endereco converter(Endereco valor, TipoDadoCG de, TipoDadoCG para, int operando) {
+    if (de == para || !tipoAritmetico(de) || !tipoAritmetico(para)) return valor;
+    if (tipoFlutuante(para)) {
+        int arredondar = para == TIPO_FLOAT && emular_float32;
+        if (valor.tipo == ADDR_CONST_INT) {
+            return criarEnderecoConstFlt(arredondar ? (double)(float)valor.val.constInt : (double)valor.val.constInt);
+        }
+        if (valor.tipo == ADDR_CONST_FLT) {
+            if (arredondar) valor.val.constFlt = (double)(float)valor.val.constFlt;
+            return valor;
+        }
+        if (arredondar) return emitirConversao(CG_F32, valor, para);
+        if (tipoInteiro(de) && !operando) return emitirConversao(CG_CONVERT, valor, para);
+        return valor;
+    }
+    // (ponto flutuante para inteiro não passa pela análise semântica)
+    if (!tipoInteiro(de) || cabeEm(de, para)) return valor;
+    long long v;
+    if (valor.tipo == ADDR_CONST_INT && ajustarInteiro(valor.val.constInt, para, &v)) {
+        valor.val.constInt = v;
+        return valor;
+    }
+    return emitirConversao(CG_CONVERT, valor, para);
+}
+
+// Depois da operação: inteiros sem sinal voltam à sua largura e, com
+// --float32=1, o float é arredondado para 32 bits
+static Endereco ajustarResultado(OpCodeCG op, Endereco valor, TipoDadoCG tipo) {
+    if (tipoSemSinal(tipo)) {
+        // &, >>, / e % de valores no intervalo continuam no intervalo
+        if (op == CG_ADD || op == CG_SUB || op == CG_MUL || op == CG_SHL || op == CG_BIT_OR ||
+            op == CG_BIT_XOR || op == CG_UMINUS || op == CG_BIT_NOT) {
+            return emitirConversao(CG_CONVERT, valor, tipo);
+        }
+    } else if (tipo == TIPO_FLOAT && emular_float32) {
+        if (op == CG_ADD || op == CG_SUB || op == CG_MUL || op == CG_DIV) {
+            return emitirConversao(CG_F32, valor, tipo);
+        }
+    }
+    return valor;
+}
+
+// Valor de um literal do fonte: inteiro com sufixo (u, l, ll), em decimal,
+// octal ou hexadecimal, ou ponto flutuante com sufixo (f, l)
+static Endereco constanteDoNo(const NoAST* no) {
+    TipoDadoCG tipo = tipoDoNo(no);
+    if (tipoFlutuante(tipo)) {
+        double v = strtod(no->valor, NULL);
+        return criarEnderecoConstFlt(tipo == TIPO_FLOAT && emular_float32 ? (double)(float)v : v);
+    }
+    unsigned long long v = strtoull(no->valor, NULL, 0);
+    if (v <= (unsigned long long)LLONG_MAX) return criarEnderecoConstInt((long long)v);
+    // unsigned de 64 bits acima de LLONG_MAX: o padrão de bits, ajustado em tempo de execução
+    return emitirConversao(CG_CONVERT, criarEnderecoConstInt((long long)v), tipo);
+}
+
+// Valor de um literal de caractere ('a', '\n'), que em C é int
+static long long valorDoCaractere(const char* lit) {
+    if (lit[0] != '\'' || lit[1] == '\0') return 0;
+    if (lit[1] != '\\') return (unsigned char)lit[1];
+    switch (lit[2]) {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        case '0': return '\0';
+        case 'a': return '\a';
+        case 'b': return '\b';
+        case 'f': return '\f';
+        case 'v': return '\v';
+        default:  return (unsigned char)lit[2];
+    }
+}
+
+// O % do Python aceita no máximo um modificador de tamanho (h, l ou L) e o
+// ignora; os do C (hh, ll, z, j, t...) são retirados do formato do printf
+static char* formatoPython(const char* fmt) {
+    char* saida = malloc(strlen(fmt) + 1);
+    char* o = saida;
+    while (*fmt) {
+        *o++ = *fmt;
+        if (*fmt++ != '%') continue;
+        if (*fmt == '%') { *o++ = *fmt++; continue; }
+        while (*fmt && strchr("-+ #0123456789.*", *fmt)) *o++ = *fmt++;
+        while (*fmt && strchr("hlLqjzt", *fmt)) fmt++;
+    }
+    *o = '\0';
+    return saida;
+}
+
 // --- Geração de Código Principal (HLIR) ---
+static Endereco gerarCodigoNo(NoAST* no);
+
+// A expressão pode falhar no Python ou ter efeito colateral? Chamadas,
+// atribuições, / e % (divisão por zero) e deslocamentos (contagem negativa)
+static int exigeCurtoCircuito(const NoAST* no) {
+    if (!no) return 0;
+    if (no->tipo == AST_CALL || no->tipo == AST_ATRIB) return 1;
+    if (no->tipo == AST_EXPR && no->n_filhos == 2 && no->valor &&
+        (strcmp(no->valor, "/") == 0 || strcmp(no->valor, "%") == 0 ||
+         strcmp(no->valor, "<<") == 0 || strcmp(no->valor, ">>") == 0)) return 1;
+    for (int i = 0; i < no->n_filhos; i++) {
+        if (exigeCurtoCircuito(no->filhos[i])) return 1;
+    }
+    return 0;
+}
+
+// `a && b` / `a || b` com um b que não pode ser avaliado sempre: o C só
+// avalia b quando a não decide o resultado, então b fica dentro de um if
+// sobre a (sem risco em b, AND/OR calculam os dois lados, mais barato)
+//   r = a && b:  if a: r = b != 0  else: r = 0
+//   r = a || b:  if a: r = 1       else: r = b != 0
+static Endereco gerarCurtoCircuito(NoAST* no, int e) {
+    Endereco endRes = criarEnderecoTemp();
+    Endereco esq = gerarCodigo(no->filhos[0]);
+    emitir(CG_IF_START, esq, criarEnderecoVazio(), criarEnderecoVazio());
+    liberarEndereco(&esq);
+    emitir(CG_THEN_START, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
+    for (int braco = 0; braco < 2; braco++) {
+        if (braco == 1) emitir(CG_ELSE_START, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
+        if (braco == (e ? 0 : 1)) {
+            Endereco dir = gerarCodigo(no->filhos[1]);
+            Endereco zero = tipoFlutuante(tipoDoNo(no->filhos[1])) ? criarEnderecoConstFlt(0.0)
+                                                                   : criarEnderecoConstInt(0);
+            emitir(CG_NEQ, dir, zero, endRes);
+            liberarEndereco(&dir);
+        } else {
+            emitir(CG_ASSIGN, criarEnderecoConstInt(e ? 0 : 1), criarEnderecoVazio(), endRes);
+        }
+        code_tail->tipo = TIPO_INT;
+    }
+    emitir(CG_IF_END, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
+    return endRes;
+}
+
+// Ponto de entrada: nós que conhecem sua posição no fonte C passam a ser a
+// posição corrente enquanto seus filhos são traduzidos.
 Endereco gerarCodigo(NoAST* no) {
     if (!no) return criarEnderecoVazio();
+    if (no->linha <= 0) return gerarCodigoNo(no);
+
+    int linha_anterior = linha_atual, coluna_anterior = coluna_atual;
+    linha_atual = no->linha;
+    coluna_atual = no->coluna;
+    Endereco res = gerarCodigoNo(no);
+    linha_atual = linha_anterior;
+    coluna_atual = coluna_anterior;
+    return res;
+}
 
+static Endereco gerarCodigoNo(NoAST* no) {
     Endereco end1, end2, endRes, endCond;
 
     switch (no->tipo) {
         // Um bloco é uma sequência de comandos. Geramos código para cada filho.
         case AST_FUNC_DEF: {
-            // A definição de uma função não gera código executável em si,
-            // mas seu corpo sim. Apenas continuamos a travessia para
-            // o nó filho, que é o bloco de comandos da função.
+            // O corpo da função fica entre FUNC_START e FUNC_END, que levam
+            // o nome da função (def no Python gerado)
+            end1 = criarEnderecoVar(no->valor);
+            emitir(CG_FUNC_START, end1, criarEnderecoVazio(), criarEnderecoVazio());
+            marcarTipo(no);
+            liberarEndereco(&end1);
             if (no->n_filhos > 0) {
                 gerarCodigo(no->filhos[0]);
             }
+            emitir(CG_FUNC_END, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
             return criarEnderecoVazio();
         }
 
@@ -70,6 +365,7 @@ Endereco gerarCodigo(NoAST* no) {
             if (no->n_filhos > 0) {
                 end1 = gerarCodigo(no->filhos[0]);
                 emitir(CG_RETURN, end1, criarEnderecoVazio(), criarEnderecoVazio());
+                marcarTipo(no->filhos[0]);
                 liberarEndereco(&end1);
             } else { // Se for um "return;" vazio
                 emitir(CG_RETURN, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
@@ -91,16 +387,18 @@ Endereco gerarCodigo(NoAST* no) {
         case AST_ATRIB: {
             end1 = criarEnderecoVar(no->valor); // Endereço da variável (LHS)
             end2 = gerarCodigo(no->filhos[0]);   // Endereço do resultado da expressão (RHS)
+            end2 = converter(end2, tipoDoNo(no->filhos[0]), tipoDoNo(no), 0);
             emitir(CG_ASSIGN, end2, criarEnderecoVazio(), end1);
+            marcarTipo(no);
             liberarEndereco(&end2);
             return end1;
         }
 
         // Terminais: convertem o valor do nó em um Endereço
         case AST_NUM:
-            return (strcmp(no->tipoDado, "int") == 0)
-                   ? criarEnderecoConstInt(atoi(no->valor))
-                   : criarEnderecoConstFlt(atof(no->valor));
+            return constanteDoNo(no);
+        case AST_CHAR:
+            return criarEnderecoConstInt(valorDoCaractere(no->valor));
         case AST_ID:
             return criarEnderecoVar(no->valor);
         case AST_STRING:
@@ -108,19 +406,27 @@ Endereco gerarCodigo(NoAST* no) {
 
         // Expressões: o coração da geração de código para cálculos e comparações
         case AST_EXPR: {
-            // Caso unário (ex: -x)
+            // Caso unário (ex: -x, !x, ~x)
             if (no->n_filhos == 1) {
                 end1 = gerarCodigo(no->filhos[0]);
                 endRes = criarEnderecoTemp();
-                emitir(CG_UMINUS, end1, criarEnderecoVazio(), endRes);
+                OpCodeCG opUnario = strcmp(no->valor, "!") == 0 ? CG_NOT
+                                  : strcmp(no->valor, "~") == 0 ? CG_BIT_NOT : CG_UMINUS;
+                emitir(opUnario, end1, criarEnderecoVazio(), endRes);
+                marcarTipo(no);
                 liberarEndereco(&end1);
-                return endRes;
+                return ajustarResultado(opUnario, endRes, tipoDoNo(no));
             }
 
             // Caso binário (ex: a + b, a < b)
+            if ((strcmp(no->valor, "&&") == 0 || strcmp(no->valor, "||") == 0) &&
+                exigeCurtoCircuito(no->filhos[1])) {
+                return gerarCurtoCircuito(no, strcmp(no->valor, "&&") == 0);
+            }
+            TipoDadoCG tipo = tipoDoNo(no);
+            TipoDadoCG tipo1 = tipoDoNo(no->filhos[0]), tipo2 = tipoDoNo(no->filhos[1]);
             end1 = gerarCodigo(no->filhos[0]);
             end2 = gerarCodigo(no->filhos[1]);
-            endRes = criarEnderecoTemp();
             OpCodeCG opCode;
 
             // Mapeia o operador do nó para o nosso OpCodeCG
@@ -128,7 +434,7 @@ Endereco gerarCodigo(NoAST* no) {
                  if (strcmp(op, "+") == 0) opCode = CG_ADD;
             else if (strcmp(op, "-") == 0) opCode = CG_SUB;
             else if (strcmp(op, "*") == 0) opCode = CG_MUL;
-            else if (strcmp(op, "/") == 0) opCode = CG_DIV;
+            else if (strcmp(op, "/") == 0) opCode = tipoInteiro(tipo) ? CG_IDIV : CG_DIV;
             else if (strcmp(op, "%") == 0) opCode = CG_MOD;
             else if (strcmp(op, "<") == 0) opCode = CG_LT;
             else if (strcmp(op, ">") == 0) opCode = CG_GT;
@@ -136,10 +442,35 @@ Endereco gerarCodigo(NoAST* no) {
             else if (strcmp(op, ">=") == 0) opCode = CG_GTE;
             else if (strcmp(op, "==") == 0) opCode = CG_EQ;
             else if (strcmp(op, "!=") == 0) opCode = CG_NEQ;
-            else { /* Tratar erro de operador desconhecido */ opCode = -1; }
+            else if (strcmp(op, "&") == 0) opCode = CG_BIT_AND;
+            else if (strcmp(op, "|") == 0) opCode = CG_BIT_OR;
+            else if (strcmp(op, "^") == 0) opCode = CG_BIT_XOR;
+            else if (strcmp(op, "<<") == 0) opCode = CG_SHL;
+            else if (strcmp(op, ">>") == 0) opCode = CG_SHR;
+            else if (strcmp(op, "&&") == 0) opCode = CG_AND;
+            else if (strcmp(op, "||") == 0) opCode = CG_OR;
+            else { /* Tratar erro de operador desconhecido */ opCode = CG_NUM_OPCODES; }
+
+            // Operandos no tipo da operação, onde o valor importa: comparações
+            // (no tipo comum), divisão e resto, e aritmética float com --float32=1
+            if (opCode >= CG_LT && opCode <= CG_NEQ) {
+                // A comparação mista do Python é exata: inteiros de 64 bits,
+                // que podem não caber no double, são convertidos antes, como no C
+                TipoDadoCG comum = tipoComum(tipo1, tipo2);
+                end1 = converter(end1, tipo1, comum, bitsTipo(tipo1) < 64);
+                end2 = converter(end2, tipo2, comum, bitsTipo(tipo2) < 64);
+            } else if (opCode == CG_IDIV || opCode == CG_MOD || tipoFlutuante(tipo)) {
+                end1 = converter(end1, tipo1, tipo, 1);
+                end2 = converter(end2, tipo2, tipo, 1);
+            }
 
             // Emite a quádrupla para a operação e retorna o temporário com o resultado
-            if(opCode != -1) emitir(opCode, end1, end2, endRes);
+            endRes = criarEnderecoTemp();
+            if(opCode != CG_NUM_OPCODES) {
+                emitir(opCode, end1, end2, endRes);
+                marcarTipo(no);
+                endRes = ajustarResultado(opCode, endRes, tipo);
+            }
             liberarEndereco(&end1);
             liberarEndereco(&end2);
             return endRes;
@@ -164,8 +495,31 @@ Endereco gerarCodigo(NoAST* no) {
             return criarEnderecoVazio();
         }
         
+        // break/continue: desvios estruturados do laço mais interno (o
+        // parser já garantiu que há um). O continue volta ao topo do laço,
+        // onde o while reavalia a condição; antes dele vai o que o C executa
+        // entre o fim do corpo e o teste: o incremento do for, ou o teste do
+        // do-while (que fica no fim do corpo).
+        case AST_BREAK:
+            emitir(CG_BREAK, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
+            return criarEnderecoVazio();
+
+        case AST_CONTINUE:
+            if (laco_atual && laco_atual->tipo == AST_FOR) {
+                end1 = gerarCodigo(laco_atual->filhos[2]);
+                liberarEndereco(&end1);
+            } else if (laco_atual && laco_atual->tipo == AST_DO_WHILE) {
+                endCond = gerarCodigo(laco_atual->filhos[1]);
+                emitir(CG_BREAK_IF_FALSE, endCond, criarEnderecoVazio(), criarEnderecoVazio());
+                liberarEndereco(&endCond);
+            }
+            emitir(CG_CONTINUE, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
+            return criarEnderecoVazio();
+
         // Estruturas de Controle (WHILE)
         case AST_WHILE: {
+            NoAST* laco_externo = laco_atual;
+            laco_atual = no;
             emitir(CG_WHILE_START, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
             emitir(CG_BODY_START, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
             
@@ -184,10 +538,37 @@ Endereco gerarCodigo(NoAST* no) {
             // --- Fim do Corpo do Loop ---
 
             emitir(CG_WHILE_END, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
+            laco_atual = laco_externo;
             return criarEnderecoVazio();
         }
         
+        // FOR: init; while (cond) { corpo; incremento; }
+        // (filhos: atribuição inicial, condição, incremento, corpo)
+        case AST_FOR: {
+            end1 = gerarCodigo(no->filhos[0]);
+            liberarEndereco(&end1);
+
+            NoAST* laco_externo = laco_atual;
+            laco_atual = no;
+            emitir(CG_WHILE_START, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
+            emitir(CG_BODY_START, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
+
+            endCond = gerarCodigo(no->filhos[1]);
+            emitir(CG_BREAK_IF_FALSE, endCond, criarEnderecoVazio(), criarEnderecoVazio());
+            liberarEndereco(&endCond);
+
+            gerarCodigo(no->filhos[3]);
+            end1 = gerarCodigo(no->filhos[2]);
+            liberarEndereco(&end1);
+
+            emitir(CG_WHILE_END, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
+            laco_atual = laco_externo;
+            return criarEnderecoVazio();
+        }
+
         case AST_DO_WHILE: {
+            NoAST* laco_externo = laco_atual;
+            laco_atual = no;
             emitir(CG_DO_WHILE_START, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
             emitir(CG_BODY_START, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
 
@@ -207,6 +588,7 @@ Endereco gerarCodigo(NoAST* no) {
             // --- Fim do Corpo do Loop ---
 
             emitir(CG_DO_WHILE_END, criarEnderecoVazio(), criarEnderecoVazio(), criarEnderecoVazio());
+            laco_atual = laco_externo;
             return criarEnderecoVazio();
         }
 
@@ -214,8 +596,15 @@ Endereco gerarCodigo(NoAST* no) {
         case AST_PRINT: {
             // 1. Empilha os parâmetros na ordem inversa
             for (int i = no->n_filhos - 1; i >= 0; i--) {
-                end1 = gerarCodigo(no->filhos[i]);
+                if (i == 0 && no->filhos[0]->tipo == AST_STRING) {
+                    char* formato = formatoPython(no->filhos[0]->valor);
+                    end1 = criarEnderecoString(formato);
+                    free(formato);
+                } else {
+                    end1 = gerarCodigo(no->filhos[i]);
+                }
                 emitir(CG_PARAM, end1, criarEnderecoVazio(), criarEnderecoVazio());
+                marcarTipo(no->filhos[i]);
                 liberarEndereco(&end1);
             }
             // 2. Emite a chamada
@@ -227,6 +616,28 @@ Endereco gerarCodigo(NoAST* no) {
             return criarEnderecoVazio();
         }
         
+        // Chamada a uma função da biblioteca (biblioteca.h): os argumentos,
+        // convertidos para o tipo de cada parâmetro, são empilhados na ordem
+        // inversa, como os do printf. O valor vai para um temporário.
+        case AST_CALL: {
+            const FuncaoBiblioteca* f = biblioteca_buscar(no->valor);
+            for (int i = no->n_filhos - 1; i >= 0; i--) {
+                TipoDadoCG param = f && i < f->n_args ? f->args[i] : tipoDoNo(no->filhos[i]);
+                end1 = gerarCodigo(no->filhos[i]);
+                end1 = converter(end1, tipoDoNo(no->filhos[i]), param, 0);
+                emitir(CG_PARAM, end1, criarEnderecoVazio(), criarEnderecoVazio());
+                code_tail->tipo = param;
+                liberarEndereco(&end1);
+            }
+            end1 = criarEnderecoString(no->valor);
+            end2 = criarEnderecoConstInt(no->n_filhos);
+            endRes = f && f->retorno != TIPO_VOID ? criarEnderecoTemp() : criarEnderecoVazio();
+            emitir(CG_CALL, end1, end2, endRes);
+            marcarTipo(no);
+            liberarEndereco(&end1);
+            return endRes;
+        }
+
         default:
             // Para outros tipos de nós AST que não geram código
             return criarEnderecoVazio();
@@ -234,41 +645,91 @@ Endereco gerarCodigo(NoAST* no) {
 }
 
 // --- Funções de Impressão e Liberação ---
+// Toda a impressão passa pelo buffer de saída (saida.h).
+
+static const char* nomesOpcode[] = {
+    "ASSIGN", "ADD", "SUB", "MUL", "DIV", "MOD", "UMINUS",
+    "LT", "GT", "LTE", "GTE", "EQ", "NEQ",
+    "PARAM", "CALL",
+    "IF_START", "THEN_START", "ELSE_START", "IF_END",
+    "WHILE_START", "WHILE_COND", "BODY_START", "WHILE_END", "BREAK_IF_FALSE",
+    "DO_WHILE_START", "DO_WHILE_END", "RETURN",
+    "FUNC_START", "FUNC_END",
+    "IDIV", "BAND", "BOR", "BXOR", "SHL", "SHR", "BNOT",
+    "NOT", "AND", "OR",
+    "CONV", "F32",
+    "BREAK", "CONTINUE"
+};
+
+const char* nomeOpcode(OpCodeCG op) {
+    if ((unsigned)op < sizeof(nomesOpcode) / sizeof(nomesOpcode[0])) return nomesOpcode[op];
+    return "?";
+}
+
+int opcodeDeValor(OpCodeCG op) {
+    return op <= CG_NEQ || (op >= CG_IDIV && op <= CG_F32);
+}
+
 void imprimirEndereco(Endereco end) {
     switch(end.tipo) {
-        case ADDR_EMPTY:     printf("_"); break;
-        case ADDR_VAR:       printf("%s", end.val.varName); break;
-        case ADDR_TEMP:      printf("t%d", end.val.tempId); break;
-        case ADDR_CONST_INT: printf("%d", end.val.constInt); break;
-        case ADDR_CONST_FLT: printf("%.2f", end.val.constFlt); break;
-        case ADDR_CONST_STR: printf("%s", end.val.varName); break;
-        default:             printf("?"); break;
+        case ADDR_EMPTY:     saida_char('_'); break;
+        case ADDR_VAR:       saida_texto(end.val.varName); break;
+        case ADDR_TEMP:      saida_char('t'); saida_int(end.val.tempId); break;
+        case ADDR_CONST_INT: saida_printf("%lld", end.val.constInt); break;
+        case ADDR_CONST_FLT: {
+            char buf[64];
+            formatarFloat(end.val.constFlt, buf, sizeof(buf));
+            saida_texto(buf);
+            break;
+        }
+        case ADDR_CONST_STR: saida_texto(end.val.varName); break;
+        default:             saida_char('?'); break;
     }
 }
 
-// Função de impressão atualizada para todos os novos opcodes
+// Estado da listagem em partes: número da próxima quádrupla, se já saiu
+// alguma (separador do JSON) e o maior número de temporários de uma função
+static int num_quadrupla = 0;
+static int maior_temp_count = 0;
+
+void imprimirCabecalhoHLIR(int json) {
+    num_quadrupla = 0;
+    maior_temp_count = 0;
+    if (json) saida_texto("{\"versao\": 1, \"quadruplas\": [");
+    else      saida_texto("\n---- Código Intermediário (HLIR Estruturado) ----\n");
+}
+
+void imprimirRodapeHLIR(int json) {
+    if (json) {
+        saida_texto("\n], \"temporarios\": ");
+        saida_int(maior_temp_count);
+        saida_texto("}\n");
+    } else {
+        saida_texto("---------------------------------------------------\n");
+    }
+}
+
+// Imprime as quádruplas correntes (em geral, uma função)
 void imprimirCodigoIntermediario() {
-    printf("\n---- Código Intermediário (HLIR Estruturado) ----\n");
     Quadrupla* atual = code_head;
-    int count = 0;
     while(atual) {
-        printf("%3d: ", count++);
+        saida_printf("%3d: ", num_quadrupla++);
+        if (atual->linha > 0) saida_printf("@%d:%d ", atual->linha, atual->coluna);
         
         // Helper para imprimir quádruplas no formato "res = arg1 op arg2"
         #define PRINT_OP(op_name, op_symbol) \
-            printf("%-7s ", op_name); \
-            imprimirEndereco(atual->resultado); printf(" = "); \
-            imprimirEndereco(atual->arg1); printf(" %s ", op_symbol); \
+            saida_printf("%-7s ", op_name); \
+            imprimirEndereco(atual->resultado); saida_texto(" = "); \
+            imprimirEndereco(atual->arg1); saida_texto(" " op_symbol " "); \
             imprimirEndereco(atual->arg2); break
         
         switch(atual->op) {
-            case CG_ASSIGN: printf("ASSIGN  "); imprimirEndereco(atual->resultado); printf(" = "); imprimirEndereco(atual->arg1); break;
+            case CG_ASSIGN: saida_texto("ASSIGN  "); imprimirEndereco(atual->resultado); saida_texto(" = "); imprimirEndereco(atual->arg1); break;
             
             case CG_ADD:    PRINT_OP("ADD", "+");
             case CG_SUB:    PRINT_OP("SUB", "-");
             case CG_MUL:    PRINT_OP("MUL", "*");
             case CG_DIV:    PRINT_OP("DIV", "/");
-            case CG_MOD:    PRINT_OP("MOD", "%%");
             
             case CG_LT:     PRINT_OP("LT", "<");
             case CG_GT:     PRINT_OP("GT", ">");
@@ -277,32 +738,102 @@ void imprimirCodigoIntermediario() {
             case CG_EQ:     PRINT_OP("EQ", "==");
             case CG_NEQ:    PRINT_OP("NEQ", "!=");
 
-            case CG_UMINUS: printf("UMINUS  "); imprimirEndereco(atual->resultado); printf(" = -"); imprimirEndereco(atual->arg1); break;
+            // Divisão e resto de inteiros largos ou sem sinal levam o tipo,
+            // que muda a tradução (quad_to_python.py)
+            case CG_IDIV:
+            case CG_MOD:
+                saida_printf("%-7s ", nomeOpcode(atual->op));
+                imprimirEndereco(atual->resultado); saida_texto(" = ");
+                imprimirEndereco(atual->arg1); saida_texto(atual->op == CG_IDIV ? " / " : " % ");
+                imprimirEndereco(atual->arg2);
+                if (tipoSemSinal(atual->tipo) || bitsTipo(atual->tipo) > 32) saida_printf(" (%s)", nomeTipoDado(atual->tipo));
+                break;
+            case CG_BIT_AND: PRINT_OP("BAND", "&");
+            case CG_BIT_OR:  PRINT_OP("BOR", "|");
+            case CG_BIT_XOR: PRINT_OP("BXOR", "^");
+            case CG_SHL:     PRINT_OP("SHL", "<<");
+            case CG_SHR:     PRINT_OP("SHR", ">>");
+            case CG_AND:     PRINT_OP("AND", "&&");
+            case CG_OR:      PRINT_OP("OR", "||");
+
+            case CG_UMINUS: saida_texto("UMINUS  "); imprimirEndereco(atual->resultado); saida_texto(" = -"); imprimirEndereco(atual->arg1); break;
+            case CG_BIT_NOT: saida_texto("BNOT    "); imprimirEndereco(atual->resultado); saida_texto(" = ~"); imprimirEndereco(atual->arg1); break;
+            case CG_NOT:    saida_texto("NOT     "); imprimirEndereco(atual->resultado); saida_texto(" = !"); imprimirEndereco(atual->arg1); break;
+            case CG_CONVERT: saida_texto("CONV    "); imprimirEndereco(atual->resultado); saida_printf(" = (%s) ", nomeTipoDado(atual->tipo)); imprimirEndereco(atual->arg1); break;
+            case CG_F32:    saida_texto("F32     "); imprimirEndereco(atual->resultado); saida_texto(" = "); imprimirEndereco(atual->arg1); break;
             
-            case CG_PARAM:  printf("PARAM   "); imprimirEndereco(atual->arg1); break;
-            case CG_CALL:   printf("CALL    "); imprimirEndereco(atual->arg1); printf(", "); imprimirEndereco(atual->arg2); break;
+            case CG_PARAM:  saida_texto("PARAM   "); imprimirEndereco(atual->arg1); break;
+            case CG_CALL:
+                saida_texto("CALL    ");
+                if (atual->resultado.tipo != ADDR_EMPTY) { imprimirEndereco(atual->resultado); saida_texto(" = "); }
+                imprimirEndereco(atual->arg1); saida_texto(", "); imprimirEndereco(atual->arg2);
+                break;
             
-            case CG_IF_START:   printf("IF_START"); printf(" "); imprimirEndereco(atual->arg1); break; // Mude de "IF" para "IF_START"
+            case CG_IF_START:   saida_texto("IF_START "); imprimirEndereco(atual->arg1); break;
             
-            case CG_THEN_START: printf("  THEN_START"); break;
-            case CG_ELSE_START: printf("  ELSE_START"); break;
-            case CG_IF_END:     printf("IF_END"); break;
-
-            case CG_WHILE_START:    printf("WHILE_START"); break;
-            case CG_WHILE_COND:     printf("  WHILE_COND "); imprimirEndereco(atual->arg1); break;
-            case CG_BODY_START:     printf("    BODY_START"); break;
-            case CG_WHILE_END:      printf("WHILE_END"); break;
-            case CG_BREAK_IF_FALSE: printf("  BREAK_IF_FALSE "); imprimirEndereco(atual->arg1); break;
-            case CG_DO_WHILE_START: printf("DO_WHILE_START"); break;
-            case CG_DO_WHILE_END:   printf("DO_WHILE_END"); break;
-            case CG_RETURN:   printf("RETURN  "); imprimirEndereco(atual->arg1); break;
+            case CG_THEN_START: saida_texto("  THEN_START"); break;
+            case CG_ELSE_START: saida_texto("  ELSE_START"); break;
+            case CG_IF_END:     saida_texto("IF_END"); break;
+
+            case CG_WHILE_START:    saida_texto("WHILE_START"); break;
+            case CG_WHILE_COND:     saida_texto("  WHILE_COND "); imprimirEndereco(atual->arg1); break;
+            case CG_BODY_START:     saida_texto("    BODY_START"); break;
+            case CG_WHILE_END:      saida_texto("WHILE_END"); break;
+            case CG_BREAK_IF_FALSE: saida_texto("  BREAK_IF_FALSE "); imprimirEndereco(atual->arg1); break;
+            case CG_DO_WHILE_START: saida_texto("DO_WHILE_START"); break;
+            case CG_DO_WHILE_END:   saida_texto("DO_WHILE_END"); break;
+            case CG_RETURN:   saida_texto("RETURN  "); imprimirEndereco(atual->arg1); break;
+            case CG_FUNC_START: saida_texto("FUNC_START "); imprimirEndereco(atual->arg1); break;
+            case CG_FUNC_END:   saida_texto("FUNC_END"); break;
+            case CG_BREAK:      saida_texto("  BREAK"); break;
+            case CG_CONTINUE:   saida_texto("  CONTINUE"); break;
             
-            default: printf("OPCODE_DESCONHECIDO (%d)", atual->op);
+            default: saida_printf("OPCODE_DESCONHECIDO (%d)", atual->op);
         }
-        printf("\n");
+        #undef PRINT_OP
+        saida_char('\n');
         atual = atual->next;
     }
-    printf("---------------------------------------------------\n");
+}
+
+// Operando em JSON: null (vazio) ou objeto de uma chave com o tipo.
+// Strings são o literal C como aparece no fonte (com aspas e escapes).
+static void imprimirEnderecoJSON(Endereco end) {
+    switch(end.tipo) {
+        case ADDR_EMPTY:     saida_texto("null"); break;
+        case ADDR_VAR:       saida_texto("{\"var\": \""); saida_json_texto(end.val.varName); saida_texto("\"}"); break;
+        case ADDR_TEMP:      saida_texto("{\"temp\": "); saida_int(end.val.tempId); saida_char('}'); break;
+        case ADDR_CONST_INT: saida_printf("{\"int\": %lld}", end.val.constInt); break;
+        case ADDR_CONST_FLT: {
+            // JSON não tem infinito nem NaN
+            char buf[64];
+            if (isfinite(end.val.constFlt)) formatarFloat(end.val.constFlt, buf, sizeof(buf));
+            else strcpy(buf, "null");
+            saida_printf("{\"float\": %s}", buf);
+            break;
+        }
+        case ADDR_CONST_STR: saida_texto("{\"str\": \""); saida_json_texto(end.val.varName); saida_texto("\"}"); break;
+        default:             saida_texto("null"); break;
+    }
+}
+
+// HLIR estruturado em JSON (--emit=json), uma quádrupla por linha:
+// {"versao": 1, "quadruplas": [{"op": ..., "res": ..., "arg1": ...,
+//  "arg2": ..., "linha": L, "coluna": C, "tipo": T}, ...], "temporarios": N}
+// ("tipo", o tipo C da quádrupla, só aparece quando há um)
+// "temporarios" vem no fim porque só é conhecido depois da última função.
+void imprimirCodigoIntermediarioJSON() {
+    for (Quadrupla* atual = code_head; atual; atual = atual->next) {
+        saida_texto(num_quadrupla++ == 0 ? "\n  {\"op\": \"" : ",\n  {\"op\": \"");
+        saida_texto(nomeOpcode(atual->op));
+        saida_texto("\", \"res\": ");   imprimirEnderecoJSON(atual->resultado);
+        saida_texto(", \"arg1\": ");      imprimirEnderecoJSON(atual->arg1);
+        saida_texto(", \"arg2\": ");      imprimirEnderecoJSON(atual->arg2);
+        saida_texto(", \"linha\": ");     saida_int(atual->linha);
+        saida_texto(", \"coluna\": ");    saida_int(atual->coluna);
+        if (atual->tipo != TIPO_NENHUM) saida_printf(", \"tipo\": \"%s\"", nomeTipoDado(atual->tipo));
+        saida_char('}');
+    }
 }
 
 void liberarCodigoIntermediario() {
@@ -317,5 +848,8 @@ void liberarCodigoIntermediario() {
     }
     code_head = NULL;
     code_tail = NULL;
+    if (temp_count > maior_temp_count) maior_temp_count = temp_count;
     temp_count = 0; // Reseta a contagem de temporários
+    linha_atual = 0;
+    coluna_atual = 0;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef CODEGEN_H
 #define CODEGEN_H
 
+#include <stddef.h>
 #include "ast.h"
 
 // --- Estruturas para Endereços (sem alteração) ---
@@ -18,8 +19,8 @@ typedef struct {
     union {
         char* varName;
         int     tempId;
-        int     constInt;
-        float   constFlt;
+        long long constInt;     // valor como o Python o vê (sem sinal: não negativo)
+        double    constFlt;
     } val;
 } Endereco;
 
@@ -62,34 +63,120 @@ typedef enum {
     CG_BREAK_IF_FALSE,
     CG_DO_WHILE_START,
     CG_DO_WHILE_END,
-    CG_RETURN
+    CG_RETURN,
+
+    // Funções
+    CG_FUNC_START,  // Início da função arg1 (nome)
+    CG_FUNC_END,    // Fim da função
+
+    // Inteiros (semântica de C)
+    CG_IDIV,        // resultado = arg1 / arg2, truncado para zero
+    CG_BIT_AND,     // resultado = arg1 & arg2
+    CG_BIT_OR,      // resultado = arg1 | arg2
+    CG_BIT_XOR,     // resultado = arg1 ^ arg2
+    CG_SHL,         // resultado = arg1 << arg2
+    CG_SHR,         // resultado = arg1 >> arg2 (aritmético)
+    CG_BIT_NOT,     // resultado = ~arg1
+
+    // Lógicos (resultado 0 ou 1)
+    CG_NOT,         // resultado = !arg1
+    CG_AND,         // resultado = arg1 && arg2
+    CG_OR,          // resultado = arg1 || arg2
+
+    // Conversões (o tipo de destino é o da quádrupla)
+    CG_CONVERT,     // resultado = (tipo) arg1: ajuste à largura do inteiro, ou float()
+    CG_F32,         // resultado = arg1 arredondado para float de 32 bits (--float32=1)
+
+    // Desvios do laço mais interno (break/continue do C). CONTINUE volta ao
+    // topo do laço: o gerador repete antes dele o incremento do for e o
+    // teste do do-while.
+    CG_BREAK,
+    CG_CONTINUE,
+
+    CG_NUM_OPCODES  // Quantidade de opcodes (não é um opcode)
 
 } OpCodeCG;
 
+// Tipo C associado a uma quádrupla: o do resultado nas operações e
+// atribuições, o do valor em PARAM/RETURN e o de retorno em FUNC_START
+typedef enum {
+    TIPO_NENHUM,
+    TIPO_INT,
+    TIPO_FLOAT,
+    TIPO_CHAR,
+    TIPO_VOID,
+    TIPO_STRING,
+    TIPO_SCHAR,
+    TIPO_UCHAR,
+    TIPO_SHORT,
+    TIPO_USHORT,
+    TIPO_UINT,
+    TIPO_LONG,      // long e long long têm 64 bits (LP64)
+    TIPO_ULONG,
+    TIPO_LLONG,
+    TIPO_ULLONG,
+    TIPO_DOUBLE     // (long double é tratado como double)
+} TipoDadoCG;
+
 typedef struct Quadrupla {
     OpCodeCG op;
+    TipoDadoCG tipo;
     Endereco arg1;
     Endereco arg2;
     Endereco resultado;
+    int linha;      // Posição do comando C que originou a quádrupla (0 = desconhecida)
+    int coluna;
     struct Quadrupla* next;
 } Quadrupla;
 
 // --- Variáveis Globais ---
 extern Quadrupla* code_head;
 extern Quadrupla* code_tail;
+extern int temp_count;      // temporários usados pela função corrente
+extern int emular_float32;  // --float32=1: aritmética float arredondada para 32 bits
 
 // --- Protótipos das Funções (Implementadas em codegen.c) ---
 Endereco criarEnderecoVazio();
 Endereco criarEnderecoVar(const char* nome);
 Endereco criarEnderecoTemp();
-Endereco criarEnderecoConstInt(int valor);
-Endereco criarEnderecoConstFlt(float valor);
+Endereco criarEnderecoConstInt(long long valor);
+Endereco criarEnderecoConstFlt(double valor);
 Endereco criarEnderecoString(const char* str);
 void     liberarEndereco(Endereco* end);
+Endereco duplicarEndereco(Endereco end);
+void     imprimirEndereco(Endereco end);
 
 void emitir(OpCodeCG op, Endereco arg1, Endereco arg2, Endereco resultado);
 Endereco gerarCodigo(NoAST* no);
-void imprimirCodigoIntermediario();
+const char* nomeOpcode(OpCodeCG op);
+// Operações sem efeito colateral da forma resultado = f(arg1, arg2),
+// incluindo ASSIGN (o que os passos de otimização podem mover ou apagar)
+int opcodeDeValor(OpCodeCG op);
+TipoDadoCG  tipoDadoDeNome(const char* nome);   // "int", "unsigned long"... (tipoDado da AST)
+const char* nomeTipoDado(TipoDadoCG tipo);
+
+// Tipos escalares do C (LP64, char com sinal)
+int tipoInteiro(TipoDadoCG tipo);
+int tipoFlutuante(TipoDadoCG tipo);
+int tipoAritmetico(TipoDadoCG tipo);
+int tipoSemSinal(TipoDadoCG tipo);
+int bitsTipo(TipoDadoCG tipo);
+TipoDadoCG tipoPromovido(TipoDadoCG tipo);              // promoção inteira
+TipoDadoCG tipoComum(TipoDadoCG a, TipoDadoCG b);       // conversões aritméticas usuais
+int cabeEm(TipoDadoCG de, TipoDadoCG para);             // todo valor de `de` é valor de `para`
+// `valor` convertido para o inteiro `tipo` (módulo 2^bits); 0 se o resultado
+// não couber em long long (unsigned de 64 bits acima de LLONG_MAX)
+int ajustarInteiro(long long valor, TipoDadoCG tipo, long long* resultado);
+// Literal float do Python que reproduz `valor` exatamente (repr mais curto)
+void formatarFloat(double valor, char* buf, size_t tam);
 void liberarCodigoIntermediario();
 
+// A listagem é escrita em partes, para que cada função possa ser impressa
+// e liberada assim que é traduzida: cabeçalho, as quádruplas correntes
+// (uma vez por função, com numeração contínua) e rodapé.
+void imprimirCabecalhoHLIR(int json);
+void imprimirCodigoIntermediario();
+void imprimirCodigoIntermediarioJSON();
+void imprimirRodapeHLIR(int json);
+
 #endif // CODEGEN_H
\ No newline at end of file
@@ -0,0 +1,376 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "codegen.h"
+#include "desenrolar.h"
+
+// Sequência de quádruplas sendo montada (a lista ligada é refeita no fim)
+typedef struct {
+    Quadrupla** q;
+    int n, cap;
+} Lista;
+
+// Um laço contado reconhecido por analisar()
+typedef struct {
+    int         do_while;
+    int         corpo_ini, corpo_fim;   // corpo em [ini, fim) da Lista do laço
+    Quadrupla*  cond;                   // comparação que decide a saída
+    const char* var;                    // variável de controle
+    OpCodeCG    rel;                    // normalizada: var rel limite
+    Endereco    limite;                 // constante int ou variável
+    int         passo;
+} Laco;
+
+static int fator_atual = 0;
+static int crescimento = 0;     // quádruplas acrescentadas na função corrente
+static int n_desenrolados = 0;
+
+static void anexar(Lista* l, Quadrupla* q) {
+    if (l->n == l->cap) {
+        l->cap = l->cap ? l->cap * 2 : 64;
+        l->q = realloc(l->q, sizeof(Quadrupla*) * l->cap);
+        if (!l->q) {
+            fprintf(stderr, "Erro: Falha ao alocar memória para o desenrolamento de laços\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    l->q[l->n++] = q;
+}
+
+static Quadrupla* nova(OpCodeCG op, Endereco arg1, Endereco arg2, Endereco resultado, const Quadrupla* origem) {
+    Quadrupla* q = malloc(sizeof(Quadrupla));
+    q->op = op;
+    q->tipo = TIPO_NENHUM;
+    q->arg1 = arg1;
+    q->arg2 = arg2;
+    q->resultado = resultado;
+    q->linha = origem->linha;
+    q->coluna = origem->coluna;
+    q->next = NULL;
+    return q;
+}
+
+static Quadrupla* copiar(const Quadrupla* q) {
+    Quadrupla* c = nova(q->op, duplicarEndereco(q->arg1), duplicarEndereco(q->arg2),
+                        duplicarEndereco(q->resultado), q);
+    c->tipo = q->tipo;
+    return c;
+}
+
+static void liberarQuadrupla(Quadrupla* q) {
+    liberarEndereco(&q->arg1);
+    liberarEndereco(&q->arg2);
+    liberarEndereco(&q->resultado);
+    free(q);
+}
+
+static int abre(OpCodeCG op)  { return op == CG_IF_START || op == CG_WHILE_START || op == CG_DO_WHILE_START; }
+static int fecha(OpCodeCG op) { return op == CG_IF_END || op == CG_WHILE_END || op == CG_DO_WHILE_END; }
+
+static int relacional(OpCodeCG op) { return op >= CG_LT && op <= CG_NEQ; }
+
+// Comandos em linha reta (não abrem, fecham nem desviam um bloco)
+static int simples(OpCodeCG op) {
+    return opcodeDeValor(op) || op == CG_PARAM || op == CG_CALL;
+}
+
+static int ehVar(const Endereco* e, const char* nome) {
+    return e->tipo == ADDR_VAR && strcmp(e->val.varName, nome) == 0;
+}
+
+// a rel b  <=>  b espelho(rel) a
+static OpCodeCG espelho(OpCodeCG op) {
+    switch (op) {
+        case CG_LT:  return CG_GT;
+        case CG_GT:  return CG_LT;
+        case CG_LTE: return CG_GTE;
+        case CG_GTE: return CG_LTE;
+        default:     return op;
+    }
+}
+
+static int comparar(OpCodeCG op, long long a, long long b) {
+    switch (op) {
+        case CG_LT:  return a < b;
+        case CG_GT:  return a > b;
+        case CG_LTE: return a <= b;
+        case CG_GTE: return a >= b;
+        case CG_EQ:  return a == b;
+        default:     return a != b;
+    }
+}
+
+// Índice do fechamento da estrutura aberta em v[i]
+static int fimDaEstrutura(Quadrupla** v, int i, int fim) {
+    int nivel = 0;
+    for (; i < fim; i++) {
+        if (abre(v[i]->op)) nivel++;
+        else if (fecha(v[i]->op) && --nivel == 0) return i;
+    }
+    return fim - 1;
+}
+
+// `var ± c` com int; preenche o passo
+static int passoDe(const Quadrupla* q, const char* var, int* passo) {
+    if (q->op == CG_ADD && ehVar(&q->arg1, var) && q->arg2.tipo == ADDR_CONST_INT) {
+        *passo = q->arg2.val.constInt;
+    } else if (q->op == CG_ADD && ehVar(&q->arg2, var) && q->arg1.tipo == ADDR_CONST_INT) {
+        *passo = q->arg1.val.constInt;
+    } else if (q->op == CG_SUB && ehVar(&q->arg1, var) && q->arg2.tipo == ADDR_CONST_INT &&
+               q->arg2.val.constInt != INT_MIN) {
+        *passo = -q->arg2.val.constInt;
+    } else {
+        return 0;
+    }
+    return *passo != 0;
+}
+
+// Confere se `var` é a variável de controle: escrita uma única vez no
+// corpo, no nível de fora, por `var = var ± c` com int (direto, depois da
+// simplificação, ou por um temporário). Preenche o passo.
+static int acharIncremento(const Lista* l, Laco* a) {
+    Quadrupla* incremento = NULL;
+    int nivel = 0, escritas = 0;
+
+    for (int k = a->corpo_ini; k < a->corpo_fim; k++) {
+        Quadrupla* q = l->q[k];
+        if (abre(q->op)) nivel++;
+        else if (fecha(q->op)) nivel--;
+        if (!ehVar(&q->resultado, a->var)) continue;
+        escritas++;
+        if (nivel == 0 && q->tipo == TIPO_INT &&
+            ((q->op == CG_ASSIGN && q->arg1.tipo == ADDR_TEMP) || q->op == CG_ADD || q->op == CG_SUB)) incremento = q;
+    }
+    if (escritas != 1 || !incremento) return 0;
+    if (incremento->op != CG_ASSIGN) return passoDe(incremento, a->var, &a->passo);
+
+    // A quádrupla que calcula o temporário atribuído
+    for (int k = a->corpo_ini; k < a->corpo_fim && l->q[k] != incremento; k++) {
+        Quadrupla* q = l->q[k];
+        if (q->resultado.tipo != ADDR_TEMP || q->resultado.val.tempId != incremento->arg1.val.tempId) continue;
+        return passoDe(q, a->var, &a->passo);
+    }
+    return 0;
+}
+
+// O limite variável não pode ser escrito dentro do laço
+static int invariante(const Lista* l, const Laco* a) {
+    if (a->limite.tipo != ADDR_VAR) return 1;
+    if (strcmp(a->limite.val.varName, a->var) == 0) return 0;
+    for (int k = a->corpo_ini; k < a->corpo_fim; k++) {
+        if (ehVar(&l->q[k]->resultado, a->limite.val.varName)) return 0;
+    }
+    return 1;
+}
+
+// break/continue do próprio laço (fora dos laços de dentro) no corpo
+static int desvia(const Lista* l, const Laco* a) {
+    int lacos = 0;
+    for (int k = a->corpo_ini; k < a->corpo_fim; k++) {
+        OpCodeCG op = l->q[k]->op;
+        if (op == CG_WHILE_START || op == CG_DO_WHILE_START) lacos++;
+        else if (op == CG_WHILE_END || op == CG_DO_WHILE_END) lacos--;
+        else if ((op == CG_BREAK || op == CG_CONTINUE) && lacos == 0) return 1;
+    }
+    return 0;
+}
+
+// Reconhece um laço contado na Lista (de WHILE_START/DO_WHILE_START até o fechamento)
+static int analisar(const Lista* l, Laco* a) {
+    Quadrupla* quebra;
+    memset(a, 0, sizeof(*a));
+    if (l->n < 5 || l->q[1]->op != CG_BODY_START) return 0;
+
+    a->do_while = l->q[0]->op == CG_DO_WHILE_START;
+    if (a->do_while) {
+        // DO_WHILE_START BODY_START corpo cond BREAK_IF_FALSE DO_WHILE_END
+        a->cond = l->q[l->n - 3];
+        quebra = l->q[l->n - 2];
+        a->corpo_ini = 2;
+        a->corpo_fim = l->n - 3;
+    } else {
+        // WHILE_START BODY_START cond BREAK_IF_FALSE corpo WHILE_END
+        a->cond = l->q[2];
+        quebra = l->q[3];
+        a->corpo_ini = 4;
+        a->corpo_fim = l->n - 1;
+    }
+    if (quebra->op != CG_BREAK_IF_FALSE || !relacional(a->cond->op) ||
+        a->cond->resultado.tipo != ADDR_TEMP || quebra->arg1.tipo != ADDR_TEMP ||
+        a->cond->resultado.val.tempId != quebra->arg1.val.tempId || desvia(l, a)) {
+        return 0;
+    }
+
+    // var rel limite, com a variável de qualquer um dos lados
+    const Endereco* lados[2] = { &a->cond->arg1, &a->cond->arg2 };
+    for (int lado = 0; lado < 2; lado++) {
+        const Endereco* outro = lados[1 - lado];
+        if (lados[lado]->tipo != ADDR_VAR) continue;
+        if (outro->tipo != ADDR_VAR && outro->tipo != ADDR_CONST_INT) continue;
+        a->var = lados[lado]->val.varName;
+        a->limite = *outro;
+        a->rel = lado == 0 ? a->cond->op : espelho(a->cond->op);
+        if (acharIncremento(l, a) && invariante(l, a)) return 1;
+    }
+    return 0;
+}
+
+// Valor inicial de `var`, se a última atribuição antes do laço (em linha
+// reta, no mesmo bloco) for uma constante
+static int valorInicial(const Lista* antes, const char* var, int* valor) {
+    for (int k = antes->n - 1; k >= 0; k--) {
+        Quadrupla* q = antes->q[k];
+        if (!simples(q->op)) return 0;
+        if (ehVar(&q->resultado, var)) {
+            if (q->op != CG_ASSIGN || q->arg1.tipo != ADDR_CONST_INT) return 0;
+            *valor = q->arg1.val.constInt;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Número de iterações, ou -1 se passar de DESENROLAR_MAX_VIAGENS
+static int contarViagens(const Laco* a, int inicial) {
+    long long v = inicial, limite = a->limite.val.constInt;
+    int viagens = 0;
+    if (a->do_while) {
+        viagens = 1;
+        v += a->passo;
+    }
+    while (comparar(a->rel, v, limite)) {
+        if (++viagens > DESENROLAR_MAX_VIAGENS) return -1;
+        v += a->passo;
+        if (v < INT_MIN || v > INT_MAX) return -1;
+    }
+    return viagens > DESENROLAR_MAX_VIAGENS ? -1 : viagens;
+}
+
+// Cópias do corpo; a primeira reaproveita as quádruplas originais
+static void copiarCorpo(const Lista* l, const Laco* a, int vezes, Lista* saida) {
+    for (int r = vezes - 1; r >= 0; r--) {
+        for (int k = a->corpo_ini; k < a->corpo_fim; k++) {
+            anexar(saida, r == 0 ? l->q[k] : copiar(l->q[k]));
+        }
+    }
+}
+
+// Troca o laço por `viagens` cópias do corpo
+static void desenrolarCompleto(Lista* l, const Laco* a, int viagens, Lista* saida) {
+    if (viagens > 0) {
+        copiarCorpo(l, a, viagens, saida);
+    } else {
+        for (int k = a->corpo_ini; k < a->corpo_fim; k++) liberarQuadrupla(l->q[k]);
+    }
+    for (int k = 0; k < l->n; k++) {
+        if (k < a->corpo_ini || k >= a->corpo_fim) liberarQuadrupla(l->q[k]);
+    }
+}
+
+// while (var + (fator-1)*passo rel limite) { corpo x fator }  seguido do laço original
+static void desenrolarParcial(Lista* l, const Laco* a, int fator, Lista* saida) {
+    Endereco soma = criarEnderecoTemp(), teste = criarEnderecoTemp();
+    Quadrupla* q;
+
+    anexar(saida, copiar(l->q[0]));
+    anexar(saida, copiar(l->q[1]));
+    q = nova(CG_ADD, criarEnderecoVar(a->var), criarEnderecoConstInt((fator - 1) * a->passo), soma, a->cond);
+    q->tipo = TIPO_INT;
+    anexar(saida, q);
+    q = nova(a->rel, soma, duplicarEndereco(a->limite), teste, a->cond);
+    q->tipo = TIPO_INT;
+    anexar(saida, q);
+    anexar(saida, nova(CG_BREAK_IF_FALSE, teste, criarEnderecoVazio(), criarEnderecoVazio(), a->cond));
+    for (int r = 0; r < fator; r++) {
+        for (int k = a->corpo_ini; k < a->corpo_fim; k++) anexar(saida, copiar(l->q[k]));
+    }
+    anexar(saida, copiar(l->q[l->n - 1]));
+
+    for (int k = 0; k < l->n; k++) anexar(saida, l->q[k]);
+}
+
+// Tenta desenrolar o laço `l`; as quádruplas vão para `saida` em qualquer caso
+static void desenrolar(Lista* l, Lista* saida) {
+    Laco a;
+    int tam, inicial;
+
+    if (analisar(l, &a)) {
+        tam = a.corpo_fim - a.corpo_ini;
+
+        int viagens = -1;
+        if (a.limite.tipo == ADDR_CONST_INT && valorInicial(saida, a.var, &inicial)) {
+            viagens = contarViagens(&a, inicial);
+        }
+        if (viagens >= 0 && viagens * tam <= DESENROLAR_ORCAMENTO_LACO &&
+            crescimento + viagens * tam - l->n <= DESENROLAR_ORCAMENTO_FUNCAO) {
+            crescimento += viagens * tam - l->n;
+            n_desenrolados++;
+            desenrolarCompleto(l, &a, viagens, saida);
+            return;
+        }
+
+        // Com fator f, cada volta só roda se as f iterações couberem, o que
+        // exige `var` andando na direção do limite
+        int direcao = (a.rel == CG_LT || a.rel == CG_LTE) ? 1 : (a.rel == CG_GT || a.rel == CG_GTE) ? -1 : 0;
+        int acrescimo = fator_atual * tam + 6;
+        long long deslocamento = (long long)(fator_atual - 1) * a.passo;
+        if (!a.do_while && fator_atual >= 2 && direcao != 0 && (a.passo > 0) == (direcao > 0) &&
+            deslocamento >= INT_MIN && deslocamento <= INT_MAX &&
+            fator_atual * tam <= DESENROLAR_ORCAMENTO_LACO &&
+            crescimento + acrescimo <= DESENROLAR_ORCAMENTO_FUNCAO) {
+            crescimento += acrescimo;
+            n_desenrolados++;
+            desenrolarParcial(l, &a, fator_atual, saida);
+            return;
+        }
+    }
+    for (int k = 0; k < l->n; k++) anexar(saida, l->q[k]);
+}
+
+// Copia v[ini, fim) para `saida`, desenrolando os laços de dentro para fora
+static void processar(Quadrupla** v, int ini, int fim, Lista* saida) {
+    for (int i = ini; i < fim; i++) {
+        if (v[i]->op != CG_WHILE_START && v[i]->op != CG_DO_WHILE_START) {
+            anexar(saida, v[i]);
+            continue;
+        }
+        int j = fimDaEstrutura(v, i, fim);
+        Lista laco = { NULL, 0, 0 };
+        anexar(&laco, v[i]);
+        processar(v, i + 1, j, &laco);
+        anexar(&laco, v[j]);
+        desenrolar(&laco, saida);
+        free(laco.q);
+        i = j;
+    }
+}
+
+int desenrolarLacos(int fator) {
+    if (fator < 1) return 0;
+
+    Lista original = { NULL, 0, 0 }, saida = { NULL, 0, 0 };
+    int tem_laco = 0;
+    for (Quadrupla* q = code_head; q; q = q->next) {
+        anexar(&original, q);
+        if (q->op == CG_WHILE_START || q->op == CG_DO_WHILE_START) tem_laco = 1;
+    }
+    if (!tem_laco) {
+        free(original.q);
+        return 0;
+    }
+
+    fator_atual = fator;
+    crescimento = 0;
+    n_desenrolados = 0;
+    processar(original.q, 0, original.n, &saida);
+
+    // Refaz a lista ligada
+    code_head = saida.n ? saida.q[0] : NULL;
+    for (int k = 0; k < saida.n; k++) saida.q[k]->next = k + 1 < saida.n ? saida.q[k + 1] : NULL;
+    code_tail = saida.n ? saida.q[saida.n - 1] : NULL;
+
+    free(original.q);
+    free(saida.q);
+    return n_desenrolados;
+}
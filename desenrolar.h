@@ -0,0 +1,32 @@
+#ifndef DESENROLAR_H
+#define DESENROLAR_H
+
+// --- Desenrolamento de laços ---
+// Passo sobre as quádruplas da função corrente (code_head), aplicado entre
+// gerarCodigo() e a emissão. No Python gerado, cada iteração de um laço paga
+// o `while True:`, o `if not cond: break` e o salto de volta; em laços
+// internos curtos esse custo fixo domina.
+//
+// Um laço é "contado" quando a condição é uma única comparação de uma
+// variável int `i` com uma constante ou variável não escrita no laço, e o
+// corpo altera `i` uma única vez, no nível de fora, com `i = i ± c`.
+//  - Se o valor inicial de `i` também é constante e o número de iterações
+//    é no máximo DESENROLAR_MAX_VIAGENS, o laço (while, for ou do-while) é
+//    trocado por cópias do corpo, sem teste nenhum.
+//  - Senão, um while/for com `<`, `<=`, `>` ou `>=` vira um laço que executa
+//    `fator` cópias do corpo por volta (enquanto couberem `fator` iterações)
+//    seguido do laço original, que faz as que sobrarem.
+// Laços internos são tratados antes dos externos. Cada laço pode gerar no
+// máximo DESENROLAR_ORCAMENTO_LACO quádruplas e a função inteira crescer no
+// máximo DESENROLAR_ORCAMENTO_FUNCAO; o que passar disso fica como está.
+
+#define DESENROLAR_FATOR_PADRAO      4
+#define DESENROLAR_MAX_VIAGENS       16
+#define DESENROLAR_ORCAMENTO_LACO    256
+#define DESENROLAR_ORCAMENTO_FUNCAO  2048
+
+// fator < 1 desliga o passo; fator 1 mantém só o desenrolamento completo.
+// Retorna o número de laços desenrolados.
+int desenrolarLacos(int fator);
+
+#endif
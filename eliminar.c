@@ -0,0 +1,562 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "codegen.h"
+#include "eliminar.h"
+
+// Quádruplas da função (NULL = removida)
+typedef struct {
+    Quadrupla** q;
+    int n, cap;
+} Lista;
+
+// Variáveis da função, por nome, com o índice no conjunto de vivas
+typedef struct {
+    char* nome;
+    int   indice;
+} Variavel;
+
+static Lista lista;
+static int n_alteracoes = 0;
+
+// Estrutura de cada abertura/fechamento (índices na lista)
+static int* par = NULL;         // abertura <-> fechamento
+static int* senao = NULL;       // ELSE_START de cada IF_START (-1: sem else)
+
+static Variavel* vars = NULL;
+static size_t cap_vars = 0, n_vars = 0;
+static int* indice_temp = NULL; // temporários escritos mais de uma vez: índice no conjunto (-1: nenhum)
+static int* usos = NULL;        // leituras de cada temporário
+static int cap_temps = 0;
+
+// Conjuntos de vivas: um bit por variável e por temporário de várias escritas
+static int n_palavras = 0;
+static uint64_t** cabeca = NULL;    // vivas no topo de cada laço (ponto fixo)
+static uint64_t* saida_laco[64];    // vivas depois do laço corrente, por nível
+static uint64_t* topo_laco[64];     // vivas no topo do laço corrente (continue)
+static int n_lacos = 0;
+
+static int* laco_sai = NULL;        // o laço corrente tem saída alcançável?
+
+static void* alocar(void* v, size_t tam) {
+    v = realloc(v, tam);
+    if (!v && tam) {
+        fprintf(stderr, "Erro: Falha ao alocar memória para a eliminação de código morto\n");
+        exit(EXIT_FAILURE);
+    }
+    return v;
+}
+
+static void anexar(Lista* l, Quadrupla* q) {
+    if (l->n == l->cap) {
+        l->cap = l->cap ? l->cap * 2 : 64;
+        l->q = alocar(l->q, sizeof(Quadrupla*) * l->cap);
+    }
+    l->q[l->n++] = q;
+}
+
+static void liberarQuadrupla(Quadrupla* q) {
+    liberarEndereco(&q->arg1);
+    liberarEndereco(&q->arg2);
+    liberarEndereco(&q->resultado);
+    free(q);
+}
+
+static int leOperandos(OpCodeCG op) { return op != CG_CALL && op != CG_FUNC_START; }
+static int abre(OpCodeCG op)  { return op == CG_IF_START || op == CG_WHILE_START || op == CG_DO_WHILE_START; }
+static int fecha(OpCodeCG op) { return op == CG_IF_END || op == CG_WHILE_END || op == CG_DO_WHILE_END; }
+
+static int constante(const Endereco* e) { return e->tipo == ADDR_CONST_INT || e->tipo == ADDR_CONST_FLT; }
+static int verdadeira(const Endereco* e) {
+    return e->tipo == ADDR_CONST_INT ? e->val.constInt != 0 : e->val.constFlt != 0.0f;
+}
+
+// Pares abertura/fechamento e o ELSE de cada IF
+static void indexar(void) {
+    par = alocar(par, sizeof(int) * (lista.n + 1));
+    senao = alocar(senao, sizeof(int) * (lista.n + 1));
+    int* pilha = alocar(NULL, sizeof(int) * (lista.n + 1));
+    int topo = 0;
+    for (int k = 0; k < lista.n; k++) {
+        Quadrupla* q = lista.q[k];
+        par[k] = senao[k] = -1;
+        if (!q) continue;
+        if (abre(q->op)) {
+            pilha[topo++] = k;
+        } else if (q->op == CG_ELSE_START && topo > 0) {
+            senao[pilha[topo - 1]] = k;
+        } else if (fecha(q->op) && topo > 0) {
+            int s = pilha[--topo];
+            par[s] = k;
+            par[k] = s;
+        }
+    }
+    free(pilha);
+}
+
+static void descartar(int ini, int fim) {
+    for (int k = ini; k < fim; k++) {
+        if (!lista.q[k]) continue;
+        liberarQuadrupla(lista.q[k]);
+        lista.q[k] = NULL;
+        n_alteracoes++;
+    }
+}
+
+static void remover(int k) {
+    if (!lista.q[k]) return;
+    liberarQuadrupla(lista.q[k]);
+    lista.q[k] = NULL;
+    n_alteracoes++;
+}
+
+// --- Alcançabilidade e braços vazios ---
+
+static int alcancavel(int ini, int fim, Lista* saida);
+
+// if em lista.q[s]; retorna o índice do IF_END
+static int condicional(int s, Lista* saida, int* continua) {
+    int e = par[s], m = senao[s];
+    int fim_entao = m >= 0 ? m : e;
+    Quadrupla* q = lista.q[s];
+
+    if (constante(&q->arg1)) {
+        int entao = verdadeira(&q->arg1);
+        if (entao) {
+            if (m >= 0) descartar(m, e);
+            *continua = alcancavel(s + 2, fim_entao, saida);
+        } else {
+            descartar(s + 2, fim_entao);
+            *continua = m >= 0 ? alcancavel(m + 1, e, saida) : 1;
+            remover(m >= 0 ? m : e);
+        }
+        remover(s);
+        remover(s + 1);
+        remover(e);
+        return e;
+    }
+
+    Lista braco_entao = { NULL, 0, 0 }, braco_senao = { NULL, 0, 0 };
+    int ce = alcancavel(s + 2, fim_entao, &braco_entao);
+    int cs = m >= 0 ? alcancavel(m + 1, e, &braco_senao) : 1;
+    *continua = ce || cs;
+
+    if (braco_entao.n == 0 && braco_senao.n == 0) {
+        remover(s);
+        remover(s + 1);
+        if (m >= 0) remover(m);
+        remover(e);
+    } else {
+        if (braco_entao.n == 0) {
+            // if (c) {} else {...}  =>  if (!c) {...}
+            Quadrupla* nao = malloc(sizeof(Quadrupla));
+            if (!nao) alocar(NULL, 1);
+            *nao = *q;
+            nao->op = CG_NOT;
+            nao->tipo = TIPO_INT;
+            nao->arg2 = criarEnderecoVazio();
+            nao->resultado = criarEnderecoTemp();
+            nao->next = NULL;
+            q->arg1 = duplicarEndereco(nao->resultado);
+            anexar(saida, nao);
+            braco_entao = braco_senao;
+            braco_senao.q = NULL;
+            braco_senao.n = 0;
+            n_alteracoes++;
+        }
+        anexar(saida, q);
+        anexar(saida, lista.q[s + 1]);
+        for (int k = 0; k < braco_entao.n; k++) anexar(saida, braco_entao.q[k]);
+        if (braco_senao.n > 0) {
+            anexar(saida, lista.q[m]);
+            for (int k = 0; k < braco_senao.n; k++) anexar(saida, braco_senao.q[k]);
+        } else if (m >= 0) {
+            remover(m);
+        }
+        anexar(saida, lista.q[e]);
+    }
+    free(braco_entao.q);
+    free(braco_senao.q);
+    return e;
+}
+
+// Quádruplas só de cálculo em temporários (sem efeito fora do laço)
+static int soTemporarios(const Lista* l, int fim) {
+    for (int k = 0; k < fim; k++) {
+        if (!opcodeDeValor(l->q[k]->op) || l->q[k]->resultado.tipo != ADDR_TEMP) return 0;
+    }
+    return 1;
+}
+
+// Laço em lista.q[s]; retorna o índice do fechamento
+static int repeticao(int s, Lista* saida, int* continua) {
+    int e = par[s];
+    int sai = 0;
+    int* anterior = laco_sai;
+    Lista corpo = { NULL, 0, 0 };
+
+    laco_sai = &sai;
+    alcancavel(s + 2, e, &corpo);
+    laco_sai = anterior;
+
+    // Sem nenhuma saída, o que vem depois do laço é inalcançável
+    *continua = sai;
+
+    // while (0): o teste sai na primeira volta e o laço não faz nada
+    int teste = 0;
+    while (teste < corpo.n && corpo.q[teste]->op != CG_BREAK_IF_FALSE) teste++;
+    if (lista.q[s]->op == CG_WHILE_START && teste < corpo.n && constante(&corpo.q[teste]->arg1) &&
+        !verdadeira(&corpo.q[teste]->arg1) && soTemporarios(&corpo, teste)) {
+        for (int k = 0; k < corpo.n; k++) {
+            liberarQuadrupla(corpo.q[k]);
+            n_alteracoes++;
+        }
+        remover(s);
+        remover(s + 1);
+        remover(e);
+        *continua = 1;
+    } else {
+        anexar(saida, lista.q[s]);
+        anexar(saida, lista.q[s + 1]);
+        for (int k = 0; k < corpo.n; k++) anexar(saida, corpo.q[k]);
+        anexar(saida, lista.q[e]);
+    }
+    free(corpo.q);
+    return e;
+}
+
+// Copia para `saida` o que é alcançável no bloco [ini, fim), libertando o
+// resto. Retorna 1 se o fim do bloco é alcançável.
+static int alcancavel(int ini, int fim, Lista* saida) {
+    for (int k = ini; k < fim; k++) {
+        Quadrupla* q = lista.q[k];
+        if (!q) continue;
+        int continua = 1;
+        switch (q->op) {
+            case CG_RETURN:
+                anexar(saida, q);
+                continua = 0;
+                break;
+            case CG_BREAK_IF_FALSE:
+                if (constante(&q->arg1) && verdadeira(&q->arg1)) {
+                    remover(k);     // nunca dispara
+                    break;
+                }
+                anexar(saida, q);
+                if (laco_sai) *laco_sai = 1;
+                if (constante(&q->arg1)) continua = 0;
+                break;
+            case CG_BREAK:
+                anexar(saida, q);
+                if (laco_sai) *laco_sai = 1;
+                continua = 0;
+                break;
+            case CG_CONTINUE:
+                anexar(saida, q);
+                continua = 0;
+                break;
+            case CG_IF_START:
+                k = condicional(k, saida, &continua);
+                break;
+            case CG_WHILE_START:
+            case CG_DO_WHILE_START:
+                k = repeticao(k, saida, &continua);
+                break;
+            default:
+                anexar(saida, q);
+                break;
+        }
+        if (!continua) {
+            descartar(k + 1, fim);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void podarInalcancavel(void) {
+    Lista saida = { NULL, 0, 0 };
+    int fim = lista.n;
+    indexar();
+    laco_sai = NULL;
+
+    // FUNC_START corpo FUNC_END
+    int ini = 0;
+    while (ini < fim && lista.q[ini] && lista.q[ini]->op != CG_FUNC_START) anexar(&saida, lista.q[ini++]);
+    if (ini < fim) anexar(&saida, lista.q[ini++]);
+    if (fim > ini && lista.q[fim - 1] && lista.q[fim - 1]->op == CG_FUNC_END) fim--;
+    alcancavel(ini, fim, &saida);
+    for (int k = fim; k < lista.n; k++) anexar(&saida, lista.q[k]);
+
+    free(lista.q);
+    lista = saida;
+}
+
+// --- Vivacidade e escritas mortas ---
+
+static uint32_t hashNome(const char* s) {
+    uint32_t h = 2166136261u;   // FNV-1a
+    for (; *s; s++) h = (h ^ (unsigned char)*s) * 16777619u;
+    return h;
+}
+
+static Variavel* buscarVar(const char* nome) {
+    if ((n_vars + 1) * 2 > cap_vars) {
+        Variavel* antigas = vars;
+        size_t cap_antiga = cap_vars;
+        cap_vars = cap_vars ? cap_vars * 2 : 64;
+        vars = calloc(cap_vars, sizeof(Variavel));
+        if (!vars) alocar(NULL, 1);
+        for (size_t i = 0; i < cap_antiga; i++) {
+            if (!antigas[i].nome) continue;
+            size_t j = hashNome(antigas[i].nome) & (cap_vars - 1);
+            while (vars[j].nome) j = (j + 1) & (cap_vars - 1);
+            vars[j] = antigas[i];
+        }
+        free(antigas);
+    }
+    size_t i = hashNome(nome) & (cap_vars - 1);
+    while (vars[i].nome && strcmp(vars[i].nome, nome) != 0) i = (i + 1) & (cap_vars - 1);
+    if (!vars[i].nome) {
+        vars[i].nome = strdup(nome);
+        vars[i].indice = (int)n_vars++;
+    }
+    return &vars[i];
+}
+
+static void liberarVars(void) {
+    for (size_t i = 0; i < cap_vars; i++) free(vars[i].nome);
+    free(vars);
+    vars = NULL;
+    cap_vars = n_vars = 0;
+}
+
+// Índice no conjunto de vivas (-1: temporário de uma escrita, contado por usos)
+static int indice(const Endereco* e) {
+    if (e->tipo == ADDR_VAR) return buscarVar(e->val.varName)->indice;
+    if (e->tipo == ADDR_TEMP && e->val.tempId < cap_temps) return indice_temp[e->val.tempId];
+    return -1;
+}
+
+static void contarLeitura(const Endereco* e, int delta) {
+    if (e->tipo == ADDR_TEMP && e->val.tempId < cap_temps) usos[e->val.tempId] += delta;
+}
+
+// Índices das variáveis e dos temporários de várias escritas; usos dos demais
+static void numerar(void) {
+    liberarVars();
+    cap_temps = temp_count + 1;
+    int* defs = calloc(cap_temps, sizeof(int));
+    indice_temp = alocar(indice_temp, sizeof(int) * cap_temps);
+    usos = alocar(usos, sizeof(int) * cap_temps);
+    if (!defs) alocar(NULL, 1);
+    memset(usos, 0, sizeof(int) * cap_temps);
+
+    for (int k = 0; k < lista.n; k++) {
+        Quadrupla* q = lista.q[k];
+        if (!q) continue;
+        if (leOperandos(q->op)) {
+            contarLeitura(&q->arg1, 1);
+            contarLeitura(&q->arg2, 1);
+            if (q->arg1.tipo == ADDR_VAR) buscarVar(q->arg1.val.varName);
+            if (q->arg2.tipo == ADDR_VAR) buscarVar(q->arg2.val.varName);
+        }
+        if (q->resultado.tipo == ADDR_TEMP && q->resultado.val.tempId < cap_temps) defs[q->resultado.val.tempId]++;
+        if (q->resultado.tipo == ADDR_VAR) buscarVar(q->resultado.val.varName);
+    }
+    int n = (int)n_vars;
+    for (int t = 0; t < cap_temps; t++) indice_temp[t] = defs[t] > 1 ? n++ : -1;
+    free(defs);
+    n_palavras = (n + 63) / 64;
+    if (n_palavras == 0) n_palavras = 1;
+}
+
+static uint64_t* novoConjunto(const uint64_t* origem) {
+    uint64_t* c = alocar(NULL, sizeof(uint64_t) * n_palavras);
+    if (origem) memcpy(c, origem, sizeof(uint64_t) * n_palavras);
+    else memset(c, 0, sizeof(uint64_t) * n_palavras);
+    return c;
+}
+
+static void unir(uint64_t* a, const uint64_t* b) {
+    for (int i = 0; i < n_palavras; i++) a[i] |= b[i];
+}
+
+static int contido(const uint64_t* a, const uint64_t* b) {
+    for (int i = 0; i < n_palavras; i++) if (a[i] & ~b[i]) return 0;
+    return 1;
+}
+
+static void ler(uint64_t* vivas, const Endereco* e) {
+    int i = indice(e);
+    if (i >= 0) vivas[i / 64] |= 1ULL << (i % 64);
+}
+
+static void escrever(uint64_t* vivas, const Endereco* e) {
+    int i = indice(e);
+    if (i >= 0) vivas[i / 64] &= ~(1ULL << (i % 64));
+}
+
+static int morta(const uint64_t* vivas, const Endereco* e) {
+    if (e->tipo != ADDR_VAR && e->tipo != ADDR_TEMP) return 0;
+    int i = indice(e);
+    if (i >= 0) return !(vivas[i / 64] & (1ULL << (i % 64)));
+    return e->tipo == ADDR_TEMP && e->val.tempId < cap_temps && usos[e->val.tempId] == 0;
+}
+
+static void vivasBloco(int ini, int fim, uint64_t* vivas, int podar);
+
+static void vivasCondicional(int s, int e, uint64_t* vivas, int podar) {
+    int m = senao[s];
+    uint64_t* depois = novoConjunto(vivas);
+    vivasBloco(s + 2, m >= 0 ? m : e, vivas, podar);
+    if (m >= 0) {
+        uint64_t* braco = novoConjunto(depois);
+        vivasBloco(m + 1, e, braco, podar);
+        unir(vivas, braco);
+        free(braco);
+    } else {
+        unir(vivas, depois);
+    }
+    ler(vivas, &lista.q[s]->arg1);
+    free(depois);
+}
+
+// Vivas no topo do laço: menor ponto fixo de topo = corpo(topo), partindo
+// do que já se sabia (os laços de dentro são revisitados a cada volta do de fora)
+static void vivasLaco(int s, int e, uint64_t* vivas, int podar) {
+    if (n_lacos == (int)(sizeof(saida_laco) / sizeof(saida_laco[0]))) {
+        // Aninhamento fundo demais: tudo vivo, nada removido lá dentro
+        memset(vivas, 0xff, sizeof(uint64_t) * n_palavras);
+        return;
+    }
+    if (!cabeca[s]) cabeca[s] = novoConjunto(NULL);
+    uint64_t* topo = cabeca[s];
+    topo_laco[n_lacos] = topo;
+    saida_laco[n_lacos++] = novoConjunto(vivas);
+
+    for (;;) {
+        uint64_t* volta = novoConjunto(topo);
+        vivasBloco(s + 2, e, volta, 0);
+        int estavel = contido(volta, topo);
+        unir(topo, volta);
+        free(volta);
+        if (estavel) break;
+    }
+    memcpy(vivas, topo, sizeof(uint64_t) * n_palavras);
+    vivasBloco(s + 2, e, vivas, podar);
+
+    free(saida_laco[--n_lacos]);
+}
+
+// Percorre [ini, fim) de trás para frente; com `podar`, remove as escritas mortas
+static void vivasBloco(int ini, int fim, uint64_t* vivas, int podar) {
+    for (int k = fim - 1; k >= ini; k--) {
+        Quadrupla* q = lista.q[k];
+        if (!q) continue;
+        if (fecha(q->op) && par[k] >= 0) {
+            int s = par[k];
+            if (q->op == CG_IF_END) vivasCondicional(s, k, vivas, podar);
+            else vivasLaco(s, k, vivas, podar);
+            k = s;
+            continue;
+        }
+        switch (q->op) {
+            case CG_RETURN:
+                memset(vivas, 0, sizeof(uint64_t) * n_palavras);
+                ler(vivas, &q->arg1);
+                break;
+            case CG_BREAK_IF_FALSE:
+                if (n_lacos > 0) unir(vivas, saida_laco[n_lacos - 1]);
+                ler(vivas, &q->arg1);
+                break;
+            case CG_BREAK:
+            case CG_CONTINUE:
+                // Desvio: valem as vivas do destino (sem laço conhecido, tudo)
+                if (n_lacos == 0) memset(vivas, 0xff, sizeof(uint64_t) * n_palavras);
+                else memcpy(vivas, q->op == CG_BREAK ? saida_laco[n_lacos - 1] : topo_laco[n_lacos - 1],
+                            sizeof(uint64_t) * n_palavras);
+                break;
+            case CG_PARAM:
+            case CG_IF_START:
+            case CG_WHILE_COND:
+                ler(vivas, &q->arg1);
+                break;
+            case CG_CALL:
+                // A chamada fica (tem efeitos); só o valor que ninguém lê sai
+                if (podar && q->resultado.tipo == ADDR_TEMP && morta(vivas, &q->resultado)) {
+                    q->resultado = criarEnderecoVazio();
+                }
+                escrever(vivas, &q->resultado);
+                break;
+            default:
+                if (!opcodeDeValor(q->op)) break;
+                if (podar && morta(vivas, &q->resultado)) {
+                    contarLeitura(&q->arg1, -1);
+                    contarLeitura(&q->arg2, -1);
+                    remover(k);
+                    break;
+                }
+                escrever(vivas, &q->resultado);
+                ler(vivas, &q->arg1);
+                ler(vivas, &q->arg2);
+                break;
+        }
+    }
+}
+
+static void removerEscritasMortas(void) {
+    indexar();
+    numerar();
+    cabeca = calloc(lista.n + 1, sizeof(uint64_t*));
+    if (!cabeca) alocar(NULL, 1);
+    n_lacos = 0;
+
+    uint64_t* vivas = novoConjunto(NULL);
+    vivasBloco(0, lista.n, vivas, 1);
+    free(vivas);
+
+    for (int k = 0; k < lista.n; k++) free(cabeca[k]);
+    free(cabeca);
+    cabeca = NULL;
+}
+
+int eliminarCodigoMorto(void) {
+    lista.q = NULL;
+    lista.n = lista.cap = 0;
+    for (Quadrupla* q = code_head; q; q = q->next) anexar(&lista, q);
+    n_alteracoes = 0;
+
+    // Remover escritas pode esvaziar braços, e podar braços pode matar
+    // escritas anteriores; poucas rodadas bastam
+    for (int rodada = 0; rodada < 4; rodada++) {
+        int antes = n_alteracoes;
+        podarInalcancavel();
+        removerEscritasMortas();
+        if (n_alteracoes == antes) break;
+    }
+
+    Quadrupla* anterior = NULL;
+    code_head = NULL;
+    for (int k = 0; k < lista.n; k++) {
+        Quadrupla* q = lista.q[k];
+        if (!q) continue;
+        if (anterior) anterior->next = q;
+        else code_head = q;
+        anterior = q;
+    }
+    if (anterior) anterior->next = NULL;
+    code_tail = anterior;
+
+    free(lista.q);
+    lista.q = NULL;
+    free(par);
+    free(senao);
+    free(indice_temp);
+    free(usos);
+    par = senao = indice_temp = usos = NULL;
+    cap_temps = 0;
+    liberarVars();
+    return n_alteracoes;
+}
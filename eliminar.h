@@ -0,0 +1,22 @@
+#ifndef ELIMINAR_H
+#define ELIMINAR_H
+
+// --- Eliminação de código morto ---
+// Último passo sobre as quádruplas da função corrente (code_head), depois
+// do desenrolamento de laços. Tudo o que ele remove seria traduzido para o
+// Python e compilado (ou executado) sem necessidade.
+//
+//  - Código inalcançável: o que vem depois de um RETURN no mesmo bloco, de
+//    um laço que nunca sai (nenhum BREAK_IF_FALSE dele pode disparar) e do
+//    teste de um `while (0)`, que some inteiro. `if` com condição constante
+//    fica só com o braço escolhido.
+//  - Braços vazios: ELSE vazio some; THEN vazio com ELSE vira o ELSE sob a
+//    condição negada; `if` sem nenhum dos dois some (a condição fica morta).
+//  - Escritas mortas: atribuições e operações cujo resultado não é lido
+//    depois, por análise de vivacidade sobre as estruturas (com ponto fixo
+//    em cada laço). CALL é sempre mantido, mesmo com o resultado morto.
+
+// Retorna o número de quádruplas removidas ou reescritas.
+int eliminarCodigoMorto(void);
+
+#endif
@@ -0,0 +1,339 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hlirbin.h"
+#include "saida.h"
+
+// ==========================================================
+// Escrita
+// ==========================================================
+
+static uint64_t  posicao = 0;             // bytes já escritos no arquivo
+static uint64_t* indice = NULL;           // posição do bloco de cada função
+static uint32_t  n_funcoes = 0, cap_indice = 0;
+static uint32_t  total_quadruplas = 0;
+static uint32_t  maior_temporarios = 0;
+
+static void escrever(const void* dados, size_t n) {
+    saida_escrever(dados, n);
+    posicao += n;
+}
+
+static void alinhar(void) {
+    static const char zeros[8];
+    size_t resto = (size_t)(posicao % 8);
+    if (resto) escrever(zeros, 8 - resto);
+}
+
+// Tabela de strings da função corrente: texto -> posição no arquivo.
+// Endereçamento aberto; os textos apontam para as quádruplas, que vivem até
+// o fim da função.
+typedef struct {
+    const char* texto;
+    uint32_t    posicao;
+} EntradaTexto;
+
+static EntradaTexto* textos = NULL;
+static size_t cap_textos = 0, n_textos = 0;
+
+static uint32_t hash_texto(const char* s) {
+    uint32_t h = 2166136261u;   // FNV-1a
+    for (; *s; s++) h = (h ^ (unsigned char)*s) * 16777619u;
+    return h;
+}
+
+static EntradaTexto* buscar_texto(const char* s) {
+    size_t i = hash_texto(s) & (cap_textos - 1);
+    while (textos[i].texto && strcmp(textos[i].texto, s) != 0) i = (i + 1) & (cap_textos - 1);
+    return &textos[i];
+}
+
+static void crescer_textos(void) {
+    EntradaTexto* antigos = textos;
+    size_t cap_antiga = cap_textos;
+    cap_textos = cap_textos ? cap_textos * 2 : 64;
+    textos = calloc(cap_textos, sizeof(EntradaTexto));
+    if (!textos) {
+        fprintf(stderr, "Erro: Falha ao alocar memória para o HLIR binário\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < cap_antiga; i++) {
+        if (antigos[i].texto) *buscar_texto(antigos[i].texto) = antigos[i];
+    }
+    free(antigos);
+}
+
+// Posição do texto no arquivo; na primeira vez, escreve-o na tabela de strings
+static uint32_t registrar_texto(const char* s) {
+    if ((n_textos + 1) * 2 > cap_textos) crescer_textos();
+    EntradaTexto* e = buscar_texto(s);
+    if (e->texto) return e->posicao;
+
+    size_t n = strlen(s) + 1;
+    if (posicao + n > UINT32_MAX) {
+        fprintf(stderr, "Erro: HLIR binário maior que 4 GiB\n");
+        exit(EXIT_FAILURE);
+    }
+    e->texto = s;
+    e->posicao = (uint32_t)posicao;
+    n_textos++;
+    escrever(s, n);
+    return e->posicao;
+}
+
+static int tem_texto(const Endereco* e) {
+    return e->tipo == ADDR_VAR || e->tipo == ADDR_CONST_STR;
+}
+
+static uint64_t converter_operando(const Endereco* e) {
+    uint64_t valor = 0;
+    switch (e->tipo) {
+        case ADDR_TEMP:      valor = (uint64_t)e->val.tempId; break;
+        case ADDR_CONST_INT: valor = (uint64_t)e->val.constInt; break;
+        case ADDR_CONST_FLT: memcpy(&valor, &e->val.constFlt, sizeof(double)); break;
+        case ADDR_VAR:
+        case ADDR_CONST_STR: valor = registrar_texto(e->val.varName); break;
+        default: break;
+    }
+    return valor;
+}
+
+void hlirbin_iniciar(void) {
+    HlirCabecalho c;
+    memset(&c, 0, sizeof(c));
+    memcpy(c.magico, HLIRBIN_MAGICO, 4);
+    c.versao = HLIRBIN_VERSAO;
+    c.tam_quadrupla = sizeof(HlirQuad);
+
+    posicao = 0;
+    n_funcoes = 0;
+    total_quadruplas = 0;
+    maior_temporarios = 0;
+    escrever(&c, sizeof(c));
+}
+
+void hlirbin_escrever_funcao(void) {
+    HlirBloco bloco = { 0, (uint32_t)temp_count };
+
+    // 1. Tabela de strings da função
+    n_textos = 0;
+    if (textos) memset(textos, 0, cap_textos * sizeof(EntradaTexto));
+    for (Quadrupla* q = code_head; q; q = q->next) {
+        if (tem_texto(&q->resultado)) registrar_texto(q->resultado.val.varName);
+        if (tem_texto(&q->arg1))      registrar_texto(q->arg1.val.varName);
+        if (tem_texto(&q->arg2))      registrar_texto(q->arg2.val.varName);
+        bloco.n_quadruplas++;
+    }
+    alinhar();
+
+    // 2. Bloco e quádruplas
+    if (n_funcoes == cap_indice) {
+        cap_indice = cap_indice ? cap_indice * 2 : 64;
+        indice = realloc(indice, cap_indice * sizeof(uint64_t));
+    }
+    indice[n_funcoes++] = posicao;
+    escrever(&bloco, sizeof(bloco));
+    for (Quadrupla* q = code_head; q; q = q->next) {
+        HlirQuad h;
+        h.op = (uint8_t)q->op;
+        h.tipo = (uint8_t)q->tipo;
+        h.operandos = (uint16_t)(q->resultado.tipo | q->arg1.tipo << 4 | q->arg2.tipo << 8);
+        h.linha = (uint32_t)q->linha;
+        h.coluna = (uint32_t)q->coluna;
+        h.reservado = 0;
+        h.resultado = converter_operando(&q->resultado);
+        h.arg1 = converter_operando(&q->arg1);
+        h.arg2 = converter_operando(&q->arg2);
+        escrever(&h, sizeof(h));
+    }
+    total_quadruplas += bloco.n_quadruplas;
+    if (bloco.temporarios > maior_temporarios) maior_temporarios = bloco.temporarios;
+}
+
+void hlirbin_finalizar(void) {
+    HlirRodape r;
+    memset(&r, 0, sizeof(r));
+    alinhar();
+    r.indice = posicao;
+    r.n_funcoes = n_funcoes;
+    r.n_quadruplas = total_quadruplas;
+    r.temporarios = maior_temporarios;
+    memcpy(r.magico, HLIRBIN_MAGICO_RODAPE, sizeof(HLIRBIN_MAGICO_RODAPE));
+    if (n_funcoes) escrever(indice, n_funcoes * sizeof(uint64_t));
+    escrever(&r, sizeof(r));
+
+    free(indice);
+    indice = NULL;
+    cap_indice = 0;
+    free(textos);
+    textos = NULL;
+    cap_textos = 0;
+}
+
+// ==========================================================
+// Leitura
+// ==========================================================
+
+static int invalido(const char* caminho, const char* motivo) {
+    fprintf(stderr, "Erro: '%s' não é um HLIR binário válido (%s).\n", caminho, motivo);
+    return 0;
+}
+
+int hlirbin_reconhecer(const char* caminho) {
+    char magico[4];
+    FILE* f = fopen(caminho, "rb");
+    if (!f) return 0;
+    int ok = fread(magico, 1, 4, f) == 4 && memcmp(magico, HLIRBIN_MAGICO, 4) == 0;
+    fclose(f);
+    return ok;
+}
+
+int hlirbin_abrir(const char* caminho, HlirArquivo* arq) {
+    memset(arq, 0, sizeof(*arq));
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Erro: Não foi possível abrir '%s'.\n", caminho);
+        return 0;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(HlirCabecalho) + sizeof(HlirRodape)) {
+        close(fd);
+        return invalido(caminho, "arquivo curto demais");
+    }
+    void* mapa = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        fprintf(stderr, "Erro: Falha ao mapear '%s'.\n", caminho);
+        return 0;
+    }
+    arq->mapa = mapa;
+    arq->tamanho = (size_t)st.st_size;
+
+    const HlirCabecalho* c = (const HlirCabecalho*)arq->mapa;
+    const char* motivo = NULL;
+    if (memcmp(c->magico, HLIRBIN_MAGICO, 4) != 0) motivo = "cabeçalho";
+    else if (c->versao != HLIRBIN_VERSAO) motivo = "versão";
+    else if (c->tam_quadrupla != sizeof(HlirQuad)) motivo = "tamanho da quádrupla";
+
+    size_t fim_dados = arq->tamanho - sizeof(HlirRodape);
+    arq->rodape = (const HlirRodape*)(arq->mapa + fim_dados);
+    if (!motivo && (fim_dados % 8 != 0 ||
+                    memcmp(arq->rodape->magico, HLIRBIN_MAGICO_RODAPE, sizeof(HLIRBIN_MAGICO_RODAPE)) != 0)) {
+        motivo = "rodapé";
+    }
+    if (!motivo && (arq->rodape->indice % 8 != 0 || arq->rodape->indice > fim_dados ||
+                    (fim_dados - arq->rodape->indice) / sizeof(uint64_t) < arq->rodape->n_funcoes)) {
+        motivo = "índice";
+    }
+    if (!motivo) {
+        arq->indice = (const uint64_t*)(arq->mapa + arq->rodape->indice);
+        for (uint32_t i = 0; i < arq->rodape->n_funcoes && !motivo; i++) {
+            uint64_t p = arq->indice[i];
+            if (p % 8 != 0 || p < sizeof(HlirCabecalho) || p + sizeof(HlirBloco) > arq->rodape->indice) {
+                motivo = "bloco de função";
+                break;
+            }
+            const HlirBloco* b = (const HlirBloco*)(arq->mapa + p);
+            if ((arq->rodape->indice - p - sizeof(HlirBloco)) / sizeof(HlirQuad) < b->n_quadruplas) {
+                motivo = "bloco de função";
+            }
+        }
+    }
+    if (motivo) {
+        hlirbin_fechar(arq);
+        return invalido(caminho, motivo);
+    }
+    return 1;
+}
+
+void hlirbin_fechar(HlirArquivo* arq) {
+    if (arq->mapa) munmap((void*)arq->mapa, arq->tamanho);
+    memset(arq, 0, sizeof(*arq));
+}
+
+const HlirBloco* hlirbin_funcao(const HlirArquivo* arq, uint32_t i, const HlirQuad** quads) {
+    const HlirBloco* b = (const HlirBloco*)(arq->mapa + arq->indice[i]);
+    *quads = (const HlirQuad*)(b + 1);
+    return b;
+}
+
+// As strings terminam, no pior caso, no '\0' do mágico do rodapé
+const char* hlirbin_texto(const HlirArquivo* arq, uint64_t posicao) {
+    if (posicao < sizeof(HlirCabecalho) || posicao >= arq->rodape->indice) return NULL;
+    return (const char*)arq->mapa + posicao;
+}
+
+// Retorna 0 se o operando não puder ser reconstruído
+static int carregar_operando(const HlirArquivo* arq, int tipo, uint64_t valor, Endereco* e) {
+    const char* texto;
+    *e = criarEnderecoVazio();
+    switch (tipo) {
+        case ADDR_EMPTY:     return 1;
+        case ADDR_TEMP:
+            if (valor > INT_MAX) return 0;
+            e->tipo = ADDR_TEMP;
+            e->val.tempId = (int)valor;
+            return 1;
+        case ADDR_CONST_INT: *e = criarEnderecoConstInt((long long)valor); return 1;
+        case ADDR_CONST_FLT: e->tipo = ADDR_CONST_FLT; memcpy(&e->val.constFlt, &valor, sizeof(double)); return 1;
+        case ADDR_VAR:
+        case ADDR_CONST_STR:
+            texto = hlirbin_texto(arq, valor);
+            if (!texto) return 0;
+            *e = tipo == ADDR_VAR ? criarEnderecoVar(texto) : criarEnderecoString(texto);
+            return 1;
+        default:             return 0;
+    }
+}
+
+// Os backends contam com a forma que o gerador produz para estes opcodes
+// `lacos`: laços abertos até q (break/continue só dentro de um)
+static int quadrupla_valida(const Quadrupla* q, int* lacos) {
+    switch (q->op) {
+        case CG_WHILE_START:
+        case CG_DO_WHILE_START: (*lacos)++; return 1;
+        case CG_WHILE_END:
+        case CG_DO_WHILE_END:   return (*lacos)-- > 0;
+        case CG_BREAK:
+        case CG_CONTINUE:       return *lacos > 0;
+        case CG_CALL:       return (q->arg1.tipo == ADDR_VAR || q->arg1.tipo == ADDR_CONST_STR) &&
+                                   q->arg2.tipo == ADDR_CONST_INT && q->arg2.val.constInt >= 0;
+        case CG_FUNC_START: return q->arg1.tipo == ADDR_VAR;
+        case CG_CONVERT:
+        case CG_F32:        return tipoAritmetico(q->tipo);
+        default:            return q->op < CG_NUM_OPCODES;
+    }
+}
+
+int hlirbin_carregar_funcao(const HlirArquivo* arq, uint32_t i) {
+    const HlirQuad* quads;
+    const HlirBloco* b = hlirbin_funcao(arq, i, &quads);
+    int lacos = 0;
+    for (uint32_t k = 0; k < b->n_quadruplas; k++) {
+        const HlirQuad* h = &quads[k];
+        Quadrupla* q = malloc(sizeof(Quadrupla));
+        q->op = (OpCodeCG)h->op;
+        q->tipo = h->tipo <= TIPO_DOUBLE ? (TipoDadoCG)h->tipo : TIPO_NENHUM;
+        int ok = carregar_operando(arq, HLIRBIN_OPERANDO(h, 0), h->resultado, &q->resultado);
+        ok = carregar_operando(arq, HLIRBIN_OPERANDO(h, 1), h->arg1, &q->arg1) && ok;
+        ok = carregar_operando(arq, HLIRBIN_OPERANDO(h, 2), h->arg2, &q->arg2) && ok;
+        q->linha = (int)h->linha;
+        q->coluna = (int)h->coluna;
+        q->next = NULL;
+        if (!code_head) code_head = q;
+        else code_tail->next = q;
+        code_tail = q;
+        if (!ok || !quadrupla_valida(q, &lacos)) {
+            fprintf(stderr, "Erro: Quádrupla %u da função %u do HLIR binário é inválida.\n",
+                    (unsigned)k + 1, (unsigned)i + 1);
+            return 0;
+        }
+    }
+    temp_count = (int)b->temporarios;
+    return 1;
+}
@@ -0,0 +1,94 @@
+#ifndef HLIRBIN_H
+#define HLIRBIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "codegen.h"
+
+// --- HLIR binário ---
+// Forma serializada compacta do código intermediário (--emit=bin), lida de
+// volta sem passar de novo pelo front end: o arquivo é mapeado com mmap e as
+// quádruplas são usadas direto do mapa, sem cópia nem análise de texto.
+// Guarda o que o texto perde: constantes double com todos os bits e o tipo C
+// de cada quádrupla.
+//
+// Layout (little-endian; estruturas alinhadas em 8 bytes no arquivo):
+//   HlirCabecalho
+//   para cada função, na ordem do fonte:
+//       tabela de strings da função (textos terminados em '\0')
+//       HlirBloco seguido de n_quadruplas HlirQuad
+//   índice: um uint64_t por função com a posição do seu HlirBloco
+//   HlirRodape
+// Cada quádrupla ocupa 40 bytes: o tipo dos três operandos (TipoEndereco)
+// vai em 4 bits cada de `operandos`, e o valor em 64 bits: o número do
+// temporário, o inteiro, os bits do double ou, para ADDR_VAR/ADDR_CONST_STR,
+// a posição do texto no arquivo. Como cada função é escrita assim que é traduzida, os totais e o
+// índice ficam no fim, e o leitor começa pelo rodapé.
+
+#define HLIRBIN_MAGICO        "HLIR"
+#define HLIRBIN_MAGICO_RODAPE "HLIRFIM"
+#define HLIRBIN_VERSAO        2
+
+typedef struct {
+    char     magico[4];         // "HLIR"
+    uint16_t versao;
+    uint16_t tam_quadrupla;     // sizeof(HlirQuad), para detectar layouts diferentes
+    uint32_t reservado[2];
+} HlirCabecalho;
+
+typedef struct {
+    uint8_t  op;                // OpCodeCG
+    uint8_t  tipo;              // TipoDadoCG
+    uint16_t operandos;         // TipoEndereco de resultado | arg1 << 4 | arg2 << 8
+    uint32_t linha;
+    uint32_t coluna;
+    uint32_t reservado;
+    uint64_t resultado, arg1, arg2;
+} HlirQuad;
+
+#define HLIRBIN_OPERANDO(q, n) (((q)->operandos >> (4 * (n))) & 0xF)
+
+typedef struct {
+    uint32_t n_quadruplas;
+    uint32_t temporarios;
+} HlirBloco;
+
+typedef struct {
+    uint64_t indice;            // posição do índice de funções
+    uint32_t n_funcoes;
+    uint32_t n_quadruplas;      // total do arquivo
+    uint32_t temporarios;       // maior número de temporários de uma função
+    uint32_t reservado;
+    char     magico[8];         // "HLIRFIM\0"
+} HlirRodape;
+
+// --- Escrita (pelo buffer de saida.h) ---
+void hlirbin_iniciar(void);          // cabeçalho
+void hlirbin_escrever_funcao(void);  // quádruplas correntes (uma função)
+void hlirbin_finalizar(void);        // índice e rodapé
+
+// --- Leitura ---
+typedef struct {
+    const uint8_t*    mapa;
+    size_t            tamanho;
+    const HlirRodape* rodape;
+    const uint64_t*   indice;
+} HlirArquivo;
+
+// Mapeia e valida o arquivo. Retorna 0 (com mensagem em stderr) se não for
+// HLIR binário válido desta versão.
+int  hlirbin_abrir(const char* caminho, HlirArquivo* arq);
+void hlirbin_fechar(HlirArquivo* arq);
+// O arquivo começa com o cabeçalho do HLIR binário?
+int  hlirbin_reconhecer(const char* caminho);
+
+// Bloco da i-ésima função; *quads aponta para as quádruplas dentro do mapa
+const HlirBloco* hlirbin_funcao(const HlirArquivo* arq, uint32_t i, const HlirQuad** quads);
+// Texto de um operando ADDR_VAR/ADDR_CONST_STR (NULL se a posição for inválida)
+const char* hlirbin_texto(const HlirArquivo* arq, uint64_t posicao);
+// Reconstrói a i-ésima função como lista de quádruplas (code_head), para
+// reaproveitar os backends (texto, JSON, Python). Retorna 0 (com mensagem
+// em stderr) se encontrar uma quádrupla inválida.
+int  hlirbin_carregar_funcao(const HlirArquivo* arq, uint32_t i);
+
+#endif
@@ -0,0 +1,935 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include "incremental.h"
+#include "codegen.h"
+#include "saida.h"
+
+#define TAM_CACHE       16384
+#define FNV_INICIAL     1469598103934665603ULL
+#define FNV_PRIMO       1099511628211ULL
+
+// ==========================================================
+// Estado
+// ==========================================================
+
+typedef struct {
+    char*  s;
+    size_t n, cap;
+} Buffer;
+
+typedef struct {
+    Quadrupla* quadruplas;
+    Quadrupla* ultima;
+    int        temporarios;
+} FuncaoGuardada;
+
+// Resultado da tradução de um trecho, reaproveitado enquanto o texto do
+// trecho e o contexto (diretivas anteriores) não mudarem
+typedef struct Entrada {
+    uint64_t chave;
+    uint64_t contexto;
+    char*    texto;
+    size_t   n;
+    int      linha;          // linha do documento quando foi traduzido
+    int      fixa_linha;     // tem #include: as linhas dos headers não se deslocam
+    int      com_mensagens;  // avisos em stderr: não é reaproveitado
+    FuncaoGuardada* funcoes;
+    int      n_funcoes, cap_funcoes;
+    unsigned geracao;        // última versão do documento que o usou
+    struct Entrada* prox;
+} Entrada;
+
+typedef struct {
+    size_t inicio, n;
+} Faixa;
+
+typedef struct {
+    size_t   inicio, n;
+    int      linha;
+    size_t   diretivas;      // primeira diretiva do trecho em doc.diretivas
+    int      fixa_linha;
+    Entrada* entrada;
+} Trecho;
+
+static struct {
+    int     aberto;
+    char*   nome;
+    Buffer  texto;           // sempre terminado em '\0'
+    char**  args;
+    int     n_args;
+    Trecho* trechos;
+    int     n_trechos, cap_trechos;
+    Faixa*  diretivas;
+    size_t  n_diretivas, cap_diretivas;
+} doc;
+
+static const FrontEnd* front = NULL;
+static Entrada* cache[TAM_CACHE];
+static unsigned geracao = 0;
+static Entrada* em_traducao = NULL;
+static int fd_captura = -1;      // recebe o stderr durante uma tradução
+static int fd_stderr = -1;
+
+// ==========================================================
+// Utilitários
+// ==========================================================
+
+static void* alocar(void* p, size_t n) {
+    void* novo = realloc(p, n ? n : 1);
+    if (!novo) {
+        fprintf(stderr, "Erro: Falha ao alocar memória no modo incremental\n");
+        exit(EXIT_FAILURE);
+    }
+    return novo;
+}
+
+static void buffer_anexar(Buffer* b, const char* s, size_t n) {
+    if (b->n + n + 1 > b->cap) {
+        b->cap = b->cap ? b->cap : 256;
+        while (b->n + n + 1 > b->cap) b->cap *= 2;
+        b->s = alocar(b->s, b->cap);
+    }
+    memcpy(b->s + b->n, s, n);
+    b->n += n;
+    b->s[b->n] = '\0';
+}
+
+static void buffer_liberar(Buffer* b) {
+    free(b->s);
+    memset(b, 0, sizeof(*b));
+}
+
+static uint64_t fnv(uint64_t h, const void* dados, size_t n) {
+    const unsigned char* p = dados;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= FNV_PRIMO;
+    }
+    return h;
+}
+
+static double agora_ms(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+// ==========================================================
+// Divisão do documento em trechos
+// ==========================================================
+// Uma varredura do texto bruto, sem pré-processar: acompanha comentários,
+// literais, diretivas e a profundidade de chaves. O trecho termina no '}'
+// que fecha uma chave de nível superior, desde que nada além de espaços e
+// de um comentário // o siga na mesma linha (o próximo trecho começa então
+// na coluna 1) e que nenhum #if esteja aberto. O que vem depois do último
+// corte fica com o último trecho.
+
+static void anexar_trecho(size_t inicio, size_t fim, int linha, size_t diretivas, int fixa) {
+    if (doc.n_trechos == doc.cap_trechos) {
+        doc.cap_trechos = doc.cap_trechos ? doc.cap_trechos * 2 : 64;
+        doc.trechos = alocar(doc.trechos, (size_t)doc.cap_trechos * sizeof(Trecho));
+    }
+    Trecho* t = &doc.trechos[doc.n_trechos++];
+    t->inicio = inicio;
+    t->n = fim - inicio;
+    t->linha = linha;
+    t->diretivas = diretivas;
+    t->fixa_linha = fixa;
+    t->entrada = NULL;
+}
+
+static void anexar_diretiva(size_t inicio, size_t fim) {
+    if (doc.n_diretivas == doc.cap_diretivas) {
+        doc.cap_diretivas = doc.cap_diretivas ? doc.cap_diretivas * 2 : 16;
+        doc.diretivas = alocar(doc.diretivas, doc.cap_diretivas * sizeof(Faixa));
+    }
+    doc.diretivas[doc.n_diretivas].inicio = inicio;
+    doc.diretivas[doc.n_diretivas].n = fim - inicio;
+    doc.n_diretivas++;
+}
+
+// Fim de um comentário /* */ a partir de `i`, contando as quebras de linha
+static size_t pular_comentario(const char* s, size_t n, size_t i, int* linha) {
+    for (i += 2; i < n; i++) {
+        if (s[i] == '\n') (*linha)++;
+        else if (s[i] == '*' && s[i + 1] == '/') return i + 2;
+    }
+    return n;
+}
+
+// Fim de um literal em uma diretiva (o pré-processador trabalha por linha)
+static size_t pular_literal(const char* s, size_t n, size_t i) {
+    char aspa = s[i];
+    for (i++; i < n && s[i] != '\n'; i++) {
+        if (s[i] == '\\' && s[i + 1] != '\0') i++;
+        else if (s[i] == aspa) return i + 1;
+    }
+    return i;
+}
+
+// Literais fora de diretivas seguem as regras do lexer: uma string pode
+// atravessar linhas e uma aspa sem par é só um caractere inválido
+static size_t pular_string(const char* s, size_t n, size_t i, int* linha) {
+    int quebras = 0;
+    for (size_t j = i + 1; j < n; j++) {
+        if (s[j] == '\\' && j + 1 < n) {
+            quebras += s[++j] == '\n';
+        } else if (s[j] == '"') {
+            *linha += quebras;
+            return j + 1;
+        } else if (s[j] == '\n') {
+            quebras++;
+        }
+    }
+    return i + 1;
+}
+
+static size_t pular_caractere(const char* s, size_t n, size_t i, int* linha) {
+    size_t k = s[i + 1] == '\\' ? 3 : 2;
+    if (i + k < n && s[i + 1] != '\'' && s[i + k] == '\'') {
+        *linha += s[i + k - 1] == '\n';
+        return i + k + 1;
+    }
+    return i + 1;
+}
+
+// Diretiva a partir do '#' em `i`: até o fim da linha lógica (com '\'
+// e comentários que atravessam linhas). Atualiza o nível de #if.
+static size_t pular_diretiva(const char* s, size_t n, size_t i, int* linha, int* conds, int* fixa) {
+    size_t ini = i, j = i + 1;
+    while (j < n && (s[j] == ' ' || s[j] == '\t')) j++;
+    size_t nome = j;
+    while (j < n && (s[j] == '_' || (s[j] >= 'a' && s[j] <= 'z'))) j++;
+#define NOME(x) (j - nome == sizeof(x) - 1 && strncmp(s + nome, x, j - nome) == 0)
+    if (NOME("if") || NOME("ifdef") || NOME("ifndef")) (*conds)++;
+    else if (NOME("endif") && *conds > 0) (*conds)--;
+    else if (NOME("include")) *fixa = 1;
+#undef NOME
+    while (j < n && s[j] != '\n') {
+        if (s[j] == '\\' && s[j + 1] == '\n') {
+            (*linha)++;
+            j += 2;
+        } else if (s[j] == '/' && s[j + 1] == '*') {
+            j = pular_comentario(s, n, j, linha);
+        } else if (s[j] == '/' && s[j + 1] == '/') {
+            while (j < n && s[j] != '\n') j++;
+        } else if (s[j] == '"' || s[j] == '\'') {
+            j = pular_literal(s, n, j);
+        } else {
+            j++;
+        }
+    }
+    if (j < n) {
+        (*linha)++;
+        j++;
+    }
+    anexar_diretiva(ini, j);
+    return j;
+}
+
+// Depois do '}' em `i`: fim da linha se ela não tiver mais código, senão 0
+static size_t fim_de_corte(const char* s, size_t n, size_t i) {
+    for (i++; i < n && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r'); i++) {}
+    if (i + 1 < n && s[i] == '/' && s[i + 1] == '/') {
+        while (i < n && s[i] != '\n') i++;
+    }
+    if (i == n) return n;
+    return s[i] == '\n' ? i + 1 : 0;
+}
+
+static void segmentar(void) {
+    const char* s = doc.texto.s;
+    size_t n = doc.texto.n, i = 0, inicio = 0, diretivas = 0;
+    int linha = 1, linha_inicio = 1, chaves = 0, conds = 0, fixa = 0, comeco_linha = 1;
+
+    doc.n_trechos = 0;
+    doc.n_diretivas = 0;
+    while (i < n) {
+        char c = s[i];
+        if (c == '\n') {
+            linha++;
+            comeco_linha = 1;
+            i++;
+        } else if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v') {
+            i++;
+        } else if (c == '#' && comeco_linha) {
+            i = pular_diretiva(s, n, i, &linha, &conds, &fixa);
+        } else if (c == '/' && s[i + 1] == '/') {
+            while (i < n && s[i] != '\n') i++;
+        } else if (c == '/' && s[i + 1] == '*') {
+            i = pular_comentario(s, n, i, &linha);
+        } else if (c == '"' || c == '\'') {
+            comeco_linha = 0;
+            i = c == '"' ? pular_string(s, n, i, &linha) : pular_caractere(s, n, i, &linha);
+        } else {
+            comeco_linha = 0;
+            if (c == '{') {
+                chaves++;
+            } else if (c == '}' && chaves > 0 && --chaves == 0 && conds == 0) {
+                size_t fim = fim_de_corte(s, n, i);
+                if (fim) {
+                    anexar_trecho(inicio, fim, linha_inicio, diretivas, fixa);
+                    inicio = fim;
+                    linha_inicio = linha + (s[fim - 1] == '\n');
+                    diretivas = doc.n_diretivas;
+                    fixa = 0;
+                }
+            }
+            i++;
+        }
+    }
+    if (inicio < n || doc.n_trechos == 0) {
+        if (doc.n_trechos > 0) {
+            Trecho* ultimo = &doc.trechos[doc.n_trechos - 1];
+            ultimo->n = n - ultimo->inicio;
+            ultimo->fixa_linha |= fixa;
+        } else {
+            anexar_trecho(0, n, 1, 0, fixa);
+        }
+    }
+}
+
+// ==========================================================
+// Cache de trechos
+// ==========================================================
+
+static void liberar_quadruplas(Quadrupla* q) {
+    while (q) {
+        Quadrupla* prox = q->next;
+        liberarEndereco(&q->arg1);
+        liberarEndereco(&q->arg2);
+        liberarEndereco(&q->resultado);
+        free(q);
+        q = prox;
+    }
+}
+
+static void liberar_entrada(Entrada* e) {
+    for (int i = 0; i < e->n_funcoes; i++) liberar_quadruplas(e->funcoes[i].quadruplas);
+    free(e->funcoes);
+    free(e->texto);
+    free(e);
+}
+
+static Entrada* buscar(uint64_t chave, uint64_t contexto, const Trecho* t) {
+    for (Entrada* e = cache[chave % TAM_CACHE]; e; e = e->prox) {
+        if (e->chave == chave && e->contexto == contexto && e->n == t->n && !e->com_mensagens
+            && (!e->fixa_linha || e->linha == t->linha)
+            && memcmp(e->texto, doc.texto.s + t->inicio, t->n) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+// Libera as entradas que a versão atual do documento não usou
+static void coletar(int tudo) {
+    for (int i = 0; i < TAM_CACHE; i++) {
+        Entrada** p = &cache[i];
+        while (*p) {
+            Entrada* e = *p;
+            if (tudo || e->geracao != geracao) {
+                *p = e->prox;
+                liberar_entrada(e);
+            } else {
+                p = &e->prox;
+            }
+        }
+    }
+}
+
+void incremental_guardar_funcao(void) {
+    Entrada* e = em_traducao;
+    if (!e) {
+        liberarCodigoIntermediario();
+        return;
+    }
+    if (e->n_funcoes == e->cap_funcoes) {
+        e->cap_funcoes = e->cap_funcoes ? e->cap_funcoes * 2 : 2;
+        e->funcoes = alocar(e->funcoes, (size_t)e->cap_funcoes * sizeof(FuncaoGuardada));
+    }
+    e->funcoes[e->n_funcoes].quadruplas = code_head;
+    e->funcoes[e->n_funcoes].ultima = code_tail;
+    e->funcoes[e->n_funcoes].temporarios = temp_count;
+    e->n_funcoes++;
+    // A lista passa a ser do cache; só os contadores são reiniciados
+    code_head = code_tail = NULL;
+    liberarCodigoIntermediario();
+}
+
+// O stderr do compilador vai para um arquivo temporário durante a tradução
+// de um trecho; o que foi escrito vira diagnóstico
+static void capturar_stderr(void) {
+    fflush(stderr);
+    if (ftruncate(fd_captura, 0) != 0 || lseek(fd_captura, 0, SEEK_SET) < 0) return;
+    dup2(fd_captura, STDERR_FILENO);
+}
+
+static void soltar_stderr(Buffer* diagnosticos) {
+    fflush(stderr);
+    dup2(fd_stderr, STDERR_FILENO);
+    off_t tam = lseek(fd_captura, 0, SEEK_CUR);
+    if (tam <= 0) return;
+    char* dados = alocar(NULL, (size_t)tam);
+    if (pread(fd_captura, dados, (size_t)tam, 0) == tam) buffer_anexar(diagnosticos, dados, (size_t)tam);
+    free(dados);
+}
+
+// Traduz o trecho `t`; retorna a entrada (já no cache) ou NULL em erro
+static Entrada* traduzir(const Trecho* t, const Buffer* contexto, uint64_t chave, uint64_t h_contexto,
+                         Buffer* diagnosticos) {
+    Entrada* e = alocar(NULL, sizeof(Entrada));
+    memset(e, 0, sizeof(*e));
+    e->chave = chave;
+    e->contexto = h_contexto;
+    e->texto = alocar(NULL, t->n);
+    memcpy(e->texto, doc.texto.s + t->inicio, t->n);
+    e->n = t->n;
+    e->linha = t->linha;
+    e->fixa_linha = t->fixa_linha;
+
+    TrechoFonte fonte = { doc.nome, contexto->s, contexto->n, e->texto, e->n, t->linha };
+    size_t antes = diagnosticos->n;
+    em_traducao = e;
+    capturar_stderr();
+    int ok = front->traduzir(doc.n_args, doc.args, &fonte);
+    soltar_stderr(diagnosticos);
+    em_traducao = NULL;
+
+    if (!ok) {
+        liberar_entrada(e);
+        return NULL;
+    }
+    e->com_mensagens = diagnosticos->n > antes;
+    e->prox = cache[chave % TAM_CACHE];
+    cache[chave % TAM_CACHE] = e;
+    return e;
+}
+
+// ==========================================================
+// Atualização e emissão
+// ==========================================================
+
+typedef struct {
+    int ok;
+    int funcoes;
+    int reanalisados;
+    Buffer diagnosticos;
+} Resultado;
+
+// Traz todos os trechos do documento para a versão atual do texto
+static void atualizar(Resultado* r) {
+    Buffer contexto = {0};
+    uint64_t h_contexto = FNV_INICIAL;
+
+    geracao++;
+    segmentar();
+    r->ok = 1;
+    for (int i = 0; i < doc.n_trechos; i++) {
+        Trecho* t = &doc.trechos[i];
+        uint64_t chave = fnv(h_contexto, doc.texto.s + t->inicio, t->n);
+        if (t->fixa_linha) chave = fnv(chave, &t->linha, sizeof(t->linha));
+
+        t->entrada = buscar(chave, h_contexto, t);
+        if (!t->entrada) {
+            t->entrada = traduzir(t, &contexto, chave, h_contexto, &r->diagnosticos);
+            r->reanalisados++;
+        }
+        if (t->entrada) {
+            t->entrada->geracao = geracao;
+            r->funcoes += t->entrada->n_funcoes;
+        } else {
+            r->ok = 0;
+        }
+
+        // As diretivas deste trecho valem para os seguintes
+        size_t fim = i + 1 < doc.n_trechos ? doc.trechos[i + 1].diretivas : doc.n_diretivas;
+        for (size_t d = t->diretivas; d < fim; d++) {
+            const char* s = doc.texto.s + doc.diretivas[d].inicio;
+            size_t n = doc.diretivas[d].n;
+            buffer_anexar(&contexto, s, n);
+            if (n == 0 || s[n - 1] != '\n') buffer_anexar(&contexto, "\n", 1);
+            h_contexto = fnv(h_contexto, s, n);
+        }
+    }
+    coletar(0);
+    buffer_liberar(&contexto);
+}
+
+// Emite o documento a partir das quádruplas guardadas, sem copiá-las: a
+// lista de cada função vira a corrente só durante a emissão. Um trecho que
+// mudou de linha tem as posições das quádruplas atualizadas no lugar.
+static char* emitir_documento(size_t* n) {
+    saida_abrir_memoria();
+    front->iniciar();
+    for (int i = 0; i < doc.n_trechos; i++) {
+        Entrada* e = doc.trechos[i].entrada;
+        int deslocamento = doc.trechos[i].linha - e->linha;
+        if (deslocamento != 0 && !e->fixa_linha) {
+            for (int k = 0; k < e->n_funcoes; k++) {
+                for (Quadrupla* q = e->funcoes[k].quadruplas; q; q = q->next) {
+                    if (q->linha > 0) q->linha += deslocamento;
+                }
+            }
+            e->linha = doc.trechos[i].linha;
+        }
+        for (int k = 0; k < e->n_funcoes; k++) {
+            code_head = e->funcoes[k].quadruplas;
+            code_tail = e->funcoes[k].ultima;
+            temp_count = e->funcoes[k].temporarios;
+            front->emitir();
+            code_head = code_tail = NULL;
+            liberarCodigoIntermediario();
+        }
+    }
+    front->finalizar();
+    return saida_fechar_memoria(n);
+}
+
+// ==========================================================
+// JSON
+// ==========================================================
+
+typedef struct {
+    const char* p;
+    const char* fim;
+} Leitor;
+
+typedef struct {
+    char*  id;          // texto JSON do id, devolvido como veio
+    char*  metodo;
+    char*  nome;
+    Buffer texto;
+    int    tem_texto;
+    long long inicio, fim;
+    char** args;
+    int    n_args, tem_args;
+    int    saida;
+} Pedido;
+
+static void espacos(Leitor* l) {
+    while (l->p < l->fim && (*l->p == ' ' || *l->p == '\t' || *l->p == '\r' || *l->p == '\n')) l->p++;
+}
+
+static int hex4(const char* p, unsigned* v) {
+    *v = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = p[i];
+        int d = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10
+              : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+        if (d < 0) return 0;
+        *v = *v * 16 + (unsigned)d;
+    }
+    return 1;
+}
+
+static void utf8(Buffer* b, unsigned c) {
+    char s[4];
+    size_t n;
+    if (c < 0x80)       { s[0] = (char)c; n = 1; }
+    else if (c < 0x800) { s[0] = (char)(0xC0 | c >> 6); s[1] = (char)(0x80 | (c & 0x3F)); n = 2; }
+    else if (c < 0x10000) {
+        s[0] = (char)(0xE0 | c >> 12); s[1] = (char)(0x80 | (c >> 6 & 0x3F));
+        s[2] = (char)(0x80 | (c & 0x3F)); n = 3;
+    } else {
+        s[0] = (char)(0xF0 | c >> 18); s[1] = (char)(0x80 | (c >> 12 & 0x3F));
+        s[2] = (char)(0x80 | (c >> 6 & 0x3F)); s[3] = (char)(0x80 | (c & 0x3F)); n = 4;
+    }
+    buffer_anexar(b, s, n);
+}
+
+// String JSON (o leitor está na aspa de abertura); `b` pode ser NULL
+static int ler_string(Leitor* l, Buffer* b) {
+    if (l->p >= l->fim || *l->p != '"') return 0;
+    l->p++;
+    while (l->p < l->fim && *l->p != '"') {
+        const char* ini = l->p;
+        while (l->p < l->fim && *l->p != '"' && *l->p != '\\') l->p++;
+        if (b) buffer_anexar(b, ini, (size_t)(l->p - ini));
+        if (l->p >= l->fim || *l->p == '"') break;
+
+        if (l->fim - l->p < 2) return 0;
+        char c = l->p[1], s = 0;
+        l->p += 2;
+        switch (c) {
+            case '"': case '\\': case '/': s = c; break;
+            case 'b': s = '\b'; break;
+            case 'f': s = '\f'; break;
+            case 'n': s = '\n'; break;
+            case 'r': s = '\r'; break;
+            case 't': s = '\t'; break;
+            case 'u': {
+                unsigned v, baixo;
+                if (l->fim - l->p < 4 || !hex4(l->p, &v)) return 0;
+                l->p += 4;
+                // Par de substitutos UTF-16
+                if (v >= 0xD800 && v < 0xDC00 && l->fim - l->p >= 6 && l->p[0] == '\\' && l->p[1] == 'u'
+                    && hex4(l->p + 2, &baixo) && baixo >= 0xDC00 && baixo < 0xE000) {
+                    v = 0x10000 + ((v - 0xD800) << 10) + (baixo - 0xDC00);
+                    l->p += 6;
+                }
+                if (b) utf8(b, v);
+                continue;
+            }
+            default: return 0;
+        }
+        if (b) buffer_anexar(b, &s, 1);
+    }
+    if (l->p >= l->fim) return 0;
+    l->p++;
+    if (b && !b->s) buffer_anexar(b, "", 0);
+    return 1;
+}
+
+static int pular_valor(Leitor* l, int profundidade) {
+    espacos(l);
+    if (l->p >= l->fim || profundidade > 64) return 0;
+    char c = *l->p;
+    if (c == '"') return ler_string(l, NULL);
+    if (c == '{' || c == '[') {
+        char fecha = c == '{' ? '}' : ']';
+        l->p++;
+        espacos(l);
+        if (l->p < l->fim && *l->p == fecha) { l->p++; return 1; }
+        for (;;) {
+            if (c == '{') {
+                espacos(l);
+                if (!ler_string(l, NULL)) return 0;
+                espacos(l);
+                if (l->p >= l->fim || *l->p++ != ':') return 0;
+            }
+            if (!pular_valor(l, profundidade + 1)) return 0;
+            espacos(l);
+            if (l->p >= l->fim) return 0;
+            if (*l->p == fecha) { l->p++; return 1; }
+            if (*l->p++ != ',') return 0;
+        }
+    }
+    const char* ini = l->p;
+    while (l->p < l->fim && (strchr("+-.eE", *l->p) || (*l->p >= '0' && *l->p <= '9') || (*l->p >= 'a' && *l->p <= 'z'))) l->p++;
+    return l->p > ini;
+}
+
+static int ler_inteiro(Leitor* l, long long* v) {
+    espacos(l);
+    char* fim;
+    errno = 0;
+    *v = strtoll(l->p, &fim, 10);
+    if (fim == l->p || errno != 0 || (*fim == '.' || *fim == 'e' || *fim == 'E')) return 0;
+    l->p = fim;
+    return 1;
+}
+
+static void liberar_pedido(Pedido* p) {
+    free(p->id);
+    free(p->metodo);
+    free(p->nome);
+    buffer_liberar(&p->texto);
+    for (int i = 0; i < p->n_args; i++) free(p->args[i]);
+    free(p->args);
+    memset(p, 0, sizeof(*p));
+}
+
+static char* string_de(Buffer* b) {
+    char* s = b->s ? b->s : strdup("");
+    memset(b, 0, sizeof(*b));
+    return s;
+}
+
+// Lê um pedido (uma linha). Retorna 0 se o JSON for inválido.
+static int ler_pedido(const char* linha, size_t n, Pedido* p) {
+    Leitor l = { linha, linha + n };
+    memset(p, 0, sizeof(*p));
+    p->inicio = p->fim = -1;
+    p->saida = 1;
+
+    espacos(&l);
+    if (l.p >= l.fim || *l.p++ != '{') return 0;
+    espacos(&l);
+    if (l.p < l.fim && *l.p == '}') return 1;
+    for (;;) {
+        Buffer chave = {0};
+        espacos(&l);
+        if (!ler_string(&l, &chave)) { buffer_liberar(&chave); return 0; }
+        espacos(&l);
+        if (l.p >= l.fim || *l.p++ != ':') { buffer_liberar(&chave); return 0; }
+        espacos(&l);
+
+        int ok = 1;
+        Buffer valor = {0};
+        const char* k = chave.s;
+        if (strcmp(k, "id") == 0) {
+            const char* ini = l.p;
+            ok = pular_valor(&l, 0);
+            if (ok) { free(p->id); p->id = strndup(ini, (size_t)(l.p - ini)); }
+        } else if (strcmp(k, "metodo") == 0 || strcmp(k, "nome") == 0) {
+            ok = ler_string(&l, &valor);
+            if (ok) {
+                char** destino = k[0] == 'm' ? &p->metodo : &p->nome;
+                free(*destino);
+                *destino = string_de(&valor);
+            }
+        } else if (strcmp(k, "texto") == 0) {
+            buffer_liberar(&p->texto);
+            ok = ler_string(&l, &p->texto);
+            p->tem_texto = ok;
+        } else if (strcmp(k, "inicio") == 0) {
+            ok = ler_inteiro(&l, &p->inicio);
+        } else if (strcmp(k, "fim") == 0) {
+            ok = ler_inteiro(&l, &p->fim);
+        } else if (strcmp(k, "saida") == 0) {
+            if (l.fim - l.p >= 4 && strncmp(l.p, "true", 4) == 0)       { p->saida = 1; l.p += 4; }
+            else if (l.fim - l.p >= 5 && strncmp(l.p, "false", 5) == 0) { p->saida = 0; l.p += 5; }
+            else ok = 0;
+        } else if (strcmp(k, "args") == 0) {
+            ok = l.p < l.fim && *l.p++ == '[';
+            p->tem_args = 1;
+            espacos(&l);
+            if (ok && l.p < l.fim && *l.p == ']') {
+                l.p++;
+            } else while (ok) {
+                espacos(&l);
+                ok = ler_string(&l, &valor);
+                if (!ok) break;
+                p->args = alocar(p->args, (size_t)(p->n_args + 1) * sizeof(char*));
+                p->args[p->n_args++] = string_de(&valor);
+                espacos(&l);
+                if (l.p < l.fim && *l.p == ']') { l.p++; break; }
+                ok = l.p < l.fim && *l.p++ == ',';
+            }
+        } else {
+            ok = pular_valor(&l, 0);
+        }
+        buffer_liberar(&valor);
+        buffer_liberar(&chave);
+        if (!ok) return 0;
+
+        espacos(&l);
+        if (l.p >= l.fim) return 0;
+        if (*l.p == '}') return 1;
+        if (*l.p++ != ',') return 0;
+    }
+}
+
+// Tamanho da sequência UTF-8 válida em `s` (0 se inválida)
+static size_t utf8_valido(const unsigned char* s, size_t n) {
+    size_t k = s[0] >= 0xF0 && s[0] <= 0xF4 ? 4 : s[0] >= 0xE0 ? 3 : s[0] >= 0xC2 && s[0] < 0xE0 ? 2 : 0;
+    if (k == 0 || k > n) return 0;
+    for (size_t i = 1; i < k; i++) {
+        if ((s[i] & 0xC0) != 0x80) return 0;
+    }
+    return k;
+}
+
+// Bytes que não formam UTF-8 válido (uma edição que partiu um caractere)
+// viram U+FFFD, para que a resposta continue sendo JSON válido
+static void json_texto(FILE* f, const char* s, size_t n) {
+    fputc('"', f);
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c >= 0x80) {
+            size_t k = utf8_valido((const unsigned char*)s + i, n - i);
+            if (k) fwrite(s + i, 1, k, f);
+            else fputs("\\ufffd", f);
+            i += k ? k - 1 : 0;
+            continue;
+        }
+        switch (c) {
+            case '"':  fputs("\\\"", f); break;
+            case '\\': fputs("\\\\", f); break;
+            case '\n': fputs("\\n", f); break;
+            case '\r': fputs("\\r", f); break;
+            case '\t': fputs("\\t", f); break;
+            default:
+                if (c < 0x20) fprintf(f, "\\u%04x", c);
+                else fputc(c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+static void responder_erro(const Pedido* p, const char* mensagem) {
+    printf("{\"id\": %s, \"ok\": false, \"erro\": ", p->id ? p->id : "null");
+    json_texto(stdout, mensagem, strlen(mensagem));
+    printf("}\n");
+    fflush(stdout);
+}
+
+static void responder(const Pedido* p, const Resultado* r, const char* saida, size_t n, double ms) {
+    printf("{\"id\": %s, \"ok\": %s", p->id ? p->id : "null", r->ok ? "true" : "false");
+    if (saida) {
+        printf(", \"saida\": ");
+        json_texto(stdout, saida, n);
+    }
+    printf(", \"diagnosticos\": [");
+    const char* s = r->diagnosticos.s;
+    for (size_t i = 0, ini = 0; ini < r->diagnosticos.n; ini = i + 1) {
+        const char* nl = memchr(s + ini, '\n', r->diagnosticos.n - ini);
+        i = nl ? (size_t)(nl - s) : r->diagnosticos.n;
+        if (ini > 0) printf(", ");
+        json_texto(stdout, s + ini, i - ini);
+    }
+    printf("], \"funcoes\": %d, \"trechos\": %d, \"reanalisados\": %d, \"reaproveitados\": %d, \"ms\": %.3f}\n",
+           r->funcoes, doc.n_trechos, r->reanalisados, doc.n_trechos - r->reanalisados, ms);
+    fflush(stdout);
+}
+
+// ==========================================================
+// Documento
+// ==========================================================
+
+static void fechar_documento(void) {
+    coletar(1);
+    free(doc.nome);
+    buffer_liberar(&doc.texto);
+    for (int i = 0; i < doc.n_args; i++) free(doc.args[i]);
+    free(doc.args);
+    free(doc.trechos);
+    free(doc.diretivas);
+    memset(&doc, 0, sizeof(doc));
+}
+
+static int ler_arquivo(const char* caminho, Buffer* b) {
+    FILE* f = fopen(caminho, "rb");
+    if (!f) return 0;
+    char bloco[65536];
+    size_t n;
+    while ((n = fread(bloco, 1, sizeof(bloco), f)) > 0) buffer_anexar(b, bloco, n);
+    fclose(f);
+    if (!b->s) buffer_anexar(b, "", 0);
+    return 1;
+}
+
+// Abre o documento do pedido. Retorna uma mensagem de erro ou NULL.
+static const char* abrir(Pedido* p, int argc, char** argv, Buffer* mensagens) {
+    Buffer texto = {0};
+    if (p->tem_texto) {
+        texto = p->texto;
+        memset(&p->texto, 0, sizeof(p->texto));
+    } else if (!p->nome || !ler_arquivo(p->nome, &texto)) {
+        buffer_liberar(&texto);
+        return "documento sem \"texto\" e sem arquivo \"nome\" legível";
+    }
+
+    // Opções: argv[0] mais as do pedido ou as da linha de comando
+    int n_args = p->tem_args ? p->n_args + 1 : argc;
+    char** args = alocar(NULL, (size_t)(n_args + 1) * sizeof(char*));
+    args[0] = strdup(argv[0]);
+    for (int i = 1; i < n_args; i++) args[i] = strdup(p->tem_args ? p->args[i - 1] : argv[i]);
+    args[n_args] = NULL;
+
+    capturar_stderr();
+    int ok = front->configurar(n_args, args);
+    soltar_stderr(mensagens);
+    if (!ok) {
+        for (int i = 0; i < n_args; i++) free(args[i]);
+        free(args);
+        buffer_liberar(&texto);
+        return "opções inválidas";
+    }
+
+    if (doc.aberto) fechar_documento();
+    doc.aberto = 1;
+    doc.nome = strdup(p->nome ? p->nome : "<documento>");
+    doc.texto = texto;
+    doc.args = args;
+    doc.n_args = n_args;
+    return NULL;
+}
+
+static const char* editar(const Pedido* p) {
+    if (!doc.aberto) return "nenhum documento aberto";
+    if (p->inicio < 0 || p->fim < p->inicio || (unsigned long long)p->fim > doc.texto.n) {
+        return "faixa de edição inválida";
+    }
+    size_t inicio = (size_t)p->inicio, fim = (size_t)p->fim;
+    size_t n_novo = p->texto.n, resto = doc.texto.n - fim;
+    size_t total = inicio + n_novo + resto;
+    if (total + 1 > doc.texto.cap) {
+        doc.texto.cap = total + 1 > 2 * doc.texto.cap ? total + 1 : 2 * doc.texto.cap;
+        doc.texto.s = alocar(doc.texto.s, doc.texto.cap);
+    }
+    memmove(doc.texto.s + inicio + n_novo, doc.texto.s + fim, resto);
+    if (n_novo) memcpy(doc.texto.s + inicio, p->texto.s, n_novo);
+    doc.texto.n = total;
+    doc.texto.s[total] = '\0';
+    return NULL;
+}
+
+static void atender(Pedido* p, int argc, char** argv) {
+    double inicio = agora_ms();
+    Resultado r;
+    const char* erro = NULL;
+    memset(&r, 0, sizeof(r));
+
+    if (!p->metodo) {
+        erro = "pedido sem \"metodo\"";
+    } else if (strcmp(p->metodo, "abrir") == 0) {
+        erro = abrir(p, argc, argv, &r.diagnosticos);
+    } else if (strcmp(p->metodo, "editar") == 0) {
+        erro = editar(p);
+    } else if (strcmp(p->metodo, "fechar") == 0) {
+        if (doc.aberto) fechar_documento();
+        printf("{\"id\": %s, \"ok\": true}\n", p->id ? p->id : "null");
+        fflush(stdout);
+        return;
+    } else {
+        erro = "método desconhecido";
+    }
+    if (erro) {
+        // As mensagens das opções inválidas explicam o erro melhor
+        Buffer m = {0};
+        buffer_anexar(&m, erro, strlen(erro));
+        if (r.diagnosticos.n) {
+            buffer_anexar(&m, ": ", 2);
+            buffer_anexar(&m, r.diagnosticos.s, r.diagnosticos.n - (r.diagnosticos.s[r.diagnosticos.n - 1] == '\n'));
+        }
+        responder_erro(p, m.s);
+        buffer_liberar(&m);
+        buffer_liberar(&r.diagnosticos);
+        return;
+    }
+
+    atualizar(&r);
+    char* saida = NULL;
+    size_t n = 0;
+    if (r.ok && p->saida) saida = emitir_documento(&n);
+    responder(p, &r, saida, n, agora_ms() - inicio);
+    free(saida);
+    buffer_liberar(&r.diagnosticos);
+}
+
+int incremental_executar(int argc, char** argv, const FrontEnd* fe) {
+    FILE* captura = tmpfile();
+    if (!captura) {
+        fprintf(stderr, "Erro: não foi possível criar arquivo temporário: %s\n", strerror(errno));
+        return 1;
+    }
+    front = fe;
+    fd_captura = fileno(captura);
+    fd_stderr = dup(STDERR_FILENO);
+
+    char* linha = NULL;
+    size_t cap = 0;
+    ssize_t n;
+    while ((n = getline(&linha, &cap, stdin)) >= 0) {
+        Pedido p;
+        size_t tam = (size_t)n;
+        while (tam > 0 && (linha[tam - 1] == '\n' || linha[tam - 1] == '\r')) tam--;
+        if (tam == 0) continue;
+        if (!ler_pedido(linha, tam, &p)) responder_erro(&p, "JSON inválido");
+        else atender(&p, argc, argv);
+        liberar_pedido(&p);
+    }
+    free(linha);
+    if (doc.aberto) fechar_documento();
+    close(fd_stderr);
+    fclose(captura);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <stddef.h>
+
+// --- Modo incremental ---
+// Para editores e servidores de linguagem: `./compiler --incremental
+// [opções]` mantém um documento aberto e, a cada edição, traduz de novo só
+// os trechos cujo texto mudou. Um trecho é uma definição de função de nível
+// superior (com os comentários e diretivas que a precedem); o HLIR já
+// otimizado de cada trecho fica guardado, indexado pelo texto do trecho e
+// pelas diretivas dos trechos anteriores (que definem as macros em vigor).
+// Um trecho que só mudou de linha é reaproveitado com as posições
+// deslocadas. Trechos com erros ou mensagens são sempre refeitos, para que
+// os diagnósticos saiam com as linhas atuais.
+//
+// Protocolo: um objeto JSON por linha na entrada padrão e uma resposta por
+// linha na saída padrão.
+//   {"id": 1, "metodo": "abrir", "nome": "a.c", "texto": "...", "args": ["--emit=py"]}
+//   {"id": 2, "metodo": "editar", "inicio": 120, "fim": 135, "texto": "x + 1"}
+//   {"id": 3, "metodo": "fechar"}
+// "abrir" lê o arquivo `nome` quando não há "texto"; "args" tem as opções
+// do compilador (padrão: as da linha de comando). "editar" troca os bytes
+// [inicio, fim) do documento por "texto". Com "saida": false a resposta
+// traz só os diagnósticos. Resposta:
+//   {"id": 2, "ok": true, "saida": "...", "diagnosticos": [...], "funcoes": N,
+//    "trechos": T, "reanalisados": R, "reaproveitados": T - R, "ms": 0.42}
+// ou {"id": 2, "ok": false, "erro": "..."} para um pedido inválido.
+
+// Um trecho do documento entregue ao front end
+typedef struct {
+    const char* nome;        // nome do documento (mensagens e #include "...")
+    const char* contexto;    // diretivas dos trechos anteriores
+    size_t      n_contexto;
+    const char* texto;
+    size_t      n;
+    int         linha;       // linha do documento em que o trecho começa
+} TrechoFonte;
+
+// O que o modo incremental precisa do compilador (implementado em parser.y)
+typedef struct {
+    // Confere as opções de um documento; retorna 0 se forem inválidas
+    int  (*configurar)(int argc, char** argv);
+    // Traduz um trecho com as opções do documento; cada função pronta é
+    // entregue a incremental_guardar_funcao(). Retorna 0 em erro.
+    int  (*traduzir)(int argc, char** argv, const TrechoFonte* trecho);
+    // Emissão do artefato: início, uma função (escreve as quádruplas
+    // correntes sem liberá-las) e fim
+    void (*iniciar)(void);
+    void (*emitir)(void);
+    void (*finalizar)(void);
+} FrontEnd;
+
+// Atende pedidos até o fim da entrada padrão
+int  incremental_executar(int argc, char** argv, const FrontEnd* fe);
+
+// Guarda as quádruplas correntes (uma função inteira) no trecho em tradução
+void incremental_guardar_funcao(void);
+
+#endif
@@ -3,65 +3,217 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <limits.h>
 
 #include "tabela.h"
 #include "codegen.h" // Incluir header da geração de código
+#include "preproc.h"
+#include "servidor.h"
+#include "incremental.h"
+#include "saida.h"
+#include "pygen.h"
+#include "pycgen.h"
+#include "hlirbin.h"
+#include "desenrolar.h"
+#include "simplificar.h"
+#include "eliminar.h"
+#include "biblioteca.h"
 
-NoAST* raizAST = NULL;
 int yylex(void);
+void lexer_reiniciar(void);
 void yyerror(const char *s);
+static void traduzirFuncao(NoAST* funcao);
+
+// Laços abertos no ponto da análise: break/continue só valem dentro de um
+static int lacos_abertos = 0;
+
+// Copia a posição inicial de um símbolo da gramática (@n) para o nó da AST
+#define MARCAR(no, loc) marcarPosicao((no), (loc).first_line, (loc).first_column)
+
+// Tipo numérico (inteiro de qualquer largura ou ponto flutuante)?
+static int numerico(const char* tipo) {
+    return tipo && tipoAritmetico(tipoDadoDeNome(tipo));
+}
 
 // Função auxiliar para verificar compatibilidade de tipos aritméticos
-// Retorna o tipo resultante ("int", "float") ou "erro"
+// Retorna o tipo resultante (conversões aritméticas usuais do C) ou "erro"
 const char* check_arithmetic_types(const char* type1, const char* type2, const char* op) {
     if (!type1 || !type2 || strcmp(type1, "erro") == 0 || strcmp(type2, "erro") == 0) {
         return "erro"; // Propaga erro
     }
-    if (strcmp(type1, "int") == 0 && strcmp(type2, "int") == 0) {
-        return "int";
-    }
-    if ((strcmp(type1, "float") == 0 || strcmp(type1, "int") == 0) && 
-        (strcmp(type2, "float") == 0 || strcmp(type2, "int") == 0)) {
-        // Permitir int/float misturado, resultado é float
-        // Exceto para MOD, que exige ints
-        if (strcmp(op, "%") == 0) {
-             if (strcmp(type1, "int") == 0 && strcmp(type2, "int") == 0) {
-                 return "int";
-             } else {
-                 fprintf(stderr, "Erro Semântico: Operador '%%' requer operandos inteiros, obteve '%s' e '%s'.\n", type1, type2);
-                 return "erro";
-             }
+    if (numerico(type1) && numerico(type2)) {
+        TipoDadoCG t1 = tipoDadoDeNome(type1), t2 = tipoDadoDeNome(type2);
+        // MOD exige inteiros
+        if (strcmp(op, "%") == 0 && (!tipoInteiro(t1) || !tipoInteiro(t2))) {
+            fprintf(stderr, "Erro Semântico: Operador '%%' requer operandos inteiros, obteve '%s' e '%s'.\n", type1, type2);
+            return "erro";
         }
-        return "float"; 
+        return nomeTipoDado(tipoComum(t1, t2));
     }
     fprintf(stderr, "Erro Semântico: Tipos incompatíveis para operador '%s': '%s' e '%s'.\n", op, type1, type2);
     return "erro";
 }
 
+// Operadores bit a bit e deslocamentos: só inteiros. O deslocamento tem o
+// tipo do operando da esquerda (promovido); os demais, o tipo comum.
+const char* check_integer_types(const char* type1, const char* type2, const char* op) {
+    if (!type1 || !type2 || strcmp(type1, "erro") == 0 || strcmp(type2, "erro") == 0) {
+        return "erro"; // Propaga erro
+    }
+    TipoDadoCG t1 = tipoDadoDeNome(type1), t2 = tipoDadoDeNome(type2);
+    if (tipoInteiro(t1) && tipoInteiro(t2)) {
+        if (strcmp(op, "<<") == 0 || strcmp(op, ">>") == 0) return nomeTipoDado(tipoPromovido(t1));
+        return nomeTipoDado(tipoComum(t1, t2));
+    }
+    fprintf(stderr, "Erro Semântico: Operador '%s' requer operandos inteiros, obteve '%s' e '%s'.\n", op, type1, type2);
+    return "erro";
+}
+
 // Função auxiliar para verificar compatibilidade de tipos para comparação/lógicos
 // Retorna "int" (para booleano) se compatível, senão "erro"
 const char* check_comparison_logical_types(const char* type1, const char* type2, const char* op) {
     if (!type1 || !type2 || strcmp(type1, "erro") == 0 || strcmp(type2, "erro") == 0) {
         return "erro"; // Propaga erro
     }
-    // Permitir comparação entre int e float
-    if ((strcmp(type1, "int") == 0 || strcmp(type1, "float") == 0) && 
-        (strcmp(type2, "int") == 0 || strcmp(type2, "float") == 0)) {
+    // Qualquer par de tipos numéricos (convertidos para o tipo comum)
+    if (numerico(type1) && numerico(type2)) {
         return "int"; // Resultado de comparação é booleano (int em C)
     }
-    // Poderia adicionar comparação de char aqui se necessário
     fprintf(stderr, "Erro Semântico: Tipos incompatíveis para operador '%s': '%s' e '%s'.\n", op, type1, type2);
     return "erro";
 }
 
+// Especificadores de tipo de uma declaração, somados: um bit para cada um e
+// a contagem de `long` a partir de ESPEC_LONG (-1: repetido ou inválido)
+enum {
+    ESPEC_VOID = 1, ESPEC_CHAR = 2, ESPEC_SHORT = 4, ESPEC_INT = 8,
+    ESPEC_SIGNED = 16, ESPEC_UNSIGNED = 32, ESPEC_FLOAT = 64, ESPEC_DOUBLE = 128,
+    ESPEC_LONG = 256
+};
+
+static int juntarEspecificadores(int a, int b) {
+    if (a < 0 || b < 0 || (a & b & (ESPEC_LONG - 1)) || (a / ESPEC_LONG) + (b / ESPEC_LONG) > 2) return -1;
+    return a + b;
+}
+
+// Nome canônico do tipo (o tipoDado da AST), ou NULL se a combinação não
+// for válida em C. `long double` é tratado como double.
+static const char* tipoDeEspecificadores(int e) {
+    if (e < 0) return NULL;
+    int longs = e / ESPEC_LONG, sinal = e & (ESPEC_SIGNED | ESPEC_UNSIGNED);
+    int sem_sinal = e & ESPEC_UNSIGNED;
+    if (sinal == (ESPEC_SIGNED | ESPEC_UNSIGNED)) return NULL;
+    switch (e & (ESPEC_LONG - 1) & ~(ESPEC_SIGNED | ESPEC_UNSIGNED)) {
+        case ESPEC_VOID:   return longs || sinal ? NULL : "void";
+        case ESPEC_FLOAT:  return longs || sinal ? NULL : "float";
+        case ESPEC_DOUBLE: return longs > 1 || sinal ? NULL : "double";
+        case ESPEC_CHAR:
+            if (longs) return NULL;
+            return sem_sinal ? "unsigned char" : sinal ? "signed char" : "char";
+        case ESPEC_SHORT:
+        case ESPEC_SHORT | ESPEC_INT:
+            if (longs) return NULL;
+            return sem_sinal ? "unsigned short" : "short";
+        case 0:
+            // `unsigned`, `long`... sem int
+            if (!longs && !sinal) return NULL;
+            /* fallthrough */
+        case ESPEC_INT:
+            if (longs == 2) return sem_sinal ? "unsigned long long" : "long long";
+            if (longs == 1) return sem_sinal ? "unsigned long" : "long";
+            return sem_sinal ? "unsigned int" : "int";
+        default:
+            return NULL;
+    }
+}
+
+// Tipo de um literal numérico: o primeiro da lista do C em que o valor cabe,
+// conforme o sufixo (u, l, ll) e a base. NULL se o literal for inválido.
+static const char* tipoDoLiteral(const char* texto) {
+    if (!strpbrk(texto, "xX") && strpbrk(texto, ".eE")) {
+        char c = texto[strlen(texto) - 1];
+        return c == 'f' || c == 'F' ? "float" : "double";
+    }
+    char* fim;
+    errno = 0;
+    unsigned long long v = strtoull(texto, &fim, 0);
+    if (errno == ERANGE) return NULL;
+    int u = 0, l = 0;
+    for (; *fim; fim++) {
+        if (*fim == 'u' || *fim == 'U') u++;
+        else if (*fim == 'l' || *fim == 'L') l++;
+        else return NULL;   // ex: dígito 8 ou 9 em octal
+    }
+    int decimal = texto[0] != '0' || texto[1] == '\0';
+    static const TipoDadoCG candidatos[] = { TIPO_INT, TIPO_UINT, TIPO_LONG, TIPO_ULONG, TIPO_LLONG, TIPO_ULLONG };
+    for (int i = l == 2 ? 4 : l == 1 ? 2 : 0; i < 6; i++) {
+        TipoDadoCG t = candidatos[i];
+        // Sem `u`, decimais só têm tipos com sinal (o último recurso é unsigned long long)
+        if (u ? !tipoSemSinal(t) : (decimal && tipoSemSinal(t) && t != TIPO_ULLONG)) continue;
+        unsigned long long maximo = tipoSemSinal(t) ? (bitsTipo(t) == 64 ? ULLONG_MAX : (1ULL << bitsTipo(t)) - 1)
+                                                    : (1ULL << (bitsTipo(t) - 1)) - 1;
+        if (v <= maximo) return nomeTipoDado(t);
+    }
+    return NULL;
+}
+
+// Atribuição permitida: mesmo tipo, entre inteiros (com o ajuste de largura
+// do C) ou de qualquer número para ponto flutuante
+static int atribuivel(const char* var, const char* expr) {
+    TipoDadoCG v = tipoDadoDeNome(var), e = tipoDadoDeNome(expr);
+    if (strcmp(var, expr) == 0) return 1;
+    if (tipoInteiro(v)) return tipoInteiro(e);
+    return tipoFlutuante(v) && tipoAritmetico(e);
+}
+
+// Chamada a uma função da biblioteca padrão (biblioteca.h): o número de
+// argumentos e o tipo de cada um são conferidos como em uma atribuição ao
+// parâmetro. Retorna o nó AST_CALL, com o tipo de retorno, ou NULL em erro
+// (o nó dos argumentos é consumido).
+static NoAST* chamarBiblioteca(const char* nome, NoAST* args) {
+    const FuncaoBiblioteca* f = biblioteca_buscar(nome);
+    NoAST* no = criarNo(AST_CALL, (char*)nome, f ? (char*)nomeTipoDado(f->retorno) : "erro", 0);
+    int erro = 0;
+    if (args) {
+        for (int i = 0; i < args->n_filhos; i++) adicionarFilho(no, args->filhos[i]);
+        liberarNo(args);
+    }
+    if (!f) {
+        fprintf(stderr, "Erro Semântico: Função '%s' não declarada.\n", nome);
+        erro = 1;
+    } else if (no->n_filhos != f->n_args) {
+        fprintf(stderr, "Erro Semântico: Função '%s' espera %d argumento(s), recebeu %d.\n", nome, f->n_args, no->n_filhos);
+        erro = 1;
+    }
+    for (int i = 0; !erro && i < no->n_filhos; i++) {
+        NoAST* a = no->filhos[i];
+        const char* param = nomeTipoDado(f->args[i]);
+        if (!a || !a->tipoDado || strcmp(a->tipoDado, "erro") == 0) {
+            erro = 1; // Propaga erro
+        } else if (f->args[i] == TIPO_STRING ? a->tipo != AST_STRING : !atribuivel(param, a->tipoDado)) {
+            fprintf(stderr, "Erro Semântico: Argumento %d de '%s' deve ser '%s', obteve '%s'.\n", i + 1, nome, param, a->tipoDado);
+            erro = 1;
+        }
+    }
+    if (erro) {
+        liberarAST(no);
+        return NULL;
+    }
+    return no;
+}
 
 %}
 
 %union {
     char* str;
     NoAST* ast;
+    int espec;
 }
 
+/* Posições (linha/coluna) dos tokens, preenchidas pelo lexer em yylloc */
+%locations
+
 
 %start programa
 
@@ -80,19 +232,25 @@ const char* check_comparison_logical_types(const char* type1, const char* type2,
 %token OP_PLUS OP_MINUS OP_MUL OP_DIV
 %token OP_MOD
 %token OP_LT OP_GT OP_BIT_AND OP_BIT_OR OP_BIT_XOR OP_BIT_NOT OP_NOT
+%token OP_SHL OP_SHR
 
 %token SEMICOLON COMMA LPAREN RPAREN LBRACE RBRACE LBRACKET RBRACKET
 
 // CORREÇÃO: Adicionar lista_args e lista_args_opcional ao %type
-%type <ast> programa lista_comandos comando declaracao_var atribuicao print bloco if_else while_loop for_loop do_while_loop expr valor lista_args lista_args_opcional definicao_funcao declarador_funcao corpo_funcao
+%type <ast> lista_comandos comando declaracao_var atribuicao atribuicao_expr print bloco if_else while_loop for_loop do_while_loop expr valor lista_args lista_args_opcional chamada definicao_funcao declarador_funcao corpo_funcao
 %type <str> tipo
+%type <espec> especificadores especificador
 
 /* Precedência e associatividade para expressões */
 %right OP_ASSIGN
 %left OP_OR
 %left OP_AND
+%left OP_BIT_OR
+%left OP_BIT_XOR
+%left OP_BIT_AND
 %left OP_EQ OP_NEQ
 %left OP_LT OP_GT OP_LEQ OP_GEQ
+%left OP_SHL OP_SHR
 %left OP_PLUS OP_MINUS
 %left OP_MUL OP_DIV OP_MOD
 %right OP_NOT OP_BIT_NOT OP_INC OP_DEC /* Unários */
@@ -101,12 +259,20 @@ const char* check_comparison_logical_types(const char* type1, const char* type2,
 %%
 
 programa:
-    definicao_funcao { raizAST = $1; }
+    lista_funcoes
+    ;
+
+/* Cada função é traduzida, emitida e liberada assim que é reduzida: a
+   memória usada depende da maior função, não do arquivo inteiro */
+lista_funcoes:
+    definicao_funcao { traduzirFuncao($1); }
+    | lista_funcoes definicao_funcao { traduzirFuncao($2); }
     ;
 
 definicao_funcao:
     tipo declarador_funcao corpo_funcao {
         $$ = criarNo(AST_FUNC_DEF, $2->valor, $1, 1, $3);
+        MARCAR($$, @1);
         liberarNo($2);
     }
     ;
@@ -155,16 +321,30 @@ lista_comandos:
     ;
 
 comando:
-    declaracao_var { $$ = $1; }
-  | atribuicao { $$ = $1; }
-  | print { $$ = $1; }
+    declaracao_var { $$ = $1; MARCAR($$, @1); }
+  | atribuicao { $$ = $1; MARCAR($$, @1); }
+  | chamada SEMICOLON { $$ = $1; MARCAR($$, @1); } /* Valor descartado */
   | bloco { $$ = $1; }
-  | if_else { $$ = $1; }
-  | while_loop { $$ = $1; }
-  | for_loop { $$ = $1; }
-  | do_while_loop { $$ = $1; }
-  | KW_RETURN expr SEMICOLON { $$ = criarNo(AST_RETURN, NULL, NULL, 1, $2); }
-  | KW_RETURN SEMICOLON { $$ = criarNo(AST_RETURN, NULL, NULL, 0); }
+  | if_else { $$ = $1; MARCAR($$, @1); }
+  | while_loop { $$ = $1; MARCAR($$, @1); }
+  | for_loop { $$ = $1; MARCAR($$, @1); }
+  | do_while_loop { $$ = $1; MARCAR($$, @1); }
+  | KW_RETURN expr SEMICOLON { $$ = criarNo(AST_RETURN, NULL, NULL, 1, $2); MARCAR($$, @1); }
+  | KW_RETURN SEMICOLON { $$ = criarNo(AST_RETURN, NULL, NULL, 0); MARCAR($$, @1); }
+  | KW_BREAK SEMICOLON {
+        if (lacos_abertos == 0) {
+            fprintf(stderr, "Erro Semântico: 'break' fora de um laço.\n");
+            $$ = NULL; YYERROR;
+        }
+        $$ = criarNo(AST_BREAK, NULL, NULL, 0); MARCAR($$, @1);
+    }
+  | KW_CONTINUE SEMICOLON {
+        if (lacos_abertos == 0) {
+            fprintf(stderr, "Erro Semântico: 'continue' fora de um laço.\n");
+            $$ = NULL; YYERROR;
+        }
+        $$ = criarNo(AST_CONTINUE, NULL, NULL, 0); MARCAR($$, @1);
+    }
   | SEMICOLON { $$ = NULL; } /* Comando vazio, não gera nó */
   ;
 
@@ -184,7 +364,12 @@ declaracao_var:
     ;
 
 atribuicao:
-    ID OP_ASSIGN expr SEMICOLON {
+    atribuicao_expr SEMICOLON { $$ = $1; }
+    ;
+
+/* Atribuição sem o ';' final, também usada no incremento do FOR */
+atribuicao_expr:
+    ID OP_ASSIGN expr {
         Simbolo* sim = buscar_simbolo($1);
         if (!sim) {
             fprintf(stderr, "Erro Semântico: Variável '%s' não declarada.\n", $1);
@@ -199,14 +384,13 @@ atribuicao:
              $$ = NULL;
              // YYERROR já deve ter sido chamado
         } else if (strcmp(sim->tipo, $3->tipoDado) != 0) {
-             // Permitir atribuição int -> float
-             if (!(strcmp(sim->tipo, "float") == 0 && strcmp($3->tipoDado, "int") == 0)) {
+             // Entre inteiros e de número para ponto flutuante (a conversão
+             // fica por conta da geração de código)
+             if (!atribuivel(sim->tipo, $3->tipoDado)) {
                 fprintf(stderr, "Erro Semântico: Atribuição incompatível. Variável '%s' é '%s', mas expressão é '%s'.\n", $1, sim->tipo, $3->tipoDado);
                 $$ = NULL;
                 YYERROR;
              } else {
-                 // Permitido int -> float, continua
-                 // printf("[ATRIB] %s = ... (com coerção int->float)\n", $1);
                  $$ = criarNo(AST_ATRIB, sim->nome, sim->tipo, 1, $3);
              }
         } else {
@@ -218,26 +402,55 @@ atribuicao:
     ;
 
 
+/* printf e as funções que recebem um literal de string (puts) */
 print:
-    ID LPAREN STRING lista_args_opcional RPAREN SEMICOLON {
+    ID LPAREN STRING lista_args_opcional RPAREN {
         NoAST* format_str_node = criarNo(AST_STRING, $3, "string", 0);
         free($3);  // libera a strdup feita em yylex
         NoAST* args_node       = $4;
         
-        // Inicializa AST_PRINT com apenas 1 filho (a string)
-        $$ = criarNo(AST_PRINT, NULL, NULL, 1, format_str_node);
+        if (strcmp($1, "printf") == 0) {
+            // Inicializa AST_PRINT com apenas 1 filho (a string)
+            $$ = criarNo(AST_PRINT, NULL, NULL, 1, format_str_node);
 
-        // Para cada argumento extra, expande o vetor corretamente
-        if (args_node) {
-            for (int i = 0; i < args_node->n_filhos; i++) {
-                adicionarFilho($$, args_node->filhos[i]);
+            // Para cada argumento extra, expande o vetor corretamente
+            if (args_node) {
+                for (int i = 0; i < args_node->n_filhos; i++) {
+                    adicionarFilho($$, args_node->filhos[i]);
+                }
+                liberarNo(args_node);
+            }
+        } else {
+            // Outra função com um literal de string (ex: puts): chamada da biblioteca
+            NoAST* todos = criarNo(AST_LISTA_ARGS, NULL, NULL, 1, format_str_node);
+            if (args_node) {
+                for (int i = 0; i < args_node->n_filhos; i++) {
+                    adicionarFilho(todos, args_node->filhos[i]);
+                }
+                liberarNo(args_node);
             }
-            liberarNo(args_node);
+            $$ = chamarBiblioteca($1, todos);
         }
         free($1);
+        if (!$$) YYERROR;
     }
 ;
 
+/* Chamada a uma função da biblioteca padrão (sqrt, abs, rand...) */
+chamada:
+    ID LPAREN RPAREN {
+        $$ = chamarBiblioteca($1, NULL);
+        free($1);
+        if (!$$) YYERROR;
+    }
+    | ID LPAREN lista_args RPAREN {
+        $$ = $3 ? chamarBiblioteca($1, $3) : NULL;
+        free($1);
+        if (!$$) YYERROR;
+    }
+    | print { $$ = $1; }
+    ;
+
 
 // CORREÇÃO: Nova regra para lista opcional de argumentos (inicia com vírgula)
 lista_args_opcional:
@@ -277,7 +490,7 @@ if_else:
         if (!$3 || strcmp($3->tipoDado, "erro") == 0) {
              // fprintf(stderr, "Erro Semântico: Condição do IF inválida.\n");
              $$ = NULL; // YYERROR já chamado
-        } else if (strcmp($3->tipoDado, "int") != 0 && strcmp($3->tipoDado, "float") != 0) { // Condição deve ser numérica (ou booleana)
+        } else if (!numerico($3->tipoDado)) { // Condição deve ser numérica (ou booleana)
              fprintf(stderr, "Erro Semântico: Condição do IF deve ser numérica ou booleana, obteve '%s'.\n", $3->tipoDado);
              $$ = NULL; YYERROR;
         } else if (!$5 && $5 != NULL) { // Comando pode ser NULL (;) mas não inválido
@@ -291,7 +504,7 @@ if_else:
          if (!$3 || strcmp($3->tipoDado, "erro") == 0) {
              // fprintf(stderr, "Erro Semântico: Condição do IF-ELSE inválida.\n");
              $$ = NULL; // YYERROR já chamado
-         } else if (strcmp($3->tipoDado, "int") != 0 && strcmp($3->tipoDado, "float") != 0) {
+         } else if (!numerico($3->tipoDado)) {
              fprintf(stderr, "Erro Semântico: Condição do IF-ELSE deve ser numérica ou booleana, obteve '%s'.\n", $3->tipoDado);
              $$ = NULL; YYERROR;
          } else if ((!$5 && $5 != NULL) || (!$7 && $7 != NULL)) { // Verifica corpos
@@ -304,12 +517,18 @@ if_else:
     ;
 
 
+/* Abrem o laço antes da análise do corpo (break/continue) */
+inicio_while: KW_WHILE { lacos_abertos++; } ;
+inicio_for: KW_FOR { lacos_abertos++; } ;
+inicio_do: KW_DO { lacos_abertos++; } ;
+
 while_loop:
-    KW_WHILE LPAREN expr RPAREN comando {
+    inicio_while LPAREN expr RPAREN comando {
+        lacos_abertos--;
         if (!$3 || strcmp($3->tipoDado, "erro") == 0) {
              // fprintf(stderr, "Erro Semântico: Condição do WHILE inválida.\n");
              $$ = NULL; // YYERROR já chamado
-        } else if (strcmp($3->tipoDado, "int") != 0 && strcmp($3->tipoDado, "float") != 0) {
+        } else if (!numerico($3->tipoDado)) {
              fprintf(stderr, "Erro Semântico: Condição do WHILE deve ser numérica ou booleana, obteve '%s'.\n", $3->tipoDado);
              $$ = NULL; YYERROR;
         } else if (!$5 && $5 != NULL) {
@@ -323,17 +542,20 @@ while_loop:
 
 
 for_loop: /* Simplificado - apenas estrutura, semântica básica */
-    KW_FOR LPAREN atribuicao expr SEMICOLON atribuicao RPAREN comando {
+    inicio_for LPAREN atribuicao expr SEMICOLON atribuicao_expr RPAREN comando {
+        lacos_abertos--;
         // Verificações semânticas mais detalhadas podem ser adicionadas aqui
         // para $3 (init), $4 (cond), $6 (incr)
         if (!$3 || !$4 || !$6 || !$8 || strcmp($4->tipoDado, "erro") == 0) {
              fprintf(stderr, "Erro Semântico: Componente inválido no FOR.\n");
              $$ = NULL; YYERROR;
-        } else if (strcmp($4->tipoDado, "int") != 0 && strcmp($4->tipoDado, "float") != 0) {
+        } else if (!numerico($4->tipoDado)) {
              fprintf(stderr, "Erro Semântico: Condição do FOR deve ser numérica ou booleana, obteve '%s'.\n", $4->tipoDado);
              $$ = NULL; YYERROR;
         } else {
             // printf("[FOR]\n");
+            MARCAR($3, @3);
+            MARCAR($6, @6);
             $$ = criarNo(AST_FOR, NULL, NULL, 4, $3, $4, $6, $8);
         }
     }
@@ -341,17 +563,19 @@ for_loop: /* Simplificado - apenas estrutura, semântica básica */
 
 
 do_while_loop:
-    KW_DO comando KW_WHILE LPAREN expr RPAREN SEMICOLON {
+    inicio_do comando KW_WHILE LPAREN expr RPAREN SEMICOLON {
+        lacos_abertos--;
         if (!$5 || strcmp($5->tipoDado, "erro") == 0) {
              // fprintf(stderr, "Erro Semântico: Condição do DO-WHILE inválida.\n");
              $$ = NULL; // YYERROR já chamado
-        } else if (strcmp($5->tipoDado, "int") != 0 && strcmp($5->tipoDado, "float") != 0) {
+        } else if (!numerico($5->tipoDado)) {
              fprintf(stderr, "Erro Semântico: Condição do DO-WHILE deve ser numérica ou booleana, obteve '%s'.\n", $5->tipoDado);
              $$ = NULL; YYERROR;
         } else if (!$2 && $2 != NULL) {
              $$ = NULL; // Erro no corpo
         } else {
             // printf("[DO_WHILE]\n");
+            MARCAR($5, @5); // A condição é avaliada na linha do "while"
             $$ = criarNo(AST_DO_WHILE, NULL, NULL, 2, $2, $5);
         }
     }
@@ -437,48 +661,115 @@ expr:
           if (strcmp(tipo_result, "erro") == 0) { $$ = criarNo(AST_EXPR, "||", "erro", 2, $1, $3); YYERROR; }
           else $$ = criarNo(AST_EXPR, "||", (char*)tipo_result, 2, $1, $3);
       }
+    | expr OP_BIT_AND expr {
+          const char* tipo_result = check_integer_types($1->tipoDado, $3->tipoDado, "&");
+          if (strcmp(tipo_result, "erro") == 0) { $$ = criarNo(AST_EXPR, "&", "erro", 2, $1, $3); YYERROR; }
+          else $$ = criarNo(AST_EXPR, "&", (char*)tipo_result, 2, $1, $3);
+      }
+    | expr OP_BIT_OR expr {
+          const char* tipo_result = check_integer_types($1->tipoDado, $3->tipoDado, "|");
+          if (strcmp(tipo_result, "erro") == 0) { $$ = criarNo(AST_EXPR, "|", "erro", 2, $1, $3); YYERROR; }
+          else $$ = criarNo(AST_EXPR, "|", (char*)tipo_result, 2, $1, $3);
+      }
+    | expr OP_BIT_XOR expr {
+          const char* tipo_result = check_integer_types($1->tipoDado, $3->tipoDado, "^");
+          if (strcmp(tipo_result, "erro") == 0) { $$ = criarNo(AST_EXPR, "^", "erro", 2, $1, $3); YYERROR; }
+          else $$ = criarNo(AST_EXPR, "^", (char*)tipo_result, 2, $1, $3);
+      }
+    | expr OP_SHL expr {
+          const char* tipo_result = check_integer_types($1->tipoDado, $3->tipoDado, "<<");
+          if (strcmp(tipo_result, "erro") == 0) { $$ = criarNo(AST_EXPR, "<<", "erro", 2, $1, $3); YYERROR; }
+          else $$ = criarNo(AST_EXPR, "<<", (char*)tipo_result, 2, $1, $3);
+      }
+    | expr OP_SHR expr {
+          const char* tipo_result = check_integer_types($1->tipoDado, $3->tipoDado, ">>");
+          if (strcmp(tipo_result, "erro") == 0) { $$ = criarNo(AST_EXPR, ">>", "erro", 2, $1, $3); YYERROR; }
+          else $$ = criarNo(AST_EXPR, ">>", (char*)tipo_result, 2, $1, $3);
+      }
+    | OP_BIT_NOT expr { /* Complemento bit a bit */
+          if (!$2 || strcmp($2->tipoDado, "erro") == 0) { $$ = criarNo(AST_EXPR, "~", "erro", 1, $2); YYERROR; }
+          else if (!tipoInteiro(tipoDadoDeNome($2->tipoDado))) {
+             fprintf(stderr, "Erro Semântico: Operador '~' requer operando inteiro, obteve '%s'.\n", $2->tipoDado);
+             $$ = criarNo(AST_EXPR, "~", "erro", 1, $2); YYERROR;
+          } else {
+             $$ = criarNo(AST_EXPR, "~", (char*)nomeTipoDado(tipoPromovido(tipoDadoDeNome($2->tipoDado))), 1, $2);
+          }
+      }
     | OP_MINUS expr %prec OP_NOT { /* Unário Menos */
           if (!$2 || strcmp($2->tipoDado, "erro") == 0) { $$ = criarNo(AST_EXPR, "-", "erro", 1, $2); YYERROR; }
-          else if (strcmp($2->tipoDado, "int") != 0 && strcmp($2->tipoDado, "float") != 0) {
+          else if (!numerico($2->tipoDado)) {
              fprintf(stderr, "Erro Semântico: Operador unário '-' requer operando numérico, obteve '%s'.\n", $2->tipoDado);
              $$ = criarNo(AST_EXPR, "-", "erro", 1, $2); YYERROR;
           } else {
-             $$ = criarNo(AST_EXPR, "-", $2->tipoDado, 1, $2);
+             $$ = criarNo(AST_EXPR, "-", (char*)nomeTipoDado(tipoPromovido(tipoDadoDeNome($2->tipoDado))), 1, $2);
           }
       }
     | OP_NOT expr { /* Negação Lógica */
           if (!$2 || strcmp($2->tipoDado, "erro") == 0) { $$ = criarNo(AST_EXPR, "!", "erro", 1, $2); YYERROR; }
-          else if (strcmp($2->tipoDado, "int") != 0 && strcmp($2->tipoDado, "float") != 0) { // Permitir ! em float?
+          else if (!numerico($2->tipoDado)) {
              fprintf(stderr, "Erro Semântico: Operador '!' requer operando numérico/booleano, obteve '%s'.\n", $2->tipoDado);
              $$ = criarNo(AST_EXPR, "!", "erro", 1, $2); YYERROR;
           } else {
              $$ = criarNo(AST_EXPR, "!", "int", 1, $2); // Resultado é booleano (int)
           }
       }
+    | chamada {
+          if ($1->tipo == AST_PRINT || strcmp($1->tipoDado, "void") == 0) {
+             fprintf(stderr, "Erro Semântico: Função '%s' não retorna valor.\n",
+                     $1->tipo == AST_PRINT ? "printf" : $1->valor);
+             liberarAST($1);
+             YYERROR;
+          }
+          $$ = $1;
+      }
     | LPAREN expr RPAREN { $$ = $2; } /* Parênteses */
     ;
 
 valor:
     NUMBER {
-        // Determina se é int ou float
-        if (strchr($1, '.') || strchr($1, 'e') || strchr($1, 'E')) {
-            $$ = criarNo(AST_NUM, $1, "float", 0);
-        } else {
-            $$ = criarNo(AST_NUM, $1, "int", 0);
+        // O tipo vem do sufixo, da base e da grandeza do valor
+        const char* tipo = tipoDoLiteral($1);
+        if (!tipo) {
+            fprintf(stderr, "Erro Léxico: Constante numérica inválida ou grande demais: '%s'.\n", $1);
+            free($1);
+            YYERROR;
         }
+        $$ = criarNo(AST_NUM, $1, (char*)tipo, 0);
         free($1); // Libera memória do número
     }
     | CHAR {
-        $$ = criarNo(AST_CHAR, $1, "char", 0);
+        // Em C, 'a' é um int
+        $$ = criarNo(AST_CHAR, $1, "int", 0);
         free($1); // Libera memória do char
     }
     ;
 
 tipo:
-    KW_INT { $$ = "int"; }
-    | KW_FLOAT { $$ = "float"; }
-    | KW_CHAR { $$ = "char"; }
-    | KW_VOID { $$ = "void"; }
+    especificadores {
+        $$ = (char*)tipoDeEspecificadores($1);
+        if (!$$) {
+            fprintf(stderr, "Erro Semântico: Combinação inválida de especificadores de tipo.\n");
+            YYERROR;
+        }
+    }
+    ;
+
+/* int, unsigned long long, short int, long double... em qualquer ordem */
+especificadores:
+    especificador { $$ = $1; }
+    | especificadores especificador { $$ = juntarEspecificadores($1, $2); }
+    ;
+
+especificador:
+    KW_VOID       { $$ = ESPEC_VOID; }
+    | KW_CHAR     { $$ = ESPEC_CHAR; }
+    | KW_SHORT    { $$ = ESPEC_SHORT; }
+    | KW_INT      { $$ = ESPEC_INT; }
+    | KW_LONG     { $$ = ESPEC_LONG; }
+    | KW_SIGNED   { $$ = ESPEC_SIGNED; }
+    | KW_UNSIGNED { $$ = ESPEC_UNSIGNED; }
+    | KW_FLOAT    { $$ = ESPEC_FLOAT; }
+    | KW_DOUBLE   { $$ = ESPEC_DOUBLE; }
     ;
 
 %%
@@ -488,30 +779,361 @@ void yyerror(const char *s) {
     fprintf(stderr, "Erro (Linha %d): %s\n", yylineno, s);
 }
 
-// Função principal (exemplo)
-int main(void) {
-    inicializar_tabela();
-    printf("Iniciando análise...\n");
-    if (yyparse() == 0) {
-        printf("Análise sintática concluída com sucesso.\n");
-        if (raizAST) {
-            printf("\n---- Árvore Sintática Abstrata (AST) ----\n");
-            imprimirAST(raizAST, 0);
-            printf("----------------------------------------\n");
-            
-            // Geração de Código Intermediário
-            gerarCodigo(raizAST);
-            imprimirCodigoIntermediario();
-            liberarCodigoIntermediario(); // Libera memória das quádruplas
-
-            liberarAST(raizAST); // Libera memória da AST
+static void uso(const char* prog) {
+    fprintf(stderr, "Uso: %s [opções] [arquivo.c]\n", prog);
+    fprintf(stderr, "       %s --servir [socket] [--workers N]\n", prog);
+    fprintf(stderr, "       %s --incremental [opções]\n", prog);
+    fprintf(stderr, "  -I dir               adiciona um diretório de busca de #include\n");
+    fprintf(stderr, "  -D NOME[=valor]      define uma macro\n");
+    fprintf(stderr, "  --emit=ast|hlir|py|pyc|json|bin\n");
+    fprintf(stderr, "                       artefato gerado (padrão: hlir)\n");
+    fprintf(stderr, "  --desenrolar=N       desenrola laços contados N vezes (padrão: %d; 1 = só os\n", DESENROLAR_FATOR_PADRAO);
+    fprintf(stderr, "                       de poucas iterações, que viram código reto; 0 desliga)\n");
+    fprintf(stderr, "  --simplificar=0|1    simplificação algébrica e redução de força (padrão: 1)\n");
+    fprintf(stderr, "  --eliminar=0|1       elimina código inalcançável e escritas mortas (padrão: 1)\n");
+    fprintf(stderr, "  --float32=0|1        arredonda a aritmética float para 32 bits, como o C (padrão: 0,\n");
+    fprintf(stderr, "                       float calculado como double)\n");
+    fprintf(stderr, "  --ligar=0|1          liga as funções da biblioteca (sqrt, rand...) a variáveis\n");
+    fprintf(stderr, "                       locais no início de cada função do Python (padrão: 1)\n");
+    fprintf(stderr, "  -o arquivo           escreve o artefato em `arquivo` (padrão: saída padrão)\n");
+    fprintf(stderr, "  -v                   mensagens de progresso em stderr\n");
+    fprintf(stderr, "  Sem arquivo, o código C é lido da entrada padrão. Um arquivo gerado com\n");
+    fprintf(stderr, "  --emit=bin também é aceito como entrada, sem passar pelo front end.\n");
+    fprintf(stderr, "  Com --servir, o compilador fica residente atendendo o programa `cliente`\n");
+    fprintf(stderr, "  (socket padrão: %s).\n", SERVIDOR_SOCKET_PADRAO);
+    fprintf(stderr, "  Com --incremental, pedidos JSON (um por linha) na entrada padrão abrem e\n");
+    fprintf(stderr, "  editam um documento, e só as funções alteradas são traduzidas de novo.\n");
+}
+
+// Artefato escrito por uma tradução (--emit)
+typedef enum {
+    EMITIR_AST,     // árvore sintática (sem endereços de memória)
+    EMITIR_HLIR,    // quádruplas em texto (entrada de quad_to_python.py)
+    EMITIR_PY,      // programa Python
+    EMITIR_PYC,     // bytecode do CPython 3.11 (pycgen.h), sem o .py
+    EMITIR_JSON,    // quádruplas em JSON, para ferramentas
+    EMITIR_BIN      // HLIR binário (hlirbin.h), relido sem o front end
+} Emissao;
+
+typedef struct {
+    Emissao     emitir;
+    const char* saida;      // -o (NULL = saída padrão)
+    const char* arquivo;    // fonte C (NULL = entrada padrão)
+    int         desenrolar; // fator de desenrolamento de laços (desenrolar.h)
+    int         simplificar;// simplificação algébrica (simplificar.h)
+    int         eliminar;   // eliminação de código morto (eliminar.h)
+    int         float32;    // emulação do float de 32 bits (codegen.h)
+    int         ligar;      // ligações da biblioteca em variáveis locais (biblioteca.h)
+    int         verboso;
+    int         incremental;// funções prontas ficam com o modo incremental
+} Opcoes;
+
+// Lê a linha de comando; -I/-D vão direto para o pré-processador.
+// Retorna 0 se houver opção inválida.
+static int lerOpcoes(int argc, char** argv, Opcoes* op) {
+    memset(op, 0, sizeof(*op));
+    op->emitir = EMITIR_HLIR;
+    op->desenrolar = DESENROLAR_FATOR_PADRAO;
+    op->simplificar = 1;
+    op->eliminar = 1;
+    op->ligar = 1;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strncmp(arg, "-I", 2) == 0 || strncmp(arg, "-D", 2) == 0 || strncmp(arg, "-o", 2) == 0) {
+            const char* valor = arg[2] ? arg + 2 : (i + 1 < argc ? argv[++i] : NULL);
+            if (!valor) return 0;
+            if (arg[1] == 'I') preproc_adicionar_caminho(valor);
+            else if (arg[1] == 'D') preproc_definir(valor);
+            else op->saida = valor;
+        } else if (strncmp(arg, "--emit", 6) == 0 && (arg[6] == '=' || arg[6] == '\0')) {
+            const char* valor = arg[6] ? arg + 7 : (i + 1 < argc ? argv[++i] : "");
+                 if (strcmp(valor, "ast") == 0)  op->emitir = EMITIR_AST;
+            else if (strcmp(valor, "hlir") == 0) op->emitir = EMITIR_HLIR;
+            else if (strcmp(valor, "py") == 0)   op->emitir = EMITIR_PY;
+            else if (strcmp(valor, "pyc") == 0)  op->emitir = EMITIR_PYC;
+            else if (strcmp(valor, "json") == 0) op->emitir = EMITIR_JSON;
+            else if (strcmp(valor, "bin") == 0)  op->emitir = EMITIR_BIN;
+            else {
+                fprintf(stderr, "Erro: valor inválido para --emit: '%s'\n", valor);
+                return 0;
+            }
+        } else if (strncmp(arg, "--desenrolar=", 13) == 0) {
+            char* fim;
+            long fator = strtol(arg + 13, &fim, 10);
+            if (arg[13] == '\0' || *fim != '\0' || fator < 0 || fator > 64) {
+                fprintf(stderr, "Erro: valor inválido para --desenrolar: '%s'\n", arg + 13);
+                return 0;
+            }
+            op->desenrolar = (int)fator;
+        } else if (strncmp(arg, "--simplificar=", 14) == 0) {
+            if (strcmp(arg + 14, "0") != 0 && strcmp(arg + 14, "1") != 0) {
+                fprintf(stderr, "Erro: valor inválido para --simplificar: '%s'\n", arg + 14);
+                return 0;
+            }
+            op->simplificar = arg[14] == '1';
+        } else if (strncmp(arg, "--eliminar=", 11) == 0) {
+            if (strcmp(arg + 11, "0") != 0 && strcmp(arg + 11, "1") != 0) {
+                fprintf(stderr, "Erro: valor inválido para --eliminar: '%s'\n", arg + 11);
+                return 0;
+            }
+            op->eliminar = arg[11] == '1';
+        } else if (strncmp(arg, "--float32=", 10) == 0) {
+            if (strcmp(arg + 10, "0") != 0 && strcmp(arg + 10, "1") != 0) {
+                fprintf(stderr, "Erro: valor inválido para --float32: '%s'\n", arg + 10);
+                return 0;
+            }
+            op->float32 = arg[10] == '1';
+        } else if (strncmp(arg, "--ligar=", 8) == 0) {
+            if (strcmp(arg + 8, "0") != 0 && strcmp(arg + 8, "1") != 0) {
+                fprintf(stderr, "Erro: valor inválido para --ligar: '%s'\n", arg + 8);
+                return 0;
+            }
+            op->ligar = arg[8] == '1';
+        } else if (strcmp(arg, "-v") == 0) {
+            op->verboso = 1;
+        } else if (arg[0] == '-') {
+            return 0;
         } else {
-            printf("(Nenhuma AST gerada - possivelmente entrada vazia ou erro fatal)\n");
+            op->arquivo = arg;
+        }
+    }
+    return 1;
+}
+
+// Tradução em andamento (o parser chama traduzirFuncao durante yyparse)
+static const Opcoes* traducao = NULL;
+
+static void iniciarEmissao(const Opcoes* op) {
+    ligar_biblioteca = op->ligar;
+    switch (op->emitir) {
+        case EMITIR_AST:  saida_texto("---- Árvore Sintática Abstrata (AST) ----\n"); break;
+        case EMITIR_PY:   gerarPythonInicio(); break;
+        case EMITIR_PYC:  gerarPycInicio(op->arquivo); break;
+        case EMITIR_JSON: imprimirCabecalhoHLIR(1); break;
+        case EMITIR_BIN:  hlirbin_iniciar(); break;
+        default:          imprimirCabecalhoHLIR(0); break;
+    }
+}
+
+static void finalizarEmissao(const Opcoes* op) {
+    switch (op->emitir) {
+        case EMITIR_AST:  saida_texto("----------------------------------------\n"); break;
+        case EMITIR_PY:   gerarPythonFim(); break;
+        case EMITIR_PYC:  gerarPycFim(); break;
+        case EMITIR_JSON: imprimirRodapeHLIR(1); break;
+        case EMITIR_BIN:  hlirbin_finalizar(); break;
+        default:          imprimirRodapeHLIR(0); break;
+    }
+}
+
+// Escreve as quádruplas correntes (uma função) no formato pedido
+static void escreverQuadruplas(const Opcoes* op) {
+    switch (op->emitir) {
+        case EMITIR_PY:   gerarPython(); break;
+        case EMITIR_PYC:  gerarPyc(); break;
+        case EMITIR_JSON: imprimirCodigoIntermediarioJSON(); break;
+        case EMITIR_BIN:  hlirbin_escrever_funcao(); break;
+        default:          imprimirCodigoIntermediario(); break;
+    }
+}
+
+// Escreve as quádruplas correntes e as libera
+static void emitirQuadruplas(const Opcoes* op) {
+    escreverQuadruplas(op);
+    liberarCodigoIntermediario(); // Libera memória das quádruplas
+}
+
+// Chamada pelo parser a cada definição de função completa: gera o código
+// intermediário da função, escreve o artefato pedido e libera a AST e as
+// quádruplas antes de seguir para a próxima. As variáveis declaradas
+// pertencem à função, então a tabela de símbolos recomeça vazia.
+static void traduzirFuncao(NoAST* funcao) {
+    if (funcao && preproc_erros() == 0) {
+        if (traducao->emitir == EMITIR_AST) {
+            imprimirAST(funcao, 0);
+        } else {
+            emular_float32 = traducao->float32;
+            gerarCodigo(funcao);
+            if (traducao->simplificar) {
+                int simplificadas = simplificarCodigo();
+                if (traducao->verboso && simplificadas > 0) {
+                    fprintf(stderr, "Função '%s': %d quádrupla(s) simplificada(s).\n", funcao->valor, simplificadas);
+                }
+            }
+            int desenrolados = desenrolarLacos(traducao->desenrolar);
+            if (traducao->verboso && desenrolados > 0) {
+                fprintf(stderr, "Função '%s': %d laço(s) desenrolado(s).\n", funcao->valor, desenrolados);
+            }
+            if (traducao->eliminar) {
+                int eliminadas = eliminarCodigoMorto();
+                if (traducao->verboso && eliminadas > 0) {
+                    fprintf(stderr, "Função '%s': %d quádrupla(s) eliminada(s).\n", funcao->valor, eliminadas);
+                }
+            }
+            if (traducao->incremental) incremental_guardar_funcao();
+            else emitirQuadruplas(traducao);
+        }
+        if (traducao->verboso) fprintf(stderr, "Função '%s' traduzida.\n", funcao->valor);
+    }
+    liberarAST(funcao); // Libera memória da AST
+    liberar_tabela();
+    inicializar_tabela();
+}
+
+// Entrada já em HLIR binário: cada função é carregada do mapa e entregue
+// aos mesmos backends, sem pré-processador, lexer nem parser.
+static int traduzirBinario(const Opcoes* op) {
+    HlirArquivo arq;
+    if (op->emitir == EMITIR_AST) {
+        fprintf(stderr, "Erro: '%s' é HLIR binário; --emit=ast requer o fonte C.\n", op->arquivo);
+        return 1;
+    }
+    if (!hlirbin_abrir(op->arquivo, &arq)) return 1;
+    if (!saida_abrir(op->saida)) { hlirbin_fechar(&arq); return 1; }
+
+    iniciarEmissao(op);
+    for (uint32_t i = 0; i < arq.rodape->n_funcoes; i++) {
+        if (!hlirbin_carregar_funcao(&arq, i)) {
+            liberarCodigoIntermediario();
+            hlirbin_fechar(&arq);
+            saida_descartar();
+            return 1;
         }
+        emitirQuadruplas(op);
+    }
+    finalizarEmissao(op);
+    if (op->verboso) {
+        fprintf(stderr, "%u funções lidas do HLIR binário.\n", (unsigned)arq.rodape->n_funcoes);
+    }
+    hlirbin_fechar(&arq);
+    return saida_fechar() ? 0 : 1;
+}
+
+// Traduz uma unidade. Todo o estado global (pré-processador, lexer, tabela
+// de símbolos, AST e quádruplas) é reiniciado aqui, o que permite chamá-la
+// várias vezes no mesmo processo (modo servidor). `entrada`, se não for
+// NULL, substitui a entrada padrão.
+//
+// A saída é aberta antes da análise e recebe cada função assim que ela é
+// traduzida; se a análise falhar, o que ainda não foi escrito é descartado
+// (e o arquivo de -o, removido).
+static int compilar(int argc, char** argv, const char* entrada, size_t n) {
+    Opcoes op;
+    int status = 0;
+
+    preproc_inicializar();
+    if (!lerOpcoes(argc, argv, &op)) {
+        uso(argv[0]);
+        preproc_finalizar();
+        return 1;
+    }
+    if (op.arquivo && hlirbin_reconhecer(op.arquivo)) {
+        preproc_finalizar();
+        return traduzirBinario(&op);
+    }
+    if (op.arquivo) {
+        if (!preproc_abrir_arquivo(op.arquivo)) { preproc_finalizar(); return 1; }
+    } else if (entrada) {
+        preproc_abrir_memoria("<stdin>", entrada, n);
+    } else {
+        preproc_abrir_stream("<stdin>", stdin);
+    }
+    if (!saida_abrir(op.saida)) { preproc_finalizar(); return 1; }
+
+    lexer_reiniciar();
+    inicializar_tabela();
+    lacos_abertos = 0;
+    traducao = &op;
+    iniciarEmissao(&op);
+    if (op.verboso) fprintf(stderr, "Iniciando análise...\n");
+    if (yyparse() == 0 && preproc_erros() == 0) {
+        if (op.verboso) fprintf(stderr, "Análise sintática concluída com sucesso.\n");
+        finalizarEmissao(&op);
+        if (!saida_fechar()) status = 1;
     } else {
         fprintf(stderr, "Erro: Falha na análise sintática.\n");
+        saida_descartar();
+        status = 1;
     }
+    traducao = NULL;
     liberar_tabela();
-    return 0;
+    preproc_finalizar();
+    return status;
 }
 
+// --- Modo incremental (incremental.h) ---
+// Opções do documento aberto, usadas na emissão
+static Opcoes documento;
+
+static int configurarDocumento(int argc, char** argv) {
+    preproc_inicializar();
+    int ok = lerOpcoes(argc, argv, &documento);
+    preproc_finalizar();
+    if (!ok) {
+        fprintf(stderr, "Erro: opção inválida.\n");
+        return 0;
+    }
+    if (documento.emitir == EMITIR_AST || documento.emitir == EMITIR_PYC || documento.emitir == EMITIR_BIN) {
+        fprintf(stderr, "Erro: o modo incremental emite só hlir, py ou json.\n");
+        return 0;
+    }
+    return 1;
+}
+
+// Traduz um trecho do documento. As opções são relidas porque -I e -D
+// vivem no pré-processador, reiniciado a cada trecho.
+static int traduzirTrecho(int argc, char** argv, const TrechoFonte* trecho) {
+    Opcoes op;
+    int ok;
+
+    preproc_inicializar();
+    lerOpcoes(argc, argv, &op);
+    op.incremental = 1;
+    preproc_preparar_contexto(trecho->contexto, trecho->n_contexto);
+    preproc_abrir_trecho(trecho->nome, trecho->texto, trecho->n, trecho->linha);
+    lexer_reiniciar();
+    inicializar_tabela();
+    lacos_abertos = 0;
+    traducao = &op;
+    ok = yyparse() == 0 && preproc_erros() == 0;
+    if (!ok) fprintf(stderr, "Erro: Falha na análise sintática.\n");
+    traducao = NULL;
+    liberar_tabela();
+    preproc_finalizar();
+    return ok;
+}
+
+static void iniciarDocumento(void)   { iniciarEmissao(&documento); }
+static void emitirDocumento(void)    { escreverQuadruplas(&documento); }
+static void finalizarDocumento(void) { finalizarEmissao(&documento); }
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--incremental") == 0) {
+        static const FrontEnd front = {
+            configurarDocumento, traduzirTrecho, iniciarDocumento, emitirDocumento, finalizarDocumento
+        };
+        int status = incremental_executar(argc - 1, argv + 1, &front);
+        preproc_liberar_cache();
+        return status;
+    }
+
+    if (argc > 1 && strcmp(argv[1], "--servir") == 0) {
+        const char* caminho = SERVIDOR_SOCKET_PADRAO;
+        int workers = 0; // 0 = um por CPU
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+                workers = atoi(argv[++i]);
+            } else if (argv[i][0] != '-') {
+                caminho = argv[i];
+            } else {
+                uso(argv[0]);
+                return 1;
+            }
+        }
+        return servidor_executar(caminho, workers, compilar);
+    }
+
+    int status = compilar(argc, argv, NULL, 0);
+    preproc_liberar_cache();
+    return status;
+}
@@ -0,0 +1,1354 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include "preproc.h"
+
+#define MACRO_TABLE_SIZE 4093
+#define CACHE_TABLE_SIZE 211
+#define MAX_PROFUNDIDADE_INCLUDE 64
+#define MAX_ENTRADAS_POR_HEADER 8
+#define MAX_LINHAS_JUNTADAS 64
+
+// --- Texto dinâmico ---
+typedef struct {
+    char*  s;
+    size_t n;
+    size_t cap;
+} Texto;
+
+static void texto_reservar(Texto* t, size_t extra) {
+    if (t->n + extra + 1 <= t->cap) return;
+    size_t cap = t->cap ? t->cap : 256;
+    while (cap < t->n + extra + 1) cap *= 2;
+    t->s = realloc(t->s, cap);
+    if (!t->s) {
+        fprintf(stderr, "Erro: Falha ao alocar memória no pré-processador\n");
+        exit(EXIT_FAILURE);
+    }
+    t->cap = cap;
+}
+
+static void texto_anexar(Texto* t, const char* s, size_t n) {
+    texto_reservar(t, n);
+    memcpy(t->s + t->n, s, n);
+    t->n += n;
+    t->s[t->n] = '\0';
+}
+
+static void texto_anexar_c(Texto* t, char c) { texto_anexar(t, &c, 1); }
+static void texto_anexar_str(Texto* t, const char* s) { texto_anexar(t, s, strlen(s)); }
+static void texto_limpar(Texto* t) { t->n = 0; texto_reservar(t, 0); t->s[0] = '\0'; }
+static void texto_liberar(Texto* t) { free(t->s); t->s = NULL; t->n = t->cap = 0; }
+
+// Hash djb2 (o mesmo da tabela de símbolos) sobre um trecho de texto
+static unsigned int hash_trecho(const char* s, size_t n) {
+    unsigned long h = 5381;
+    for (size_t i = 0; i < n; i++) h = ((h << 5) + h) + (unsigned char)s[i];
+    return (unsigned int)h;
+}
+
+// FNV-1a de 64 bits, usado nas assinaturas de macros e do estado
+static unsigned long long fnv(unsigned long long h, const char* s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        h ^= (unsigned char)s[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+#define FNV_INICIAL 1469598103934665603ULL
+
+static int eh_inicio_id(char c) { return isalpha((unsigned char)c) || c == '_'; }
+static int eh_id(char c)        { return isalnum((unsigned char)c) || c == '_'; }
+
+// --- Macros ---
+typedef struct Macro {
+    char*  nome;
+    int    funcional;   // 1 = macro com parâmetros: NOME(a, b)
+    int    variadica;   // último parâmetro é "..." (__VA_ARGS__)
+    int    n_params;
+    char** params;
+    char*  corpo;
+    unsigned int hash;  // hash do nome (índice na tabela)
+    unsigned long long assinatura;
+    // Referências: a tabela de macros e cada entrada do cache que a define.
+    // Assim o cache reaproveita a macro já interpretada sem copiá-la.
+    int    refs;
+    struct Macro* prox;
+} Macro;
+
+static Macro* macros[MACRO_TABLE_SIZE];
+static int n_macros = 0;
+static int n_macros_funcionais = 0;
+// XOR das assinaturas das macros definidas: muda a cada #define/#undef e
+// identifica o estado das macros na chave do cache.
+static unsigned long long estado_macros = 0;
+
+// --- Fontes (pilha de arquivos em processamento) ---
+typedef struct Dependencia {
+    char*     caminho;
+    long long mtime;
+    long long tamanho;
+} Dependencia;
+
+typedef struct OpMacro {
+    char   tipo;   // 'D' = #define, 'U' = #undef, 'O' = #pragma once
+    char*  texto;  // Nome (U) ou caminho (O)
+    Macro* macro;  // Macro definida (D)
+} OpMacro;
+
+// Entrada do cache de headers. Enquanto o header está sendo processado a
+// mesma estrutura serve de "captura": acumula o texto gerado, as operações
+// sobre macros e as dependências.
+typedef struct EntradaCache {
+    char*     caminho;
+    long long mtime;
+    long long tamanho;
+    unsigned long long estado_entrada;
+    Texto     texto;
+    OpMacro*  ops;
+    size_t    n_ops, cap_ops;
+    Dependencia* deps;
+    size_t    n_deps, cap_deps;
+    char*     guarda;          // macro do include guard, se o arquivo inteiro é protegido
+    int       guarda_estado;   // 0 = início, 1 = dentro do #ifndef, 2 = fechado, -1 = sem guarda
+    int       guarda_nivel;
+    int       valida;
+    struct EntradaCache* prox;
+} EntradaCache;
+
+typedef struct Fonte {
+    char*  nome;
+    char*  dir;            // diretório, para #include "..."
+    FILE*  arquivo;        // NULL para fonte em memória
+    int    fechar;
+    const char* mem;
+    size_t mem_tam, mem_pos;
+    int    linha;          // linhas físicas já lidas
+    int    em_comentario;  // dentro de /* ... */ que atravessa linhas
+    int    nivel_cond;     // profundidade de #if ao entrar no arquivo
+    EntradaCache* captura;
+    struct Fonte* anterior;
+} Fonte;
+
+typedef struct {
+    int ativo;       // as linhas deste ramo são emitidas
+    int tomado;      // algum ramo do #if já foi escolhido
+    int visto_else;
+} Condicional;
+
+static Fonte* topo = NULL;
+static int profundidade = 0;
+static Condicional* conds = NULL;
+static int n_conds = 0, cap_conds = 0;
+static char** caminhos = NULL;
+static int n_caminhos = 0;
+static unsigned long long estado_caminhos = 0;
+static char** once = NULL;   // arquivos com #pragma once já incluídos
+static int n_once = 0;
+static int erros = 0;
+static int silencioso = 0;   // processando o contexto de um trecho
+
+static Texto saida;          // texto pronto, ainda não consumido pelo lexer
+static size_t saida_pos = 0;
+static Texto linha_atual;    // linha lógica em processamento
+static char* fisica = NULL;  // buffer de getline
+static size_t fisica_cap = 0;
+
+// --- Cache de headers ---
+static EntradaCache* cache[CACHE_TABLE_SIZE];
+static int cache_habilitado = 1;
+static unsigned long cache_acertos = 0;
+static unsigned long cache_falhas = 0;
+
+static void erro(const char* msg, const char* detalhe) {
+    if (!silencioso) fprintf(stderr, "Erro (Pré-processador) %s:%d: %s%s%s\n",
+            topo ? topo->nome : "?", topo ? topo->linha : 0,
+            msg, detalhe ? " " : "", detalhe ? detalhe : "");
+    erros++;
+    for (Fonte* f = topo; f; f = f->anterior) {
+        if (f->captura) f->captura->valida = 0;
+    }
+}
+
+// --- Saída ---
+// Todo texto gerado passa por aqui, inclusive para as capturas ativas
+static void emitir(const char* s, size_t n) {
+    texto_anexar(&saida, s, n);
+    for (Fonte* f = topo; f; f = f->anterior) {
+        if (f->captura) texto_anexar(&f->captura->texto, s, n);
+    }
+}
+
+static void emitir_quebras(int n) {
+    for (int i = 0; i < n; i++) emitir("\n", 1);
+}
+
+// Marcador de linha no estilo do cpp: "# N "arquivo"" faz a próxima
+// linha ser a linha N (tratado pelo lexer).
+static void emitir_marcador(int linha, const char* nome) {
+    char buf[64];
+    int n = snprintf(buf, sizeof buf, "# %d \"", linha);
+    emitir(buf, (size_t)n);
+    emitir(nome, strlen(nome));
+    emitir("\"\n", 2);
+}
+
+static void registrar_op(char tipo, const char* texto, Macro* macro) {
+    for (Fonte* f = topo; f; f = f->anterior) {
+        EntradaCache* c = f->captura;
+        if (!c) continue;
+        if (c->n_ops == c->cap_ops) {
+            c->cap_ops = c->cap_ops ? c->cap_ops * 2 : 16;
+            c->ops = realloc(c->ops, c->cap_ops * sizeof(OpMacro));
+        }
+        c->ops[c->n_ops].tipo = tipo;
+        c->ops[c->n_ops].texto = texto ? strdup(texto) : NULL;
+        c->ops[c->n_ops].macro = macro;
+        if (macro) macro->refs++;
+        c->n_ops++;
+    }
+}
+
+static void anexar_dependencia(EntradaCache* c, const char* caminho, long long mtime, long long tamanho) {
+    if (c->n_deps == c->cap_deps) {
+        c->cap_deps = c->cap_deps ? c->cap_deps * 2 : 4;
+        c->deps = realloc(c->deps, c->cap_deps * sizeof(Dependencia));
+    }
+    c->deps[c->n_deps].caminho = strdup(caminho);
+    c->deps[c->n_deps].mtime = mtime;
+    c->deps[c->n_deps].tamanho = tamanho;
+    c->n_deps++;
+}
+
+static void registrar_dependencia(const char* caminho, long long mtime, long long tamanho) {
+    for (Fonte* f = topo; f; f = f->anterior) {
+        if (f->captura) anexar_dependencia(f->captura, caminho, mtime, tamanho);
+    }
+}
+
+// --- Tabela de macros ---
+static Macro* buscar_macro(const char* nome, size_t n) {
+    if (n_macros == 0) return NULL;
+    Macro* m = macros[hash_trecho(nome, n) % MACRO_TABLE_SIZE];
+    for (; m; m = m->prox) {
+        if (strncmp(m->nome, nome, n) == 0 && m->nome[n] == '\0') return m;
+    }
+    return NULL;
+}
+
+static void liberar_macro(Macro* m) {
+    for (int i = 0; i < m->n_params; i++) free(m->params[i]);
+    free(m->params);
+    free(m->nome);
+    free(m->corpo);
+    free(m);
+}
+
+static void soltar_macro(Macro* m) {
+    if (--m->refs == 0) liberar_macro(m);
+}
+
+static int remover_macro(const char* nome, size_t n) {
+    Macro** p = &macros[hash_trecho(nome, n) % MACRO_TABLE_SIZE];
+    for (; *p; p = &(*p)->prox) {
+        Macro* m = *p;
+        if (strncmp(m->nome, nome, n) == 0 && m->nome[n] == '\0') {
+            *p = m->prox;
+            estado_macros ^= m->assinatura;
+            n_macros--;
+            if (m->funcional) n_macros_funcionais--;
+            soltar_macro(m);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void inserir_macro(Macro* m) {
+    m->refs++; // Antes de remover: a redefinição pode ser a própria macro
+    remover_macro(m->nome, strlen(m->nome)); // Redefinição substitui a anterior
+    m->prox = macros[m->hash];
+    macros[m->hash] = m;
+    n_macros++;
+    if (m->funcional) n_macros_funcionais++;
+    estado_macros ^= m->assinatura;
+}
+
+// Interpreta o texto de um #define ("NOME corpo" ou "NOME(a, b) corpo")
+static Macro* definir_macro(const char* def) {
+    const char* p = def;
+    while (*p == ' ' || *p == '\t') p++;
+    if (!eh_inicio_id(*p)) {
+        erro("nome de macro inválido em #define", NULL);
+        return NULL;
+    }
+    const char* ini = p;
+    while (eh_id(*p)) p++;
+
+    Macro* m = calloc(1, sizeof(Macro));
+    m->nome = strndup(ini, (size_t)(p - ini));
+    if (*p == '(') { // Sem espaço antes do '(': macro com parâmetros
+        m->funcional = 1;
+        p++;
+        for (;;) {
+            while (*p == ' ' || *p == '\t') p++;
+            if (*p == ')') { p++; break; }
+            const char* pi = p;
+            if (strncmp(p, "...", 3) == 0) {
+                m->variadica = 1;
+                p += 3;
+                pi = "__VA_ARGS__";
+            } else if (eh_inicio_id(*p)) {
+                while (eh_id(*p)) p++;
+            } else {
+                erro("parâmetro inválido na macro", m->nome);
+                liberar_macro(m);
+                return NULL;
+            }
+            m->params = realloc(m->params, (size_t)(m->n_params + 1) * sizeof(char*));
+            m->params[m->n_params++] = m->variadica ? strdup(pi) : strndup(pi, (size_t)(p - pi));
+            while (*p == ' ' || *p == '\t') p++;
+            if (*p == ',') { p++; continue; }
+            if (*p == ')') { p++; break; }
+            erro("lista de parâmetros mal formada na macro", m->nome);
+            liberar_macro(m);
+            return NULL;
+        }
+    }
+    while (*p == ' ' || *p == '\t') p++;
+    size_t n = strlen(p);
+    while (n > 0 && isspace((unsigned char)p[n - 1])) n--;
+    m->corpo = strndup(p, n);
+
+    unsigned long long h = fnv(FNV_INICIAL, m->nome, strlen(m->nome));
+    h = fnv(h, m->funcional ? "(" : " ", 1);
+    for (int i = 0; i < m->n_params; i++) h = fnv(h, m->params[i], strlen(m->params[i]) + 1);
+    m->assinatura = fnv(h, m->corpo, n + 1);
+    m->hash = hash_trecho(m->nome, strlen(m->nome)) % MACRO_TABLE_SIZE;
+    inserir_macro(m);
+    return m;
+}
+
+static void liberar_macros(void) {
+    for (int i = 0; i < MACRO_TABLE_SIZE; i++) {
+        Macro* m = macros[i];
+        while (m) {
+            Macro* prox = m->prox;
+            soltar_macro(m);
+            m = prox;
+        }
+        macros[i] = NULL;
+    }
+    n_macros = n_macros_funcionais = 0;
+    estado_macros = 0;
+}
+
+// --- Expansão de macros ---
+// Macros em expansão não são expandidas de novo (evita recursão infinita)
+static Macro* em_expansao[256];
+static int n_em_expansao = 0;
+
+static int esta_em_expansao(const Macro* m) {
+    for (int i = 0; i < n_em_expansao; i++) {
+        if (em_expansao[i] == m) return 1;
+    }
+    return 0;
+}
+
+// Fim de um literal de string/caractere que começa em s[i]
+static size_t fim_literal(const char* s, size_t n, size_t i) {
+    char aspas = s[i++];
+    while (i < n && s[i] != aspas) {
+        if (s[i] == '\\' && i + 1 < n) i++;
+        i++;
+    }
+    return i < n ? i + 1 : n;
+}
+
+typedef struct { const char* s; size_t n; } Trecho;
+
+static void expandir(const char* s, size_t n, Texto* out);
+
+static int indice_param(const Macro* m, const char* nome, size_t n) {
+    for (int i = 0; i < m->n_params; i++) {
+        if (strncmp(m->params[i], nome, n) == 0 && m->params[i][n] == '\0') return i;
+    }
+    return -1;
+}
+
+static void apagar_espacos_finais(Texto* t) {
+    while (t->n > 0 && (t->s[t->n - 1] == ' ' || t->s[t->n - 1] == '\t')) t->n--;
+    if (t->s) t->s[t->n] = '\0';
+}
+
+// Substitui os parâmetros no corpo da macro, tratando # e ##
+static void substituir(const Macro* m, const Trecho* args, Texto* out) {
+    const char* c = m->corpo;
+    size_t n = strlen(c), i = 0;
+    int colar = 0; // O próximo token vem depois de ##
+
+    while (i < n) {
+        if (c[i] == '"' || c[i] == '\'') {
+            size_t j = fim_literal(c, n, i);
+            texto_anexar(out, c + i, j - i);
+            i = j;
+            colar = 0;
+        } else if (c[i] == '#' && i + 1 < n && c[i + 1] == '#') {
+            apagar_espacos_finais(out);
+            i += 2;
+            while (i < n && (c[i] == ' ' || c[i] == '\t')) i++;
+            colar = 1;
+        } else if (c[i] == '#' && m->funcional) {
+            size_t j = i + 1;
+            while (j < n && (c[j] == ' ' || c[j] == '\t')) j++;
+            size_t k = j;
+            while (k < n && eh_id(c[k])) k++;
+            int p = indice_param(m, c + j, k - j);
+            if (p < 0) { texto_anexar_c(out, c[i++]); continue; }
+            // Stringificação: #x vira "texto do argumento"
+            texto_anexar_c(out, '"');
+            for (size_t a = 0; a < args[p].n; a++) {
+                char ch = args[p].s[a];
+                if (ch == '"' || ch == '\\') texto_anexar_c(out, '\\');
+                texto_anexar_c(out, ch);
+            }
+            texto_anexar_c(out, '"');
+            i = k;
+            colar = 0;
+        } else if (eh_inicio_id(c[i])) {
+            size_t j = i;
+            while (j < n && eh_id(c[j])) j++;
+            int p = m->funcional ? indice_param(m, c + i, j - i) : -1;
+            if (p < 0) {
+                texto_anexar(out, c + i, j - i);
+            } else {
+                size_t k = j;
+                while (k < n && (c[k] == ' ' || c[k] == '\t')) k++;
+                int antes_de_colar = (k + 1 < n && c[k] == '#' && c[k + 1] == '#');
+                if (colar || antes_de_colar) {
+                    texto_anexar(out, args[p].s, args[p].n); // Operandos de ## não são expandidos
+                } else {
+                    expandir(args[p].s, args[p].n, out);
+                }
+            }
+            i = j;
+            colar = 0;
+        } else {
+            texto_anexar_c(out, c[i++]);
+            colar = 0;
+        }
+    }
+}
+
+static Trecho aparar(const char* s, size_t n) {
+    while (n > 0 && isspace((unsigned char)*s)) { s++; n--; }
+    while (n > 0 && isspace((unsigned char)s[n - 1])) n--;
+    Trecho t = { s, n };
+    return t;
+}
+
+// Lê os argumentos de uma chamada de macro a partir do '(' em s[i].
+// Retorna a posição depois do ')' ou 0 se os parênteses não fecham.
+static size_t ler_argumentos(const Macro* m, const char* s, size_t n, size_t i,
+                             Trecho* args, int* n_args) {
+    int nivel = 0, qtd = 0;
+    size_t ini = ++i;
+    while (i < n) {
+        char c = s[i];
+        if (c == '"' || c == '\'') { i = fim_literal(s, n, i); continue; }
+        if (c == '(') nivel++;
+        else if (c == ')' && nivel > 0) nivel--;
+        else if ((c == ',' && nivel == 0 && !(m->variadica && qtd == m->n_params - 1)) ||
+                 (c == ')' && nivel == 0)) {
+            if (qtd < m->n_params + 1) args[qtd] = aparar(s + ini, i - ini);
+            qtd++;
+            if (c == ')') {
+                *n_args = qtd;
+                return i + 1;
+            }
+            ini = i + 1;
+        }
+        i++;
+    }
+    return 0;
+}
+
+static void expandir(const char* s, size_t n, Texto* out) {
+    size_t i = 0;
+    while (i < n) {
+        char c = s[i];
+        if (c == '"' || c == '\'') {
+            size_t j = fim_literal(s, n, i);
+            texto_anexar(out, s + i, j - i);
+            i = j;
+        } else if (isdigit((unsigned char)c) || (c == '.' && i + 1 < n && isdigit((unsigned char)s[i + 1]))) {
+            // pp-number: sufixos e expoentes não são identificadores
+            size_t j = i + 1;
+            while (j < n && (eh_id(s[j]) || s[j] == '.' ||
+                   ((s[j] == '+' || s[j] == '-') && (s[j - 1] == 'e' || s[j - 1] == 'E')))) j++;
+            texto_anexar(out, s + i, j - i);
+            i = j;
+        } else if (eh_inicio_id(c)) {
+            size_t j = i;
+            while (j < n && eh_id(s[j])) j++;
+            Macro* m = buscar_macro(s + i, j - i);
+            if (!m || esta_em_expansao(m) || n_em_expansao == 256) {
+                texto_anexar(out, s + i, j - i);
+                i = j;
+                continue;
+            }
+
+            Texto subst = {0};
+            size_t fim = j;
+            if (m->funcional) {
+                size_t k = j;
+                while (k < n && isspace((unsigned char)s[k])) k++;
+                if (k >= n || s[k] != '(') { // Nome sem chamada: não expande
+                    texto_anexar(out, s + i, j - i);
+                    i = j;
+                    continue;
+                }
+                Trecho args[m->n_params + 1];
+                int n_args = 0;
+                fim = ler_argumentos(m, s, n, k, args, &n_args);
+                if (fim == 0) {
+                    erro("chamada de macro sem ')':", m->nome);
+                    texto_anexar(out, s + i, n - i);
+                    return;
+                }
+                if (m->n_params == 0 && n_args == 1 && args[0].n == 0) n_args = 0;
+                if (m->variadica && n_args == m->n_params - 1) {
+                    args[n_args].s = "";
+                    args[n_args++].n = 0;
+                }
+                if (n_args != m->n_params) {
+                    erro("número errado de argumentos para a macro", m->nome);
+                    texto_anexar(out, s + i, fim - i);
+                    i = fim;
+                    continue;
+                }
+                substituir(m, args, &subst);
+            } else {
+                substituir(m, NULL, &subst);
+            }
+
+            // Reexamina o resultado com a macro desabilitada
+            em_expansao[n_em_expansao++] = m;
+            expandir(subst.s ? subst.s : "", subst.n, out);
+            n_em_expansao--;
+            texto_liberar(&subst);
+            i = fim;
+        } else {
+            texto_anexar_c(out, c);
+            i++;
+        }
+    }
+}
+
+// --- Avaliação de #if ---
+typedef struct { const char* p; int erro; } Expr;
+
+static long long expr_ternaria(Expr* e);
+
+static void expr_espacos(Expr* e) { while (isspace((unsigned char)*e->p)) e->p++; }
+
+static int expr_aceitar(Expr* e, const char* op) {
+    expr_espacos(e);
+    size_t n = strlen(op);
+    if (strncmp(e->p, op, n) != 0) return 0;
+    // Não confunde "<" com "<<" ou "<=", "&" com "&&" etc.
+    if (n == 1 && strchr("<>&|", op[0]) && (e->p[1] == op[0] || e->p[1] == '=')) return 0;
+    if (n == 1 && op[0] == '!' && e->p[1] == '=') return 0;
+    e->p += n;
+    return 1;
+}
+
+static long long expr_primaria(Expr* e) {
+    expr_espacos(e);
+    if (expr_aceitar(e, "(")) {
+        long long v = expr_ternaria(e);
+        if (!expr_aceitar(e, ")")) e->erro = 1;
+        return v;
+    }
+    if (isdigit((unsigned char)*e->p)) {
+        char* fim;
+        long long v = (long long)strtoull(e->p, &fim, 0);
+        while (*fim == 'u' || *fim == 'U' || *fim == 'l' || *fim == 'L') fim++;
+        e->p = fim;
+        return v;
+    }
+    if (*e->p == '\'') {
+        e->p++;
+        long long v = (unsigned char)*e->p;
+        if (*e->p == '\\') {
+            e->p++;
+            switch (*e->p) {
+                case 'n': v = '\n'; break;
+                case 't': v = '\t'; break;
+                case '0': v = 0; break;
+                default:  v = (unsigned char)*e->p; break;
+            }
+        }
+        if (*e->p) e->p++;
+        if (*e->p == '\'') e->p++; else e->erro = 1;
+        return v;
+    }
+    if (eh_inicio_id(*e->p)) { // Identificador que sobrou após a expansão vale 0
+        while (eh_id(*e->p)) e->p++;
+        return 0;
+    }
+    e->erro = 1;
+    return 0;
+}
+
+static long long expr_unaria(Expr* e) {
+    if (expr_aceitar(e, "!")) return !expr_unaria(e);
+    if (expr_aceitar(e, "~")) return ~expr_unaria(e);
+    if (expr_aceitar(e, "-")) return -expr_unaria(e);
+    if (expr_aceitar(e, "+")) return expr_unaria(e);
+    return expr_primaria(e);
+}
+
+static long long expr_mult(Expr* e) {
+    long long v = expr_unaria(e);
+    for (;;) {
+        if (expr_aceitar(e, "*")) v *= expr_unaria(e);
+        else if (expr_aceitar(e, "/") || expr_aceitar(e, "%")) {
+            char op = e->p[-1];
+            long long d = expr_unaria(e);
+            if (d == 0) { e->erro = 1; return 0; }
+            v = (op == '/') ? v / d : v % d;
+        } else return v;
+    }
+}
+
+static long long expr_adit(Expr* e) {
+    long long v = expr_mult(e);
+    for (;;) {
+        if (expr_aceitar(e, "+")) v += expr_mult(e);
+        else if (expr_aceitar(e, "-")) v -= expr_mult(e);
+        else return v;
+    }
+}
+
+static long long expr_desl(Expr* e) {
+    long long v = expr_adit(e);
+    for (;;) {
+        if (expr_aceitar(e, "<<")) v <<= expr_adit(e);
+        else if (expr_aceitar(e, ">>")) v >>= expr_adit(e);
+        else return v;
+    }
+}
+
+static long long expr_rel(Expr* e) {
+    long long v = expr_desl(e);
+    for (;;) {
+        if (expr_aceitar(e, "<=")) v = v <= expr_desl(e);
+        else if (expr_aceitar(e, ">=")) v = v >= expr_desl(e);
+        else if (expr_aceitar(e, "<")) v = v < expr_desl(e);
+        else if (expr_aceitar(e, ">")) v = v > expr_desl(e);
+        else return v;
+    }
+}
+
+static long long expr_igual(Expr* e) {
+    long long v = expr_rel(e);
+    for (;;) {
+        if (expr_aceitar(e, "==")) v = v == expr_rel(e);
+        else if (expr_aceitar(e, "!=")) v = v != expr_rel(e);
+        else return v;
+    }
+}
+
+static long long expr_e_bits(Expr* e)  { long long v = expr_igual(e);  while (expr_aceitar(e, "&")) v &= expr_igual(e);  return v; }
+static long long expr_xor(Expr* e)     { long long v = expr_e_bits(e); while (expr_aceitar(e, "^")) v ^= expr_e_bits(e); return v; }
+static long long expr_ou_bits(Expr* e) { long long v = expr_xor(e);    while (expr_aceitar(e, "|")) v |= expr_xor(e);    return v; }
+
+static long long expr_e(Expr* e) {
+    long long v = expr_ou_bits(e);
+    while (expr_aceitar(e, "&&")) { long long d = expr_ou_bits(e); v = v && d; }
+    return v;
+}
+
+static long long expr_ou(Expr* e) {
+    long long v = expr_e(e);
+    while (expr_aceitar(e, "||")) { long long d = expr_e(e); v = v || d; }
+    return v;
+}
+
+static long long expr_ternaria(Expr* e) {
+    long long c = expr_ou(e);
+    if (!expr_aceitar(e, "?")) return c;
+    long long a = expr_ternaria(e);
+    if (!expr_aceitar(e, ":")) { e->erro = 1; return 0; }
+    long long b = expr_ternaria(e);
+    return c ? a : b;
+}
+
+// Avalia a condição de um #if/#elif: resolve defined(), expande macros e
+// trata identificadores restantes como 0.
+static int avaliar_condicao(const char* s) {
+    Texto com_defined = {0}, expandido = {0};
+    size_t n = strlen(s), i = 0;
+    while (i < n) {
+        if (eh_inicio_id(s[i])) {
+            size_t j = i;
+            while (j < n && eh_id(s[j])) j++;
+            if (j - i == 7 && strncmp(s + i, "defined", 7) == 0) {
+                size_t k = j;
+                while (k < n && isspace((unsigned char)s[k])) k++;
+                int parenteses = (k < n && s[k] == '(');
+                if (parenteses) { k++; while (k < n && isspace((unsigned char)s[k])) k++; }
+                size_t ini = k;
+                while (k < n && eh_id(s[k])) k++;
+                texto_anexar_str(&com_defined, buscar_macro(s + ini, k - ini) ? "1" : "0");
+                if (parenteses) {
+                    while (k < n && isspace((unsigned char)s[k])) k++;
+                    if (k < n && s[k] == ')') k++;
+                }
+                i = k;
+            } else {
+                texto_anexar(&com_defined, s + i, j - i);
+                i = j;
+            }
+        } else {
+            texto_anexar_c(&com_defined, s[i++]);
+        }
+    }
+    expandir(com_defined.s ? com_defined.s : "", com_defined.n, &expandido);
+
+    Expr e = { expandido.s ? expandido.s : "", 0 };
+    long long v = expr_ternaria(&e);
+    expr_espacos(&e);
+    if (e.erro || *e.p) {
+        erro("expressão inválida em #if:", s);
+        v = 0;
+    }
+    texto_liberar(&com_defined);
+    texto_liberar(&expandido);
+    return v != 0;
+}
+
+// --- Leitura de linhas ---
+// Lê uma linha física (sem o '\n'). Retorna o tamanho ou -1 no fim.
+static long ler_linha_fisica(Fonte* f, const char** linha) {
+    if (f->arquivo) {
+        ssize_t n = getline(&fisica, &fisica_cap, f->arquivo);
+        if (n < 0) return -1;
+        if (n > 0 && fisica[n - 1] == '\n') n--;
+        if (n > 0 && fisica[n - 1] == '\r') n--;
+        *linha = fisica;
+        return (long)n;
+    }
+    if (f->mem_pos >= f->mem_tam) return -1;
+    const char* ini = f->mem + f->mem_pos;
+    const char* nl = memchr(ini, '\n', f->mem_tam - f->mem_pos);
+    size_t n = nl ? (size_t)(nl - ini) : f->mem_tam - f->mem_pos;
+    f->mem_pos += n + (nl ? 1 : 0);
+    if (n > 0 && ini[n - 1] == '\r') n--;
+    *linha = ini;
+    return (long)n;
+}
+
+// Remove comentários de um trecho e o anexa à linha lógica. Comentários
+// viram um espaço; o estado de /* ... */ aberto fica na fonte.
+static void anexar_sem_comentarios(Fonte* f, const char* s, size_t n, Texto* out) {
+    size_t i = 0;
+    while (i < n) {
+        if (f->em_comentario) {
+            const char* fim = NULL;
+            for (size_t k = i; k + 1 < n; k++) {
+                if (s[k] == '*' && s[k + 1] == '/') { fim = s + k; break; }
+            }
+            if (!fim) return;
+            i = (size_t)(fim - s) + 2;
+            f->em_comentario = 0;
+            texto_anexar_c(out, ' ');
+            continue;
+        }
+        char c = s[i];
+        if (c == '"' || c == '\'') {
+            size_t j = fim_literal(s, n, i);
+            texto_anexar(out, s + i, j - i);
+            i = j;
+        } else if (c == '/' && i + 1 < n && s[i + 1] == '/') {
+            return;
+        } else if (c == '/' && i + 1 < n && s[i + 1] == '*') {
+            f->em_comentario = 1;
+            i += 2;
+        } else {
+            // Copia de uma vez o trecho sem aspas nem barras
+            size_t j = i + 1;
+            while (j < n && s[j] != '"' && s[j] != '\'' && s[j] != '/') j++;
+            texto_anexar(out, s + i, j - i);
+            i = j;
+        }
+    }
+}
+
+// Monta uma linha lógica: junta linhas terminadas em '\' e linhas
+// atravessadas por /* ... */. Retorna o número de linhas físicas lidas.
+static int ler_linha_logica(Fonte* f, Texto* out) {
+    texto_limpar(out);
+    int fisicas = 0;
+    for (;;) {
+        const char* s;
+        long n = ler_linha_fisica(f, &s);
+        if (n < 0) break;
+        fisicas++;
+        f->linha++;
+        int continua = (n > 0 && s[n - 1] == '\\');
+        anexar_sem_comentarios(f, s, (size_t)(continua ? n - 1 : n), out);
+        if (!continua && !f->em_comentario) break;
+    }
+    return fisicas;
+}
+
+// Uma chamada de macro com parâmetros pode atravessar linhas
+static int chamada_incompleta(const Texto* t) {
+    int tem_macro = 0, nivel = 0;
+    for (size_t i = 0; i < t->n; ) {
+        char c = t->s[i];
+        if (c == '"' || c == '\'') { i = fim_literal(t->s, t->n, i); continue; }
+        if (eh_inicio_id(c)) {
+            size_t j = i;
+            while (j < t->n && eh_id(t->s[j])) j++;
+            Macro* m = buscar_macro(t->s + i, j - i);
+            if (m && m->funcional) tem_macro = 1;
+            i = j;
+            continue;
+        }
+        if (c == '(') nivel++;
+        else if (c == ')') nivel--;
+        i++;
+    }
+    return tem_macro && nivel > 0;
+}
+
+// --- Fontes ---
+static char* diretorio_de(const char* caminho) {
+    const char* barra = strrchr(caminho, '/');
+    if (!barra) return strdup(".");
+    if (barra == caminho) return strdup("/");
+    return strndup(caminho, (size_t)(barra - caminho));
+}
+
+static Fonte* empilhar_fonte(const char* nome) {
+    Fonte* f = calloc(1, sizeof(Fonte));
+    f->nome = strdup(nome);
+    f->dir = diretorio_de(nome);
+    f->nivel_cond = n_conds;
+    f->anterior = topo;
+    topo = f;
+    profundidade++;
+    return f;
+}
+
+static void liberar_entrada(EntradaCache* c) {
+    free(c->caminho);
+    texto_liberar(&c->texto);
+    for (size_t i = 0; i < c->n_ops; i++) {
+        free(c->ops[i].texto);
+        if (c->ops[i].macro) soltar_macro(c->ops[i].macro);
+    }
+    free(c->ops);
+    for (size_t i = 0; i < c->n_deps; i++) free(c->deps[i].caminho);
+    free(c->deps);
+    free(c->guarda);
+    free(c);
+}
+
+static void guardar_no_cache(EntradaCache* c) {
+    unsigned int idx = hash_trecho(c->caminho, strlen(c->caminho)) % CACHE_TABLE_SIZE;
+    if (c->guarda_estado != 2) { // Sem include guard reconhecido
+        free(c->guarda);
+        c->guarda = NULL;
+    }
+    c->prox = cache[idx];
+    cache[idx] = c;
+
+    // Limita as variantes guardadas do mesmo header (estados diferentes)
+    int qtd = 0;
+    for (EntradaCache** p = &c->prox; *p; ) {
+        if (strcmp((*p)->caminho, c->caminho) == 0 && ++qtd >= MAX_ENTRADAS_POR_HEADER) {
+            EntradaCache* velha = *p;
+            *p = velha->prox;
+            liberar_entrada(velha);
+        } else {
+            p = &(*p)->prox;
+        }
+    }
+}
+
+static void desempilhar_fonte(int guardar) {
+    Fonte* f = topo;
+    if (f->em_comentario) erro("comentário /* sem fechamento", NULL);
+    if (n_conds > f->nivel_cond) {
+        erro("#if sem #endif correspondente", NULL);
+        n_conds = f->nivel_cond;
+    }
+    topo = f->anterior;
+    profundidade--;
+
+    EntradaCache* c = f->captura;
+    if (c) {
+        if (guardar && c->valida && cache_habilitado) guardar_no_cache(c);
+        else liberar_entrada(c);
+    }
+    if (f->fechar) fclose(f->arquivo);
+    free(f->nome);
+    free(f->dir);
+    free(f);
+
+    // Retoma a numeração de linhas do arquivo que fez o #include
+    if (topo && guardar) emitir_marcador(topo->linha + 1, topo->nome);
+}
+
+// --- Diretivas ---
+static Condicional* cond_atual(void) { return n_conds ? &conds[n_conds - 1] : NULL; }
+static int emitindo(void) { return n_conds == 0 || conds[n_conds - 1].ativo; }
+
+static void empilhar_cond(int ativo) {
+    if (n_conds == cap_conds) {
+        cap_conds = cap_conds ? cap_conds * 2 : 16;
+        conds = realloc(conds, (size_t)cap_conds * sizeof(Condicional));
+    }
+    int pai = emitindo();
+    conds[n_conds].ativo = pai && ativo;
+    conds[n_conds].tomado = ativo;
+    conds[n_conds].visto_else = 0;
+    n_conds++;
+}
+
+static int pai_emitindo(void) { return n_conds < 2 || conds[n_conds - 2].ativo; }
+
+static int ja_incluido_once(const char* caminho) {
+    for (int i = 0; i < n_once; i++) {
+        if (strcmp(once[i], caminho) == 0) return 1;
+    }
+    return 0;
+}
+
+static void marcar_once(const char* caminho) {
+    if (ja_incluido_once(caminho)) return;
+    once = realloc(once, (size_t)(n_once + 1) * sizeof(char*));
+    once[n_once++] = strdup(caminho);
+}
+
+static int dependencias_validas(const EntradaCache* c) {
+    struct stat st;
+    for (size_t i = 0; i < c->n_deps; i++) {
+        if (stat(c->deps[i].caminho, &st) != 0 ||
+            (long long)st.st_mtime != c->deps[i].mtime ||
+            (long long)st.st_size != c->deps[i].tamanho) return 0;
+    }
+    return 1;
+}
+
+// Procura o header no cache. Retorna 0 se o arquivo precisa ser processado,
+// 1 se a include guard já está definida (nada a emitir) ou 2 se o texto e
+// as macros do header foram reproduzidos.
+static int incluir_do_cache(const char* caminho, const struct stat* st) {
+    unsigned int idx = hash_trecho(caminho, strlen(caminho)) % CACHE_TABLE_SIZE;
+    unsigned long long estado = estado_macros ^ estado_caminhos;
+
+    for (EntradaCache* c = cache[idx]; c; c = c->prox) {
+        if (strcmp(c->caminho, caminho) != 0 ||
+            c->mtime != (long long)st->st_mtime || c->tamanho != (long long)st->st_size) continue;
+
+        // Include guard já definida: o conteúdo inteiro seria descartado
+        if (c->guarda && buscar_macro(c->guarda, strlen(c->guarda))) {
+            registrar_dependencia(caminho, c->mtime, c->tamanho);
+            cache_acertos++;
+            return 1;
+        }
+        if (c->estado_entrada != estado || !dependencias_validas(c)) continue;
+
+        // Mesmo estado de entrada: reproduz o texto e as macros do header
+        emitir(c->texto.s, c->texto.n);
+        for (size_t i = 0; i < c->n_ops; i++) {
+            OpMacro* op = &c->ops[i];
+            if (op->tipo == 'D') inserir_macro(op->macro);
+            else if (op->tipo == 'U') remover_macro(op->texto, strlen(op->texto));
+            else marcar_once(op->texto);
+            registrar_op(op->tipo, op->texto, op->macro);
+        }
+        for (size_t i = 0; i < c->n_deps; i++) {
+            registrar_dependencia(c->deps[i].caminho, c->deps[i].mtime, c->deps[i].tamanho);
+        }
+        emitir_marcador(topo->linha + 1, topo->nome);
+        cache_acertos++;
+        return 2;
+    }
+    return 0;
+}
+
+static int arquivo_existe(const char* caminho, struct stat* st) {
+    return stat(caminho, st) == 0 && S_ISREG(st->st_mode);
+}
+
+static void processar_include(const char* resto, int fisicas) {
+    // O nome pode vir de uma macro: #include CABECALHO
+    Texto expandido = {0};
+    if (*resto != '"' && *resto != '<') {
+        expandir(resto, strlen(resto), &expandido);
+        resto = expandido.s ? expandido.s : "";
+        while (isspace((unsigned char)*resto)) resto++;
+    }
+
+    char fecha = (*resto == '"') ? '"' : (*resto == '<') ? '>' : 0;
+    const char* fim = fecha ? strchr(resto + 1, fecha) : NULL;
+    if (!fim) {
+        erro("#include espera \"arquivo\" ou <arquivo>", NULL);
+        emitir_quebras(fisicas);
+        texto_liberar(&expandido);
+        return;
+    }
+    char* nome = strndup(resto + 1, (size_t)(fim - resto - 1));
+    texto_liberar(&expandido);
+
+    // Busca: diretório do arquivo atual (só para "..."), depois os -I
+    char caminho[PATH_MAX];
+    struct stat st;
+    int achou = 0;
+    if (nome[0] == '/') {
+        snprintf(caminho, sizeof caminho, "%s", nome);
+        achou = arquivo_existe(caminho, &st);
+    }
+    if (!achou && fecha == '"') {
+        snprintf(caminho, sizeof caminho, "%s/%s", topo->dir, nome);
+        achou = arquivo_existe(caminho, &st);
+    }
+    for (int i = 0; !achou && i < n_caminhos; i++) {
+        snprintf(caminho, sizeof caminho, "%s/%s", caminhos[i], nome);
+        achou = arquivo_existe(caminho, &st);
+    }
+
+    if (!achou) {
+        // Headers da biblioteca padrão (<stdio.h> etc.) não são lidos: as
+        // funções conhecidas são traduzidas diretamente para Python.
+        if (fecha == '"') erro("arquivo de #include não encontrado:", nome);
+        emitir_quebras(fisicas);
+        free(nome);
+        return;
+    }
+    free(nome);
+
+    char real[PATH_MAX];
+    if (realpath(caminho, real)) snprintf(caminho, sizeof caminho, "%s", real);
+
+    int resolvido = ja_incluido_once(caminho) ? 1 : cache_habilitado ? incluir_do_cache(caminho, &st) : 0;
+    if (resolvido) {
+        if (resolvido == 1) emitir_quebras(fisicas);
+        return;
+    }
+    if (profundidade >= MAX_PROFUNDIDADE_INCLUDE) {
+        erro("#include aninhado demais (recursão?):", caminho);
+        emitir_quebras(fisicas);
+        return;
+    }
+
+    FILE* arq = fopen(caminho, "r");
+    if (!arq) {
+        erro("não foi possível abrir", caminho);
+        emitir_quebras(fisicas);
+        return;
+    }
+    cache_falhas++;
+    registrar_dependencia(caminho, (long long)st.st_mtime, (long long)st.st_size);
+
+    Fonte* f = empilhar_fonte(caminho);
+    f->arquivo = arq;
+    f->fechar = 1;
+    if (cache_habilitado) {
+        EntradaCache* c = calloc(1, sizeof(EntradaCache));
+        c->caminho = strdup(caminho);
+        c->mtime = (long long)st.st_mtime;
+        c->tamanho = (long long)st.st_size;
+        c->estado_entrada = estado_macros ^ estado_caminhos;
+        c->valida = 1;
+        anexar_dependencia(c, caminho, c->mtime, c->tamanho);
+        f->captura = c;
+    }
+    emitir_marcador(1, caminho);
+}
+
+// Acompanha se o header inteiro está dentro de "#ifndef X / #define X ... #endif"
+static void guarda_linha_comum(void) {
+    EntradaCache* c = topo->captura;
+    if (c && c->guarda_estado != 1) c->guarda_estado = -1;
+}
+
+static void processar_diretiva(const char* p, int fisicas) {
+    while (*p == ' ' || *p == '\t') p++;
+    const char* ini = p;
+    while (eh_id(*p)) p++;
+    size_t n = (size_t)(p - ini);
+    while (*p == ' ' || *p == '\t') p++;
+    const char* resto = p;
+    EntradaCache* c = topo->captura;
+
+#define DIRETIVA(nome) (n == sizeof(nome) - 1 && strncmp(ini, nome, n) == 0)
+    if (DIRETIVA("ifdef") || DIRETIVA("ifndef")) {
+        const char* q = resto;
+        while (eh_id(*q)) q++;
+        int definida = buscar_macro(resto, (size_t)(q - resto)) != NULL;
+        if (c && c->guarda_estado == 0 && DIRETIVA("ifndef")) {
+            c->guarda_estado = 1;
+            c->guarda_nivel = n_conds;
+            c->guarda = strndup(resto, (size_t)(q - resto));
+        } else {
+            guarda_linha_comum();
+        }
+        empilhar_cond(DIRETIVA("ifdef") ? definida : !definida);
+    } else if (DIRETIVA("if")) {
+        guarda_linha_comum();
+        empilhar_cond(emitindo() ? avaliar_condicao(resto) : 0);
+    } else if (DIRETIVA("elif") || DIRETIVA("else")) {
+        Condicional* cd = cond_atual();
+        if (c && c->guarda_estado == 1 && n_conds == c->guarda_nivel + 1) c->guarda_estado = -1;
+        if (!cd || cd->visto_else) {
+            erro(cd ? "#elif/#else depois de #else" : "#elif/#else sem #if", NULL);
+        } else if (DIRETIVA("else")) {
+            cd->ativo = pai_emitindo() && !cd->tomado;
+            cd->tomado = 1;
+            cd->visto_else = 1;
+        } else if (cd->tomado) {
+            cd->ativo = 0;
+        } else {
+            cd->ativo = pai_emitindo() && avaliar_condicao(resto);
+            cd->tomado = cd->ativo;
+        }
+    } else if (DIRETIVA("endif")) {
+        if (n_conds <= topo->nivel_cond) {
+            erro("#endif sem #if", NULL);
+        } else {
+            n_conds--;
+            if (c && c->guarda_estado == 1 && n_conds == c->guarda_nivel) c->guarda_estado = 2;
+        }
+    } else if (!emitindo()) {
+        // Demais diretivas em trecho desativado são ignoradas
+    } else if (DIRETIVA("include")) {
+        guarda_linha_comum();
+        processar_include(resto, fisicas);
+        return; // A numeração é retomada pelo marcador de linha
+    } else if (DIRETIVA("define")) {
+        if (c && c->guarda_estado != 1) c->guarda_estado = -1;
+        Macro* m = definir_macro(resto);
+        if (m) registrar_op('D', NULL, m);
+    } else if (DIRETIVA("undef")) {
+        guarda_linha_comum();
+        const char* q = resto;
+        while (eh_id(*q)) q++;
+        char* nome = strndup(resto, (size_t)(q - resto));
+        remover_macro(nome, strlen(nome));
+        registrar_op('U', nome, NULL);
+        free(nome);
+    } else if (DIRETIVA("pragma")) {
+        if (strncmp(resto, "once", 4) == 0 && !eh_id(resto[4]) && profundidade > 1) {
+            marcar_once(topo->nome);
+            registrar_op('O', topo->nome, NULL);
+        }
+    } else if (DIRETIVA("error")) {
+        erro("#error", resto);
+    } else if (DIRETIVA("warning")) {
+        if (!silencioso) fprintf(stderr, "Aviso (Pré-processador) %s:%d: %s\n", topo->nome, topo->linha, resto);
+    } else if (n != 0 && !DIRETIVA("line")) {
+        char* nome = strndup(ini, n);
+        erro("diretiva desconhecida:", nome);
+        free(nome);
+    }
+#undef DIRETIVA
+    emitir_quebras(fisicas);
+}
+
+// Processa a próxima linha lógica. Retorna 0 quando não há mais entrada.
+static int processar_linha(void) {
+    if (!topo) return 0;
+    int fisicas = ler_linha_logica(topo, &linha_atual);
+    if (fisicas == 0) {
+        desempilhar_fonte(1);
+        return topo != NULL;
+    }
+
+    const char* p = linha_atual.s;
+    while (*p == ' ' || *p == '\t') p++;
+    if (*p == '#') {
+        processar_diretiva(p + 1, fisicas);
+        return 1;
+    }
+    if (*p) guarda_linha_comum();
+    if (!emitindo()) {
+        emitir_quebras(fisicas);
+        return 1;
+    }
+
+    if (n_macros_funcionais > 0) {
+        // Argumentos de uma macro podem continuar nas linhas seguintes
+        Texto extra = {0};
+        for (int i = 0; i < MAX_LINHAS_JUNTADAS && chamada_incompleta(&linha_atual); i++) {
+            int mais = ler_linha_logica(topo, &extra);
+            if (mais == 0) break;
+            fisicas += mais;
+            texto_anexar_c(&linha_atual, ' ');
+            texto_anexar(&linha_atual, extra.s, extra.n);
+        }
+        texto_liberar(&extra);
+    }
+
+    if (n_macros == 0) {
+        emitir(linha_atual.s, linha_atual.n);
+    } else {
+        Texto expandido = {0};
+        expandir(linha_atual.s, linha_atual.n, &expandido);
+        emitir(expandido.s ? expandido.s : "", expandido.n);
+        texto_liberar(&expandido);
+    }
+    emitir_quebras(fisicas);
+    return 1;
+}
+
+size_t preproc_ler(char* buf, size_t max) {
+    if (saida_pos == saida.n) {
+        texto_limpar(&saida);
+        saida_pos = 0;
+        // Processa linhas em lote até encher o pedido do lexer
+        while (saida.n < max && processar_linha()) {}
+    }
+    size_t n = saida.n - saida_pos;
+    if (n > max) n = max;
+    memcpy(buf, saida.s + saida_pos, n);
+    saida_pos += n;
+    return n;
+}
+
+// --- Interface ---
+static void limpar_unidade(void) {
+    while (topo) desempilhar_fonte(0);
+    profundidade = 0;
+    n_conds = 0;
+    liberar_macros();
+    for (int i = 0; i < n_caminhos; i++) free(caminhos[i]);
+    free(caminhos);
+    caminhos = NULL;
+    n_caminhos = 0;
+    estado_caminhos = 0;
+    for (int i = 0; i < n_once; i++) free(once[i]);
+    free(once);
+    once = NULL;
+    n_once = 0;
+    texto_limpar(&saida);
+    saida_pos = 0;
+    erros = 0;
+}
+
+void preproc_inicializar(void) {
+    limpar_unidade();
+}
+
+void preproc_adicionar_caminho(const char* dir) {
+    caminhos = realloc(caminhos, (size_t)(n_caminhos + 1) * sizeof(char*));
+    caminhos[n_caminhos++] = strdup(dir);
+    // Os caminhos de busca fazem parte da chave do cache
+    estado_caminhos = fnv(estado_caminhos ? estado_caminhos : FNV_INICIAL, dir, strlen(dir) + 1);
+}
+
+void preproc_definir(const char* definicao) {
+    // -D NOME=valor vira "#define NOME valor"; -D NOME vira "#define NOME 1"
+    Texto def = {0};
+    const char* igual = strchr(definicao, '=');
+    if (igual) {
+        texto_anexar(&def, definicao, (size_t)(igual - definicao));
+        texto_anexar_c(&def, ' ');
+        texto_anexar_str(&def, igual + 1);
+    } else {
+        texto_anexar_str(&def, definicao);
+        texto_anexar_str(&def, " 1");
+    }
+    definir_macro(def.s);
+    texto_liberar(&def);
+}
+
+int preproc_abrir_arquivo(const char* caminho) {
+    FILE* f = fopen(caminho, "r");
+    if (!f) {
+        fprintf(stderr, "Erro: Não foi possível abrir '%s'.\n", caminho);
+        return 0;
+    }
+    Fonte* fonte = empilhar_fonte(caminho);
+    fonte->arquivo = f;
+    fonte->fechar = 1;
+    return 1;
+}
+
+void preproc_abrir_stream(const char* nome, FILE* f) {
+    Fonte* fonte = empilhar_fonte(nome);
+    fonte->arquivo = f;
+    free(fonte->dir);
+    fonte->dir = strdup(".");
+}
+
+// O texto precisa continuar válido até o fim da leitura
+void preproc_abrir_memoria(const char* nome, const char* texto, size_t n) {
+    Fonte* fonte = empilhar_fonte(nome);
+    fonte->mem = texto;
+    fonte->mem_tam = n;
+}
+
+void preproc_preparar_contexto(const char* texto, size_t n) {
+    if (n == 0) return;
+    preproc_abrir_memoria("<contexto>", texto, n);
+    silencioso = 1;
+    while (processar_linha()) {}
+    silencioso = 0;
+    // Os erros do contexto são de outros trechos, que os informam
+    erros = 0;
+    texto_limpar(&saida);
+    saida_pos = 0;
+}
+
+void preproc_abrir_trecho(const char* nome, const char* texto, size_t n, int linha) {
+    preproc_abrir_memoria(nome, texto, n);
+    if (linha > 1) {
+        topo->linha = linha - 1;
+        emitir_marcador(linha, nome);
+    }
+}
+
+int preproc_erros(void) {
+    return erros;
+}
+
+void preproc_finalizar(void) {
+    limpar_unidade();
+    texto_liberar(&saida);
+    texto_liberar(&linha_atual);
+    free(fisica);
+    fisica = NULL;
+    fisica_cap = 0;
+}
+
+void preproc_habilitar_cache(int habilitado) {
+    cache_habilitado = habilitado;
+}
+
+void preproc_liberar_cache(void) {
+    for (int i = 0; i < CACHE_TABLE_SIZE; i++) {
+        EntradaCache* c = cache[i];
+        while (c) {
+            EntradaCache* prox = c->prox;
+            liberar_entrada(c);
+            c = prox;
+        }
+        cache[i] = NULL;
+    }
+    cache_acertos = cache_falhas = 0;
+}
+
+void preproc_estatisticas(unsigned long* acertos, unsigned long* falhas) {
+    if (acertos) *acertos = cache_acertos;
+    if (falhas) *falhas = cache_falhas;
+}
@@ -0,0 +1,50 @@
+#ifndef PREPROC_H
+#define PREPROC_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+// --- Pré-processador ---
+// Estágio entre a entrada e o lexer: trata #include, #define (macros
+// simples e com parâmetros), #undef, #if/#ifdef/#ifndef/#elif/#else/#endif,
+// #pragma once e #error. O lexer consome o texto já processado por meio de
+// preproc_ler(), chamado a partir de YY_INPUT.
+//
+// Headers já processados ficam em um cache (chave: caminho, mtime e estado
+// das macros na entrada). Uma nova inclusão com o mesmo estado apenas
+// reproduz o texto gerado e as macros definidas pelo header; um header
+// protegido por include guard já definida nem chega a ser aberto.
+
+// Prepara uma nova unidade de tradução: descarta macros e caminhos de
+// inclusão da unidade anterior. O cache de headers é preservado.
+void   preproc_inicializar(void);
+void   preproc_adicionar_caminho(const char* dir);   // -I dir
+void   preproc_definir(const char* definicao);        // -D NOME[=valor]
+
+// Fonte principal da unidade de tradução
+int    preproc_abrir_arquivo(const char* caminho);
+void   preproc_abrir_stream(const char* nome, FILE* f);
+void   preproc_abrir_memoria(const char* nome, const char* texto, size_t n);
+
+// Modo incremental (incremental.h): cada trecho de um documento é traduzido
+// à parte. preproc_preparar_contexto() processa as diretivas dos trechos
+// anteriores só para refazer macros, caminhos e #pragma once (o texto gerado
+// e as mensagens são descartados); preproc_abrir_trecho() abre o trecho
+// como fonte principal, numerado a partir da linha `linha` do documento.
+void   preproc_preparar_contexto(const char* texto, size_t n);
+void   preproc_abrir_trecho(const char* nome, const char* texto, size_t n, int linha);
+
+// Copia até `max` bytes de texto pré-processado para `buf`. Retorna 0 no fim.
+size_t preproc_ler(char* buf, size_t max);
+
+// Número de erros encontrados na unidade de tradução atual
+int    preproc_erros(void);
+// Libera o estado da unidade de tradução (fontes abertas, macros)
+void   preproc_finalizar(void);
+
+// Cache de headers
+void   preproc_habilitar_cache(int habilitado);
+void   preproc_liberar_cache(void);
+void   preproc_estatisticas(unsigned long* acertos, unsigned long* falhas);
+
+#endif
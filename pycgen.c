@@ -0,0 +1,1140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "codegen.h"
+#include "saida.h"
+#include "pycgen.h"
+#include "biblioteca.h"
+
+// Cabeçalho do .pyc do CPython 3.11: número mágico 3495, flags 0 (validado
+// por data), data e tamanho do fonte zerados. Rodado direto, nada disso é
+// conferido além do número mágico.
+static const unsigned char PYC_MAGICO[4] = { 0xa7, 0x0d, 0x0d, 0x0a };
+
+// Opcodes do CPython 3.11 (Lib/opcode.py)
+enum {
+    PY_POP_TOP = 1,
+    PY_PUSH_NULL = 2,
+    PY_UNARY_NEGATIVE = 11,
+    PY_UNARY_NOT = 12,
+    PY_UNARY_INVERT = 15,
+    PY_BINARY_SUBSCR = 25,
+    PY_RETURN_VALUE = 83,
+    PY_STORE_NAME = 90,
+    PY_LOAD_CONST = 100,
+    PY_LOAD_NAME = 101,
+    PY_BUILD_TUPLE = 102,
+    PY_LOAD_ATTR = 106,
+    PY_COMPARE_OP = 107,
+    PY_JUMP_FORWARD = 110,
+    PY_JUMP_IF_FALSE_OR_POP = 111,
+    PY_JUMP_IF_TRUE_OR_POP = 112,
+    PY_POP_JUMP_FORWARD_IF_FALSE = 114,
+    PY_LOAD_GLOBAL = 116,
+    PY_BINARY_OP = 122,
+    PY_LOAD_FAST = 124,
+    PY_STORE_FAST = 125,
+    PY_MAKE_FUNCTION = 132,
+    PY_JUMP_BACKWARD = 140,
+    PY_EXTENDED_ARG = 144,
+    PY_RESUME = 151,
+    PY_PRECALL = 166,
+    PY_CALL = 171
+};
+
+// Argumentos de BINARY_OP e COMPARE_OP
+enum { NB_ADD = 0, NB_AND = 1, NB_FLOOR_DIVIDE = 2, NB_LSHIFT = 3, NB_MULTIPLY = 5, NB_REMAINDER = 6, NB_OR = 7,
+       NB_RSHIFT = 9, NB_SUBTRACT = 10, NB_TRUE_DIVIDE = 11, NB_XOR = 12 };
+enum { CMP_LT = 0, CMP_LE = 1, CMP_EQ = 2, CMP_NE = 3, CMP_GT = 4, CMP_GE = 5 };
+
+#define CO_OPTIMIZED   0x01
+#define CO_NEWLOCALS   0x02
+#define CO_FAST_LOCAL  0x20
+
+// Bytes crescentes (bytecode, tabelas e objetos serializados)
+typedef struct {
+    unsigned char* d;
+    size_t n, cap;
+} Bytes;
+
+// Textos com índice (nomes e constantes), na ordem de inserção
+typedef struct {
+    char**  textos;
+    size_t* tamanhos;
+    int     n, cap;
+    int*    espalhamento;   // índice + 1 (0: livre)
+    size_t  cap_espalhamento;
+} Tabela;
+
+typedef struct {
+    uint8_t op;
+    int     arg;
+    int     rotulo;         // destino de um salto (-1: não é salto)
+    int     linha;
+} Instrucao;
+
+// Estrutura aberta: IF (rótulos do else e do fim) ou laço (topo e saída)
+typedef struct {
+    int laco;
+    int a, b;
+    int tem_senao;
+} Estrutura;
+
+// Função em montagem
+static Instrucao* instrucoes = NULL;
+static int n_instrucoes = 0, cap_instrucoes = 0;
+static int* rotulos = NULL;             // instrução de cada rótulo
+static int n_rotulos = 0, cap_rotulos = 0;
+static Estrutura* estruturas = NULL;
+static int n_estruturas = 0, cap_estruturas = 0;
+static Tabela locais, globais, constantes;
+static int profundidade = 0, profundidade_max = 0;
+static int linha_atual = 1, primeira_linha = 1;
+static char* nome_funcao = NULL;
+
+static Endereco** params = NULL;        // pilha de PARAMs pendentes
+static int n_params = 0, cap_params = 0;
+
+// Módulo
+static Bytes funcoes;                   // code objects das funções, serializados
+static char** definicoes = NULL;        // nome de cada função, na ordem do fonte
+static int n_definicoes = 0, cap_definicoes = 0;
+static int tem_main = 0;
+static int usa_f32 = 0;                 // algum F32: o módulo define _f32p e _f32u
+static ConjuntoBiblioteca usadas = 0;   // funções da biblioteca chamadas
+static char* arquivo_fonte = NULL;
+
+static void* alocar(void* v, size_t tam) {
+    v = realloc(v, tam);
+    if (!v && tam) {
+        fprintf(stderr, "Erro: Falha ao alocar memória para a geração do .pyc\n");
+        exit(EXIT_FAILURE);
+    }
+    return v;
+}
+
+// --- Bytes e serialização (formato do módulo marshal, versão 4) ---
+
+static void b_dados(Bytes* b, const void* dados, size_t n) {
+    if (b->n + n > b->cap) {
+        while (b->n + n > b->cap) b->cap = b->cap ? b->cap * 2 : 256;
+        b->d = alocar(b->d, b->cap);
+    }
+    memcpy(b->d + b->n, dados, n);
+    b->n += n;
+}
+
+static void b_byte(Bytes* b, int c) {
+    unsigned char u = (unsigned char)c;
+    b_dados(b, &u, 1);
+}
+
+static void b_u32(Bytes* b, uint32_t v) {
+    unsigned char u[4] = { v & 0xff, (v >> 8) & 0xff, (v >> 16) & 0xff, v >> 24 };
+    b_dados(b, u, 4);
+}
+
+// Inteiro em decimal: 'i' (int32) ou, fora dessa faixa, 'l' com o número
+// de dígitos de 15 bits (negativo se o valor for) e os dígitos em uint16
+static void m_int(Bytes* b, const char* decimal) {
+    int negativo = decimal[0] == '-';
+    unsigned long long v = strtoull(decimal + negativo, NULL, 10);
+    if (v <= (negativo ? 0x80000000ULL : 0x7fffffffULL)) {
+        b_byte(b, 'i');
+        b_u32(b, negativo ? (uint32_t)(0 - v) : (uint32_t)v);
+        return;
+    }
+    int digitos = 0;
+    for (unsigned long long r = v; r; r >>= 15) digitos++;
+    b_byte(b, 'l');
+    b_u32(b, (uint32_t)(negativo ? -digitos : digitos));
+    for (; v; v >>= 15) {
+        b_byte(b, (int)(v & 0xff));
+        b_byte(b, (int)((v >> 8) & 0x7f));
+    }
+}
+
+static void m_float(Bytes* b, double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    b_byte(b, 'g');
+    for (int i = 0; i < 8; i++) b_byte(b, (int)((bits >> (8 * i)) & 0xff));
+}
+
+static void m_bytes(Bytes* b, const void* dados, size_t n) {
+    b_byte(b, 's');
+    b_u32(b, (uint32_t)n);
+    b_dados(b, dados, n);
+}
+
+// str do Python a partir de UTF-8; nomes vão internados
+static void m_str(Bytes* b, const char* s, size_t n, int internado) {
+    int ascii = 1;
+    for (size_t i = 0; i < n; i++) if ((unsigned char)s[i] >= 0x80) ascii = 0;
+    if (ascii && n < 256) {
+        b_byte(b, internado ? 'Z' : 'z');
+        b_byte(b, (int)n);
+    } else {
+        b_byte(b, ascii ? (internado ? 'A' : 'a') : (internado ? 't' : 'u'));
+        b_u32(b, (uint32_t)n);
+    }
+    b_dados(b, s, n);
+}
+
+static void m_tupla(Bytes* b, int n) {
+    if (n < 256) {
+        b_byte(b, ')');
+        b_byte(b, n);
+    } else {
+        b_byte(b, '(');
+        b_u32(b, (uint32_t)n);
+    }
+}
+
+// --- Tabelas de nomes e constantes ---
+
+static uint32_t hashTexto(const char* s, size_t n) {
+    uint32_t h = 2166136261u;   // FNV-1a
+    for (size_t i = 0; i < n; i++) h = (h ^ (unsigned char)s[i]) * 16777619u;
+    return h;
+}
+
+static void tabelaLimpar(Tabela* t) {
+    for (int i = 0; i < t->n; i++) free(t->textos[i]);
+    t->n = 0;
+    if (t->espalhamento) memset(t->espalhamento, 0, sizeof(int) * t->cap_espalhamento);
+}
+
+static void tabelaLiberar(Tabela* t) {
+    tabelaLimpar(t);
+    free(t->textos);
+    free(t->tamanhos);
+    free(t->espalhamento);
+    memset(t, 0, sizeof(*t));
+}
+
+// Índice de `s` na tabela (-1 se ausente e `inserir` for 0)
+static int tabelaIndice(Tabela* t, const char* s, size_t n, int inserir) {
+    if ((size_t)(t->n + 1) * 2 > t->cap_espalhamento) {
+        free(t->espalhamento);
+        t->cap_espalhamento = t->cap_espalhamento ? t->cap_espalhamento * 2 : 64;
+        t->espalhamento = calloc(t->cap_espalhamento, sizeof(int));
+        if (!t->espalhamento) alocar(NULL, 1);
+        for (int i = 0; i < t->n; i++) {
+            size_t j = hashTexto(t->textos[i], t->tamanhos[i]) & (t->cap_espalhamento - 1);
+            while (t->espalhamento[j]) j = (j + 1) & (t->cap_espalhamento - 1);
+            t->espalhamento[j] = i + 1;
+        }
+    }
+    size_t j = hashTexto(s, n) & (t->cap_espalhamento - 1);
+    while (t->espalhamento[j]) {
+        int i = t->espalhamento[j] - 1;
+        if (t->tamanhos[i] == n && memcmp(t->textos[i], s, n) == 0) return i;
+        j = (j + 1) & (t->cap_espalhamento - 1);
+    }
+    if (!inserir) return -1;
+    if (t->n == t->cap) {
+        t->cap = t->cap ? t->cap * 2 : 32;
+        t->textos = alocar(t->textos, sizeof(char*) * t->cap);
+        t->tamanhos = alocar(t->tamanhos, sizeof(size_t) * t->cap);
+    }
+    t->textos[t->n] = alocar(NULL, n + 1);
+    memcpy(t->textos[t->n], s, n);
+    t->textos[t->n][n] = '\0';
+    t->tamanhos[t->n] = n;
+    t->espalhamento[j] = t->n + 1;
+    return t->n++;
+}
+
+static void m_nomes(Bytes* b, const Tabela* t) {
+    m_tupla(b, t->n);
+    for (int i = 0; i < t->n; i++) m_str(b, t->textos[i], t->tamanhos[i], 1);
+}
+
+// Constantes guardadas como texto com o tipo na frente: "N", "i<int>",
+// "f<bits do double em hexa>", "s<str em UTF-8>"
+static void m_constantes(Bytes* b, const Tabela* t) {
+    m_tupla(b, t->n);
+    for (int i = 0; i < t->n; i++) {
+        const char* c = t->textos[i];
+        switch (c[0]) {
+            case 'i': m_int(b, c + 1); break;
+            case 'f': {
+                uint64_t bits = strtoull(c + 1, NULL, 16);
+                double v;
+                memcpy(&v, &bits, sizeof(v));
+                m_float(b, v);
+                break;
+            }
+            case 's': m_str(b, c + 1, t->tamanhos[i] - 1, 0); break;
+            default:  b_byte(b, 'N'); break;
+        }
+    }
+}
+
+static void utf8(Bytes* b, uint32_t c) {
+    if (c < 0x80) {
+        b_byte(b, (int)c);
+    } else if (c < 0x800) {
+        b_byte(b, 0xc0 | (c >> 6));
+        b_byte(b, 0x80 | (c & 0x3f));
+    } else if (c < 0x10000) {
+        b_byte(b, 0xe0 | (c >> 12));
+        b_byte(b, 0x80 | ((c >> 6) & 0x3f));
+        b_byte(b, 0x80 | (c & 0x3f));
+    } else {
+        b_byte(b, 0xf0 | (c >> 18));
+        b_byte(b, 0x80 | ((c >> 12) & 0x3f));
+        b_byte(b, 0x80 | ((c >> 6) & 0x3f));
+        b_byte(b, 0x80 | (c & 0x3f));
+    }
+}
+
+static int hexa(const char* s, int n, uint32_t* v) {
+    *v = 0;
+    for (int i = 0; i < n; i++) {
+        char c = s[i];
+        int d = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10
+              : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+        if (d < 0) return 0;
+        *v = *v * 16 + (uint32_t)d;
+    }
+    return 1;
+}
+
+// O literal do fonte (com as aspas) lido como um literal do Python, que é
+// como o .py gerado o interpreta. Acrescenta o valor em UTF-8 a `b`.
+static void decodificarString(Bytes* b, const char* lit) {
+    size_t n = strlen(lit);
+    if (n >= 2 && (lit[0] == '"' || lit[0] == '\'') && lit[n - 1] == lit[0]) {
+        lit++;
+        n -= 2;
+    }
+    for (size_t i = 0; i < n; i++) {
+        char c = lit[i];
+        if (c != '\\' || i + 1 == n) {
+            b_byte(b, c);
+            continue;
+        }
+        c = lit[++i];
+        uint32_t v;
+        switch (c) {
+            case '\\': case '\'': case '"': b_byte(b, c); break;
+            case 'a': b_byte(b, '\a'); break;
+            case 'b': b_byte(b, '\b'); break;
+            case 'f': b_byte(b, '\f'); break;
+            case 'n': b_byte(b, '\n'); break;
+            case 'r': b_byte(b, '\r'); break;
+            case 't': b_byte(b, '\t'); break;
+            case 'v': b_byte(b, '\v'); break;
+            case '\n': break;
+            case 'x':
+                if (i + 2 < n && hexa(lit + i + 1, 2, &v)) { utf8(b, v); i += 2; }
+                else { b_byte(b, '\\'); b_byte(b, c); }
+                break;
+            case 'u':
+            case 'U': {
+                int digitos = c == 'u' ? 4 : 8;
+                if (i + digitos < n && hexa(lit + i + 1, digitos, &v) && v < 0x110000) { utf8(b, v); i += digitos; }
+                else { b_byte(b, '\\'); b_byte(b, c); }
+                break;
+            }
+            default:
+                if (c >= '0' && c <= '7') {
+                    v = (uint32_t)(c - '0');
+                    for (int k = 0; k < 2 && i + 1 < n && lit[i + 1] >= '0' && lit[i + 1] <= '7'; k++) {
+                        v = v * 8 + (uint32_t)(lit[++i] - '0');
+                    }
+                    utf8(b, v);
+                } else {
+                    b_byte(b, '\\');
+                    b_byte(b, c);
+                }
+                break;
+        }
+    }
+}
+
+// --- Instruções ---
+
+static int cachesDe(int op) {
+    switch (op) {
+        case PY_LOAD_GLOBAL: return 5;
+        case PY_CALL:
+        case PY_LOAD_ATTR:
+        case PY_BINARY_SUBSCR: return 4;
+        case PY_COMPARE_OP:  return 2;
+        case PY_BINARY_OP:
+        case PY_PRECALL:     return 1;
+        default:             return 0;
+    }
+}
+
+static int efeitoNaPilha(int op, int arg) {
+    switch (op) {
+        case PY_LOAD_CONST: case PY_LOAD_FAST: case PY_LOAD_NAME: case PY_PUSH_NULL:
+            return 1;
+        case PY_LOAD_GLOBAL:
+            return (arg & 1) ? 2 : 1;
+        case PY_STORE_FAST: case PY_STORE_NAME: case PY_POP_TOP: case PY_BINARY_OP:
+        case PY_COMPARE_OP: case PY_POP_JUMP_FORWARD_IF_FALSE: case PY_RETURN_VALUE:
+        case PY_JUMP_IF_FALSE_OR_POP: case PY_JUMP_IF_TRUE_OR_POP: case PY_BINARY_SUBSCR:
+            return -1;
+        case PY_BUILD_TUPLE:
+            return 1 - arg;
+        case PY_CALL:
+            return -(arg + 1);
+        default:
+            return 0;
+    }
+}
+
+static void instrucao(int op, int arg) {
+    if (n_instrucoes == cap_instrucoes) {
+        cap_instrucoes = cap_instrucoes ? cap_instrucoes * 2 : 256;
+        instrucoes = alocar(instrucoes, sizeof(Instrucao) * cap_instrucoes);
+    }
+    Instrucao* i = &instrucoes[n_instrucoes++];
+    i->op = (uint8_t)op;
+    i->arg = arg;
+    i->rotulo = -1;
+    i->linha = linha_atual;
+    profundidade += efeitoNaPilha(op, arg);
+    if (profundidade > profundidade_max) profundidade_max = profundidade;
+}
+
+static int novoRotulo(void) {
+    if (n_rotulos == cap_rotulos) {
+        cap_rotulos = cap_rotulos ? cap_rotulos * 2 : 64;
+        rotulos = alocar(rotulos, sizeof(int) * cap_rotulos);
+    }
+    rotulos[n_rotulos] = -1;
+    return n_rotulos++;
+}
+
+// O rótulo passa a apontar para a próxima instrução emitida
+static void marcar(int rotulo) {
+    rotulos[rotulo] = n_instrucoes;
+}
+
+static void salto(int op, int rotulo) {
+    instrucao(op, 0);
+    instrucoes[n_instrucoes - 1].rotulo = rotulo;
+}
+
+static int constante(const char* texto, size_t n) {
+    return tabelaIndice(&constantes, texto, n, 1);
+}
+
+static const char* nomeDe(const Endereco* e, char* buf, size_t tam) {
+    if (e->tipo == ADDR_VAR) return e->val.varName;
+    if (e->tipo == ADDR_TEMP) {
+        snprintf(buf, tam, "t%d", e->val.tempId);
+        return buf;
+    }
+    return "_";
+}
+
+static void carregar(const Endereco* e) {
+    char buf[64];
+    switch (e->tipo) {
+        case ADDR_CONST_INT:
+            snprintf(buf, sizeof(buf), "i%lld", e->val.constInt);
+            instrucao(PY_LOAD_CONST, constante(buf, strlen(buf)));
+            return;
+        case ADDR_CONST_FLT: {
+            // Os bits exatos: pygen imprime a representação mais curta que
+            // volta ao mesmo double
+            double v = e->val.constFlt;
+            uint64_t bits;
+            memcpy(&bits, &v, sizeof(bits));
+            snprintf(buf, sizeof(buf), "f%016llx", (unsigned long long)bits);
+            instrucao(PY_LOAD_CONST, constante(buf, strlen(buf)));
+            return;
+        }
+        case ADDR_CONST_STR: {
+            Bytes s = { NULL, 0, 0 };
+            b_byte(&s, 's');
+            decodificarString(&s, e->val.varName);
+            instrucao(PY_LOAD_CONST, constante((char*)s.d, s.n));
+            free(s.d);
+            return;
+        }
+        default: {
+            const char* nome = nomeDe(e, buf, sizeof(buf));
+            int local = tabelaIndice(&locais, nome, strlen(nome), 0);
+            if (local >= 0) instrucao(PY_LOAD_FAST, local);
+            else instrucao(PY_LOAD_GLOBAL, tabelaIndice(&globais, nome, strlen(nome), 1) << 1);
+            return;
+        }
+    }
+}
+
+// Função a chamar, com o NULL que CALL espera abaixo dela
+static void carregarFuncao(const char* nome) {
+    int local = tabelaIndice(&locais, nome, strlen(nome), 0);
+    if (local >= 0) {
+        instrucao(PY_PUSH_NULL, 0);
+        instrucao(PY_LOAD_FAST, local);
+    } else {
+        instrucao(PY_LOAD_GLOBAL, (tabelaIndice(&globais, nome, strlen(nome), 1) << 1) | 1);
+    }
+}
+
+static void chamar(int n) {
+    instrucao(PY_PRECALL, n);
+    instrucao(PY_CALL, n);
+}
+
+static void guardar(const Endereco* e) {
+    char buf[64];
+    if (e->tipo != ADDR_VAR && e->tipo != ADDR_TEMP) {
+        instrucao(PY_POP_TOP, 0);
+        return;
+    }
+    const char* nome = nomeDe(e, buf, sizeof(buf));
+    instrucao(PY_STORE_FAST, tabelaIndice(&locais, nome, strlen(nome), 1));
+}
+
+// --- Montagem do code object ---
+
+static int extensoes(unsigned arg) {
+    return arg > 0xffffff ? 3 : arg > 0xffff ? 2 : arg > 0xff ? 1 : 0;
+}
+
+static void svarint(Bytes* b, int v) {
+    unsigned u = v < 0 ? ((unsigned)(-v) << 1) | 1 : (unsigned)v << 1;
+    while (u >= 64) {
+        b_byte(b, 0x40 | (u & 0x3f));
+        u >>= 6;
+    }
+    b_byte(b, (int)u);
+}
+
+// Resolve os saltos (com EXTENDED_ARG onde o deslocamento não cabe em um
+// byte, o que pode afastar outros destinos: repete até estabilizar) e
+// escreve o bytecode e a tabela de linhas (só linhas, sem colunas)
+static void montar(Bytes* codigo, Bytes* linhas) {
+    int* ext = alocar(NULL, sizeof(int) * (n_instrucoes + 1));
+    int* pos = alocar(NULL, sizeof(int) * (n_instrucoes + 1));
+    for (int i = 0; i < n_instrucoes; i++) ext[i] = instrucoes[i].rotulo < 0 ? extensoes((unsigned)instrucoes[i].arg) : 0;
+
+    for (int mudou = 1; mudou; ) {
+        mudou = 0;
+        pos[0] = 0;
+        for (int i = 0; i < n_instrucoes; i++) pos[i + 1] = pos[i] + ext[i] + 1 + cachesDe(instrucoes[i].op);
+        for (int i = 0; i < n_instrucoes; i++) {
+            Instrucao* in = &instrucoes[i];
+            if (in->rotulo < 0) continue;
+            int alvo = pos[rotulos[in->rotulo]];
+            in->arg = in->op == PY_JUMP_BACKWARD ? pos[i + 1] - alvo : alvo - pos[i + 1];
+            int e = extensoes((unsigned)in->arg);
+            if (e > ext[i]) {
+                ext[i] = e;
+                mudou = 1;
+            }
+        }
+    }
+
+    int linha = primeira_linha;
+    for (int i = 0; i < n_instrucoes; i++) {
+        Instrucao* in = &instrucoes[i];
+        for (int k = ext[i]; k > 0; k--) {
+            b_byte(codigo, PY_EXTENDED_ARG);
+            b_byte(codigo, ((unsigned)in->arg >> (8 * k)) & 0xff);
+        }
+        b_byte(codigo, in->op);
+        b_byte(codigo, in->arg & 0xff);
+        for (int k = cachesDe(in->op); k > 0; k--) {
+            b_byte(codigo, 0);
+            b_byte(codigo, 0);
+        }
+
+        // Entradas de até 8 unidades de código: 1 cccc lll, código 13
+        // (sem colunas) seguido da diferença de linha
+        int unidades = ext[i] + 1 + cachesDe(in->op);
+        int delta = in->linha - linha;
+        linha = in->linha;
+        while (unidades > 0) {
+            int n = unidades > 8 ? 8 : unidades;
+            b_byte(linhas, 0x80 | (13 << 3) | (n - 1));
+            svarint(linhas, delta);
+            delta = 0;
+            unidades -= n;
+        }
+    }
+    free(ext);
+    free(pos);
+}
+
+// Code object com as instruções correntes; `consts` já vem serializada
+static void escreverCodigo(Bytes* b, int flags, const Bytes* consts, const Tabela* nomes,
+                           const Tabela* vars, const char* nome) {
+    Bytes codigo = { NULL, 0, 0 }, linhas = { NULL, 0, 0 };
+    montar(&codigo, &linhas);
+
+    b_byte(b, 'c');
+    b_u32(b, 0);                        // argcount
+    b_u32(b, 0);                        // posonlyargcount
+    b_u32(b, 0);                        // kwonlyargcount
+    b_u32(b, (uint32_t)profundidade_max);
+    b_u32(b, (uint32_t)flags);
+    m_bytes(b, codigo.d, codigo.n);
+    b_dados(b, consts->d, consts->n);
+    m_nomes(b, nomes);
+    m_nomes(b, vars);                   // localsplusnames
+    b_byte(b, 's');                     // localspluskinds
+    b_u32(b, (uint32_t)vars->n);
+    for (int i = 0; i < vars->n; i++) b_byte(b, CO_FAST_LOCAL);
+    m_str(b, arquivo_fonte, strlen(arquivo_fonte), 0);
+    m_str(b, nome, strlen(nome), 1);    // name
+    m_str(b, nome, strlen(nome), 1);    // qualname
+    b_u32(b, (uint32_t)primeira_linha);
+    m_bytes(b, linhas.d, linhas.n);
+    m_bytes(b, "", 0);                  // exceptiontable
+
+    free(codigo.d);
+    free(linhas.d);
+}
+
+static void reiniciarFuncao(void) {
+    n_instrucoes = 0;
+    n_rotulos = 0;
+    n_estruturas = 0;
+    n_params = 0;
+    profundidade = profundidade_max = 0;
+    tabelaLimpar(&locais);
+    tabelaLimpar(&globais);
+    tabelaLimpar(&constantes);
+}
+
+// --- Tradução das quádruplas ---
+
+static void empilharEstrutura(int laco, int a, int b) {
+    if (n_estruturas == cap_estruturas) {
+        cap_estruturas = cap_estruturas ? cap_estruturas * 2 : 32;
+        estruturas = alocar(estruturas, sizeof(Estrutura) * cap_estruturas);
+    }
+    estruturas[n_estruturas].laco = laco;
+    estruturas[n_estruturas].a = a;
+    estruturas[n_estruturas].b = b;
+    estruturas[n_estruturas].tem_senao = 0;
+    n_estruturas++;
+}
+
+static void empilharParam(Endereco* e) {
+    if (n_params == cap_params) {
+        cap_params = cap_params ? cap_params * 2 : 16;
+        params = alocar(params, sizeof(Endereco*) * cap_params);
+    }
+    params[n_params++] = e;
+}
+
+// Função da biblioteca chamada por um CALL (nome e número de argumentos)
+static const FuncaoBiblioteca* funcaoBiblioteca(const Quadrupla* q) {
+    const FuncaoBiblioteca* f = biblioteca_buscar(q->arg1.val.varName);
+    return f && f->n_args == q->arg2.val.constInt ? f : NULL;
+}
+
+// Nome Python que uma chamada à biblioteca invoca: a ligação, quando o
+// modelo é só a chamada dela (ex: _fabs), ou o invólucro _b_<nome> que o
+// prelúdio do módulo define com o modelo inteiro (não há compilador de
+// Python aqui para traduzir as guardas em bytecode)
+static const char* nomeBiblioteca(const FuncaoBiblioteca* f, char* buf, size_t tam) {
+    const char* direta = biblioteca_chamada_direta(f);
+    if (direta) snprintf(buf, tam, "%s", direta);
+    else snprintf(buf, tam, "_b_%s", f->nome);
+    return buf;
+}
+
+// Com --ligar: as funções da biblioteca que o corpo chama passam a
+// variáveis locais, lidas uma vez no início
+static void ligarBiblioteca(Quadrupla* inicio) {
+    char buf[64];
+    for (Quadrupla* q = inicio->next; q && q->op != CG_FUNC_END; q = q->next) {
+        const FuncaoBiblioteca* f;
+        if (q->op != CG_CALL || !(f = funcaoBiblioteca(q))) continue;
+        const char* nome = nomeBiblioteca(f, buf, sizeof(buf));
+        if (tabelaIndice(&locais, nome, strlen(nome), 0) >= 0) continue;
+        instrucao(PY_LOAD_GLOBAL, tabelaIndice(&globais, nome, strlen(nome), 1) << 1);
+        instrucao(PY_STORE_FAST, tabelaIndice(&locais, nome, strlen(nome), 1));
+    }
+}
+
+static void gerarChamada(Quadrupla* q) {
+    const char* nome = q->arg1.val.varName;
+    const FuncaoBiblioteca* f = funcaoBiblioteca(q);
+    char buf[64];
+    int n = q->arg2.val.constInt;
+    if (n > n_params) n = n_params;
+
+    // Os parâmetros foram empilhados na ordem inversa: o topo é o primeiro
+    Endereco** args = params + n_params - n;
+    n_params -= n;
+
+    if (strcmp(nome, "printf") == 0 && n > 0) {
+        // print(formato % valores), como em pygen.c
+        carregarFuncao("print");
+        carregar(args[n - 1]);
+        if (n == 2) {
+            carregar(args[0]);
+            instrucao(PY_BINARY_OP, NB_REMAINDER);
+        } else if (n > 2) {
+            for (int i = n - 2; i >= 0; i--) carregar(args[i]);
+            instrucao(PY_BUILD_TUPLE, n - 1);
+            instrucao(PY_BINARY_OP, NB_REMAINDER);
+        }
+        chamar(1);
+    } else {
+        if (f) {
+            usadas |= 1ULL << biblioteca_indice(f);
+            nome = nomeBiblioteca(f, buf, sizeof(buf));
+        }
+        carregarFuncao(nome);
+        for (int i = n - 1; i >= 0; i--) carregar(args[i]);
+        chamar(n);
+    }
+    guardar(&q->resultado);
+}
+
+// Constante inteira de qualquer valor de 64 bits, com ou sem sinal
+static void carregarInteiro(unsigned long long v, int sem_sinal) {
+    char buf[32];
+    if (sem_sinal) snprintf(buf, sizeof(buf), "i%llu", v);
+    else snprintf(buf, sizeof(buf), "i%lld", (long long)v);
+    instrucao(PY_LOAD_CONST, constante(buf, strlen(buf)));
+}
+
+// Quociente truncado para zero, como o do C. Sem sinal: a // b. Até 32
+// bits: int(a / b), exato em double. Em 64 bits, com o sinal dos operandos:
+// a // b if (a ^ b) >= 0 else -(-a // b)
+static void divisaoTruncada(Quadrupla* q) {
+    if (tipoSemSinal(q->tipo)) {
+        carregar(&q->arg1);
+        carregar(&q->arg2);
+        instrucao(PY_BINARY_OP, NB_FLOOR_DIVIDE);
+        return;
+    }
+    if (bitsTipo(q->tipo) <= 32) {
+        carregarFuncao("int");
+        carregar(&q->arg1);
+        carregar(&q->arg2);
+        instrucao(PY_BINARY_OP, NB_TRUE_DIVIDE);
+        chamar(1);
+        return;
+    }
+    int negativo = novoRotulo(), fim = novoRotulo();
+    carregar(&q->arg1);
+    carregar(&q->arg2);
+    instrucao(PY_BINARY_OP, NB_XOR);
+    instrucao(PY_LOAD_CONST, constante("i0", 2));
+    instrucao(PY_COMPARE_OP, CMP_GE);
+    salto(PY_POP_JUMP_FORWARD_IF_FALSE, negativo);
+    carregar(&q->arg1);
+    carregar(&q->arg2);
+    instrucao(PY_BINARY_OP, NB_FLOOR_DIVIDE);
+    salto(PY_JUMP_FORWARD, fim);
+    profundidade--;             // o outro ramo empilha o mesmo quociente
+    marcar(negativo);
+    carregar(&q->arg1);
+    instrucao(PY_UNARY_NEGATIVE, 0);
+    carregar(&q->arg2);
+    instrucao(PY_BINARY_OP, NB_FLOOR_DIVIDE);
+    instrucao(PY_UNARY_NEGATIVE, 0);
+    marcar(fim);
+}
+
+// Variáveis locais: tudo o que é escrito na função (como o Python decide)
+static void declararLocais(Quadrupla* inicio) {
+    char buf[64];
+    for (Quadrupla* q = inicio->next; q && q->op != CG_FUNC_END; q = q->next) {
+        if (!opcodeDeValor(q->op) && q->op != CG_CALL) continue;
+        if (q->resultado.tipo != ADDR_VAR && q->resultado.tipo != ADDR_TEMP) continue;
+        const char* nome = nomeDe(&q->resultado, buf, sizeof(buf));
+        tabelaIndice(&locais, nome, strlen(nome), 1);
+    }
+}
+
+static void terminarFuncao(void) {
+    Bytes consts = { NULL, 0, 0 };
+    instrucao(PY_LOAD_CONST, constante("N", 1));
+    instrucao(PY_RETURN_VALUE, 0);
+    m_constantes(&consts, &constantes);
+    escreverCodigo(&funcoes, CO_OPTIMIZED | CO_NEWLOCALS, &consts, &globais, &locais, nome_funcao);
+    free(consts.d);
+    free(nome_funcao);
+    nome_funcao = NULL;
+}
+
+static void gerarQuadrupla(Quadrupla* q) {
+    int binario = -1, comparacao = -1, unario = -1;
+
+    if (q->linha > 0) linha_atual = q->linha;
+
+    switch (q->op) {
+        case CG_ASSIGN:
+            carregar(&q->arg1);
+            guardar(&q->resultado);
+            return;
+
+        case CG_ADD: binario = NB_ADD; break;
+        case CG_SUB: binario = NB_SUBTRACT; break;
+        case CG_MUL: binario = NB_MULTIPLY; break;
+        case CG_DIV: binario = NB_TRUE_DIVIDE; break;
+        case CG_BIT_AND: binario = NB_AND; break;
+        case CG_BIT_OR:  binario = NB_OR; break;
+        case CG_BIT_XOR: binario = NB_XOR; break;
+        case CG_SHL:     binario = NB_LSHIFT; break;
+        case CG_SHR:     binario = NB_RSHIFT; break;
+        case CG_LT:  comparacao = CMP_LT; break;
+        case CG_GT:  comparacao = CMP_GT; break;
+        case CG_LTE: comparacao = CMP_LE; break;
+        case CG_GTE: comparacao = CMP_GE; break;
+        case CG_EQ:  comparacao = CMP_EQ; break;
+        case CG_NEQ: comparacao = CMP_NE; break;
+        case CG_UMINUS:  unario = PY_UNARY_NEGATIVE; break;
+        case CG_BIT_NOT: unario = PY_UNARY_INVERT; break;
+
+        case CG_IDIV:
+            divisaoTruncada(q);
+            guardar(&q->resultado);
+            return;
+
+        // a % b sem sinal; senão a - b * (quociente truncado)
+        case CG_MOD:
+            if (tipoSemSinal(q->tipo)) {
+                binario = NB_REMAINDER;
+                break;
+            }
+            carregar(&q->arg1);
+            carregar(&q->arg2);
+            divisaoTruncada(q);
+            instrucao(PY_BINARY_OP, NB_MULTIPLY);
+            instrucao(PY_BINARY_OP, NB_SUBTRACT);
+            guardar(&q->resultado);
+            return;
+
+        // float(a), a & M (sem sinal) ou (a + H & M) - H (com sinal), com
+        // M = 2**N - 1 e H = 2**(N - 1) para a largura N do tipo
+        case CG_CONVERT:
+            if (tipoFlutuante(q->tipo)) {
+                carregarFuncao("float");
+                carregar(&q->arg1);
+                chamar(1);
+            } else {
+                int bits = bitsTipo(q->tipo);
+                unsigned long long mascara = bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+                carregar(&q->arg1);
+                if (!tipoSemSinal(q->tipo)) {
+                    carregarInteiro(1ULL << (bits - 1), 1);
+                    instrucao(PY_BINARY_OP, NB_ADD);
+                }
+                carregarInteiro(mascara, 1);
+                instrucao(PY_BINARY_OP, NB_AND);
+                if (!tipoSemSinal(q->tipo)) {
+                    carregarInteiro(1ULL << (bits - 1), 1);
+                    instrucao(PY_BINARY_OP, NB_SUBTRACT);
+                }
+            }
+            guardar(&q->resultado);
+            return;
+
+        // _f32u(_f32p(a))[0]
+        case CG_F32:
+            usa_f32 = 1;
+            carregarFuncao("_f32u");
+            carregarFuncao("_f32p");
+            carregar(&q->arg1);
+            chamar(1);
+            chamar(1);
+            instrucao(PY_LOAD_CONST, constante("i0", 2));
+            instrucao(PY_BINARY_SUBSCR, 0);
+            guardar(&q->resultado);
+            return;
+
+        // int(a != 0 and b != 0), com o curto-circuito do Python
+        case CG_AND:
+        case CG_OR: {
+            int fim = novoRotulo();
+            carregarFuncao("int");
+            carregar(&q->arg1);
+            instrucao(PY_LOAD_CONST, constante("i0", 2));
+            instrucao(PY_COMPARE_OP, CMP_NE);
+            salto(q->op == CG_AND ? PY_JUMP_IF_FALSE_OR_POP : PY_JUMP_IF_TRUE_OR_POP, fim);
+            carregar(&q->arg2);
+            instrucao(PY_LOAD_CONST, constante("i0", 2));
+            instrucao(PY_COMPARE_OP, CMP_NE);
+            marcar(fim);
+            chamar(1);
+            guardar(&q->resultado);
+            return;
+        }
+
+        case CG_NOT:
+            carregarFuncao("int");
+            carregar(&q->arg1);
+            instrucao(PY_UNARY_NOT, 0);
+            chamar(1);
+            guardar(&q->resultado);
+            return;
+
+        case CG_PARAM:
+            empilharParam(&q->arg1);
+            return;
+
+        case CG_CALL:
+            gerarChamada(q);
+            return;
+
+        case CG_IF_START:
+            carregar(&q->arg1);
+            empilharEstrutura(0, novoRotulo(), novoRotulo());
+            salto(PY_POP_JUMP_FORWARD_IF_FALSE, estruturas[n_estruturas - 1].a);
+            return;
+
+        case CG_ELSE_START:
+            if (n_estruturas == 0) return;
+            salto(PY_JUMP_FORWARD, estruturas[n_estruturas - 1].b);
+            marcar(estruturas[n_estruturas - 1].a);
+            estruturas[n_estruturas - 1].tem_senao = 1;
+            return;
+
+        case CG_IF_END:
+            if (n_estruturas == 0) return;
+            n_estruturas--;
+            marcar(estruturas[n_estruturas].tem_senao ? estruturas[n_estruturas].b : estruturas[n_estruturas].a);
+            return;
+
+        // while True: ... com `if not c: break`
+        case CG_WHILE_START:
+        case CG_DO_WHILE_START: {
+            int topo = novoRotulo();
+            marcar(topo);
+            empilharEstrutura(1, topo, novoRotulo());
+            return;
+        }
+
+        case CG_BREAK_IF_FALSE: {
+            int e = n_estruturas - 1;
+            while (e >= 0 && !estruturas[e].laco) e--;
+            if (e < 0) return;
+            carregar(&q->arg1);
+            salto(PY_POP_JUMP_FORWARD_IF_FALSE, estruturas[e].b);
+            return;
+        }
+
+        // break: para a saída do laço; continue: de volta ao topo
+        case CG_BREAK:
+        case CG_CONTINUE: {
+            int e = n_estruturas - 1;
+            while (e >= 0 && !estruturas[e].laco) e--;
+            if (e < 0) return;
+            if (q->op == CG_BREAK) salto(PY_JUMP_FORWARD, estruturas[e].b);
+            else salto(PY_JUMP_BACKWARD, estruturas[e].a);
+            return;
+        }
+
+        case CG_WHILE_END:
+        case CG_DO_WHILE_END:
+            if (n_estruturas == 0) return;
+            n_estruturas--;
+            salto(PY_JUMP_BACKWARD, estruturas[n_estruturas].a);
+            marcar(estruturas[n_estruturas].b);
+            return;
+
+        case CG_RETURN:
+            if (q->arg1.tipo == ADDR_EMPTY) instrucao(PY_LOAD_CONST, constante("N", 1));
+            else carregar(&q->arg1);
+            instrucao(PY_RETURN_VALUE, 0);
+            return;
+
+        case CG_FUNC_START:
+            reiniciarFuncao();
+            nome_funcao = strdup(q->arg1.val.varName);
+            if (!nome_funcao) alocar(NULL, 1);
+            primeira_linha = linha_atual = q->linha > 0 ? q->linha : 1;
+            if (strcmp(nome_funcao, "main") == 0) tem_main = 1;
+            if (n_definicoes == cap_definicoes) {
+                cap_definicoes = cap_definicoes ? cap_definicoes * 2 : 16;
+                definicoes = alocar(definicoes, sizeof(char*) * cap_definicoes);
+            }
+            definicoes[n_definicoes++] = strdup(nome_funcao);
+            declararLocais(q);
+            instrucao(PY_RESUME, 0);
+            if (ligar_biblioteca) ligarBiblioteca(q);
+            return;
+
+        case CG_FUNC_END:
+            if (nome_funcao) terminarFuncao();
+            return;
+
+        default:
+            // THEN_START, BODY_START, WHILE_COND: sem código
+            return;
+    }
+
+    if (unario >= 0) {
+        carregar(&q->arg1);
+        instrucao(unario, 0);
+    } else {
+        carregar(&q->arg1);
+        carregar(&q->arg2);
+        if (binario >= 0) instrucao(PY_BINARY_OP, binario);
+        else instrucao(PY_COMPARE_OP, comparacao);
+    }
+    guardar(&q->resultado);
+}
+
+void gerarPycInicio(const char* arquivo) {
+    free(arquivo_fonte);
+    arquivo_fonte = strdup(arquivo ? arquivo : "<stdin>");
+    if (!arquivo_fonte) alocar(NULL, 1);
+    // Uma tradução anterior interrompida por erro não chegou a gerarPycFim()
+    funcoes.n = 0;
+    for (int i = 0; i < n_definicoes; i++) free(definicoes[i]);
+    n_definicoes = 0;
+    free(nome_funcao);
+    nome_funcao = NULL;
+    tem_main = 0;
+    usa_f32 = 0;
+    usadas = 0;
+}
+
+void gerarPyc(void) {
+    for (Quadrupla* q = code_head; q; q = q->next) {
+        gerarQuadrupla(q);
+    }
+}
+
+// _f32 = __import__('struct').Struct('f'); _f32p = _f32.pack; _f32u = _f32.unpack
+// ('struct' e 'f' são as constantes `indice` e `indice + 1` do módulo)
+static void definirF32(int indice) {
+    int f32 = tabelaIndice(&globais, "_f32", 4, 1);
+    instrucao(PY_PUSH_NULL, 0);
+    instrucao(PY_PUSH_NULL, 0);
+    instrucao(PY_LOAD_NAME, tabelaIndice(&globais, "__import__", 10, 1));
+    instrucao(PY_LOAD_CONST, indice);
+    chamar(1);
+    instrucao(PY_LOAD_ATTR, tabelaIndice(&globais, "Struct", 6, 1));
+    instrucao(PY_LOAD_CONST, indice + 1);
+    chamar(1);
+    instrucao(PY_STORE_NAME, f32);
+    instrucao(PY_LOAD_NAME, f32);
+    instrucao(PY_LOAD_ATTR, tabelaIndice(&globais, "pack", 4, 1));
+    instrucao(PY_STORE_NAME, tabelaIndice(&globais, "_f32p", 5, 1));
+    instrucao(PY_LOAD_NAME, f32);
+    instrucao(PY_LOAD_ATTR, tabelaIndice(&globais, "unpack", 6, 1));
+    instrucao(PY_STORE_NAME, tabelaIndice(&globais, "_f32u", 5, 1));
+}
+
+// Prelúdio da biblioteca, rodado com exec() no módulo: imports, auxiliares,
+// ligações globais e um invólucro para cada modelo que não é uma chamada
+// direta (com --ligar, as ligações do invólucro são parâmetros com valor
+// padrão, lidos como variáveis locais)
+static char* preludioBiblioteca(void) {
+    char* preambulo = biblioteca_preambulo(usadas);
+    ConjuntoBiblioteca ligacoes = 0;
+    size_t tam = strlen(preambulo) + 1;
+    for (int i = 0; biblioteca_funcao(i); i++) {
+        if (usadas & (1ULL << i)) ligacoes |= biblioteca_ligacoes(biblioteca_funcao(i));
+    }
+    char* ligar = biblioteca_ligar(ligacoes, "");
+    tam += strlen(ligar);
+
+    char* texto = alocar(NULL, tam);
+    snprintf(texto, tam, "%s%s", preambulo, ligar);
+    free(preambulo);
+    free(ligar);
+    for (int i = 0; biblioteca_funcao(i); i++) {
+        const FuncaoBiblioteca* f = biblioteca_funcao(i);
+        if (!(usadas & (1ULL << i)) || biblioteca_chamada_direta(f)) continue;
+        static const char* const args[] = { "a0", "a1" };
+        static const char* const params[] = { "", "a0", "a0, a1" };
+        char* expr = biblioteca_expressao(f, args, 1);
+        char* padroes = biblioteca_parametros(ligar_biblioteca ? biblioteca_ligacoes(f) : 0);
+        size_t n = strlen(texto);
+        tam = n + strlen(f->nome) + strlen(padroes) + strlen(expr) + 32;
+        texto = alocar(texto, tam);
+        snprintf(texto + n, tam - n, "def _b_%s(%s%s%s):\n    return %s\n", f->nome, params[f->n_args],
+                 f->n_args && *padroes ? ", " : "", padroes, expr);
+        free(expr);
+        free(padroes);
+    }
+    return texto;
+}
+
+// Módulo: define as funções na ordem do fonte e chama main(), se houver
+void gerarPycFim(void) {
+    Bytes modulo = { NULL, 0, 0 }, consts = { NULL, 0, 0 };
+    int n = n_definicoes;
+    int preludio = n + 1 + (usa_f32 ? 2 : 0);   // índice da constante
+
+    reiniciarFuncao();
+    primeira_linha = linha_atual = 1;
+    instrucao(PY_RESUME, 0);
+    for (int i = 0; i < n; i++) {
+        instrucao(PY_LOAD_CONST, i);
+        instrucao(PY_MAKE_FUNCTION, 0);
+        instrucao(PY_STORE_NAME, tabelaIndice(&globais, definicoes[i], strlen(definicoes[i]), 1));
+    }
+    if (usa_f32) definirF32(n + 1);
+    if (usadas) {
+        instrucao(PY_PUSH_NULL, 0);
+        instrucao(PY_LOAD_NAME, tabelaIndice(&globais, "exec", 4, 1));
+        instrucao(PY_LOAD_CONST, preludio);
+        chamar(1);
+        instrucao(PY_POP_TOP, 0);
+    }
+    if (tem_main) {
+        instrucao(PY_PUSH_NULL, 0);
+        instrucao(PY_LOAD_NAME, tabelaIndice(&globais, "main", 4, 1));
+        chamar(0);
+        instrucao(PY_POP_TOP, 0);
+    }
+    instrucao(PY_LOAD_CONST, n);
+    instrucao(PY_RETURN_VALUE, 0);
+
+    // Constantes do módulo: os code objects das funções, None, com F32
+    // 'struct' e 'f' e, com a biblioteca, o texto do prelúdio
+    m_tupla(&consts, preludio + (usadas ? 1 : 0));
+    b_dados(&consts, funcoes.d, funcoes.n);
+    b_byte(&consts, 'N');
+    if (usa_f32) {
+        m_str(&consts, "struct", 6, 0);
+        m_str(&consts, "f", 1, 0);
+    }
+    if (usadas) {
+        char* texto = preludioBiblioteca();
+        m_str(&consts, texto, strlen(texto), 0);
+        free(texto);
+    }
+    escreverCodigo(&modulo, 0, &consts, &globais, &locais, "<module>");
+
+    saida_escrever((const char*)PYC_MAGICO, sizeof(PYC_MAGICO));
+    saida_escrever("\0\0\0\0\0\0\0\0\0\0\0\0", 12);  // flags, data, tamanho
+    saida_escrever((const char*)modulo.d, modulo.n);
+
+    free(modulo.d);
+    free(consts.d);
+    free(funcoes.d);
+    memset(&funcoes, 0, sizeof(funcoes));
+    free(instrucoes);
+    free(rotulos);
+    free(estruturas);
+    free(params);
+    instrucoes = NULL;
+    rotulos = NULL;
+    estruturas = NULL;
+    params = NULL;
+    cap_instrucoes = cap_rotulos = cap_estruturas = cap_params = 0;
+    tabelaLiberar(&locais);
+    tabelaLiberar(&globais);
+    tabelaLiberar(&constantes);
+    for (int i = 0; i < n_definicoes; i++) free(definicoes[i]);
+    free(definicoes);
+    definicoes = NULL;
+    n_definicoes = cap_definicoes = 0;
+    free(arquivo_fonte);
+    arquivo_fonte = NULL;
+}
@@ -0,0 +1,22 @@
+#ifndef PYCGEN_H
+#define PYCGEN_H
+
+// --- Geração de .pyc a partir do HLIR ---
+// Mesma tradução de pygen.c (--emit=py), mas direto em bytecode do CPython
+// 3.11 (--emit=pyc): cada função vira um code object montado aqui (código,
+// constantes, nomes e variáveis locais), e o módulo só define as funções e
+// chama main(). O arquivo gerado roda com `python3.11 programa.pyc`, sem o
+// tokenizador, o parser e o compilador do CPython. Outras versões recusam o
+// arquivo pelo número mágico; para elas, --emit=py continua valendo.
+//
+// O comportamento é o do .py gerado, operação por operação (inclusive as
+// constantes float com duas casas, como pygen as imprime). As linhas dos
+// code objects são as do fonte C, e o nome do arquivo, o do fonte.
+//
+// Como o code object do módulo vem antes das funções no arquivo e depende
+// de quantas elas são, as funções ficam em memória até gerarPycFim().
+void gerarPycInicio(const char* arquivo);
+void gerarPyc(void);
+void gerarPycFim(void);
+
+#endif
@@ -0,0 +1,450 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "codegen.h"
+#include "saida.h"
+#include "pygen.h"
+#include "biblioteca.h"
+
+#define MAX_ANINHAMENTO 256
+
+// Estado da tradução
+static int nivel = 0;                        // nível de indentação
+static int vazio[MAX_ANINHAMENTO];           // bloco aberto ainda sem comandos?
+static int n_blocos = 0;
+static int linhas_geradas = 0;
+static int tem_main = 0;                     // alguma função se chama main?
+static int usa_f32 = 0;                      // algum F32 (precisa de _f32p/_f32u)?
+static ConjuntoBiblioteca usadas = 0;        // funções da biblioteca chamadas
+
+static Endereco** params = NULL;             // pilha de PARAMs pendentes
+static int n_params = 0, cap_params = 0;
+
+// Máscara de bits de um tipo inteiro (2**N - 1)
+static unsigned long long mascaraTipo(TipoDadoCG tipo) {
+    return bitsTipo(tipo) == 64 ? ~0ULL : (1ULL << bitsTipo(tipo)) - 1;
+}
+
+static void indentar(int n) {
+    for (int i = 0; i < n; i++) saida_texto("    ");
+}
+
+// Início de uma linha de código Python no nível atual
+static void linha(void) {
+    indentar(nivel);
+    if (n_blocos > 0) vazio[n_blocos - 1] = 0;
+    linhas_geradas++;
+}
+
+static void abrir_bloco(void) {
+    if (n_blocos < MAX_ANINHAMENTO) vazio[n_blocos++] = 1;
+    nivel++;
+}
+
+// Um bloco C vazio precisa de `pass` para ser Python válido
+static void completar_bloco(void) {
+    if (n_blocos > 0 && vazio[n_blocos - 1]) {
+        linha();
+        saida_texto("pass\n");
+    }
+}
+
+static void fechar_bloco(void) {
+    completar_bloco();
+    if (n_blocos > 0) n_blocos--;
+    nivel--;
+}
+
+static void empilhar_param(Endereco* e) {
+    if (n_params == cap_params) {
+        cap_params = cap_params ? cap_params * 2 : 16;
+        params = realloc(params, sizeof(Endereco*) * cap_params);
+    }
+    params[n_params++] = e;
+}
+
+// Texto Python de um operando (alocado)
+static char* textoEndereco(const Endereco* e) {
+    char buf[64];
+    switch (e->tipo) {
+        case ADDR_VAR:
+        case ADDR_CONST_STR: return strdup(e->val.varName);
+        case ADDR_TEMP:      snprintf(buf, sizeof(buf), "t%d", e->val.tempId); break;
+        case ADDR_CONST_INT: snprintf(buf, sizeof(buf), "%lld", e->val.constInt); break;
+        case ADDR_CONST_FLT: formatarFloat(e->val.constFlt, buf, sizeof(buf)); break;
+        default:             strcpy(buf, "None"); break;
+    }
+    return strdup(buf);
+}
+
+// Função da biblioteca (biblioteca.h) chamada com o número certo de
+// argumentos, ou NULL
+static const FuncaoBiblioteca* funcaoBiblioteca(const Quadrupla* q) {
+    const FuncaoBiblioteca* f = biblioteca_buscar(q->arg1.val.varName);
+    return f && q->arg2.tipo == ADDR_CONST_INT && q->arg2.val.constInt == f->n_args ? f : NULL;
+}
+
+// Expressão da biblioteca, no lugar da chamada
+static void gerarBiblioteca(Quadrupla* q, const FuncaoBiblioteca* f, Endereco** args) {
+    char* textos[2] = { NULL, NULL };
+    for (int i = 0; i < f->n_args; i++) textos[i] = textoEndereco(args[f->n_args - 1 - i]);
+    char* expressao = biblioteca_expressao(f, (const char* const*)textos, ligar_biblioteca);
+    usadas |= 1ULL << biblioteca_indice(f);
+
+    if (q->resultado.tipo != ADDR_EMPTY) {
+        imprimirEndereco(q->resultado);
+        saida_texto(" = ");
+    }
+    saida_texto(expressao);
+    saida_char('\n');
+    free(expressao);
+    for (int i = 0; i < f->n_args; i++) free(textos[i]);
+}
+
+static void gerarChamada(Quadrupla* q) {
+    const char* nome = q->arg1.val.varName;
+    const FuncaoBiblioteca* f = funcaoBiblioteca(q);
+    int n = q->arg2.val.constInt;
+    if (n > n_params) n = n_params;
+
+    // Os parâmetros foram empilhados na ordem inversa: o topo é o primeiro
+    Endereco** args = params + n_params - n;
+    n_params -= n;
+
+    linha();
+    if (f && n == f->n_args) {
+        gerarBiblioteca(q, f, args);
+    } else if (strcmp(nome, "printf") == 0 && n > 0) {
+        // printf não existe em Python: vira print(formato % valores)
+        saida_texto("print(");
+        imprimirEndereco(*args[n - 1]);
+        if (n == 2) {
+            saida_texto(" % ");
+            imprimirEndereco(*args[0]);
+        } else if (n > 2) {
+            saida_texto(" % (");
+            for (int i = n - 2; i >= 0; i--) {
+                imprimirEndereco(*args[i]);
+                if (i > 0) saida_texto(", ");
+            }
+            saida_char(')');
+        }
+        saida_texto(")\n");
+    } else {
+        if (q->resultado.tipo != ADDR_EMPTY) {
+            imprimirEndereco(q->resultado);
+            saida_texto(" = ");
+        }
+        saida_texto(nome);
+        saida_char('(');
+        for (int i = n - 1; i >= 0; i--) {
+            imprimirEndereco(*args[i]);
+            if (i > 0) saida_texto(", ");
+        }
+        saida_texto(")\n");
+    }
+}
+
+// No início da função: `_x = valor` para cada ligação que as chamadas da
+// biblioteca no corpo usam, lidas depois como variáveis locais
+static void ligarBiblioteca(Quadrupla* inicio) {
+    ConjuntoBiblioteca ligacoes = 0;
+    for (Quadrupla* q = inicio->next; q && q->op != CG_FUNC_END; q = q->next) {
+        const FuncaoBiblioteca* f = q->op == CG_CALL ? funcaoBiblioteca(q) : NULL;
+        if (f) ligacoes |= biblioteca_ligacoes(f);
+    }
+    if (!ligacoes) return;
+
+    char indentacao[4 * MAX_ANINHAMENTO + 1];
+    int n = nivel < MAX_ANINHAMENTO ? nivel : MAX_ANINHAMENTO;
+    memset(indentacao, ' ', 4 * n);
+    indentacao[4 * n] = '\0';
+    char* texto = biblioteca_ligar(ligacoes, indentacao);
+    saida_texto(texto);
+    free(texto);
+    if (n_blocos > 0) vazio[n_blocos - 1] = 0;
+    linhas_geradas++;
+}
+
+static void gerarQuadrupla(Quadrupla* q) {
+    const char* simbolo = NULL;
+
+    switch (q->op) {
+        case CG_ASSIGN:
+            linha();
+            imprimirEndereco(q->resultado);
+            saida_texto(" = ");
+            imprimirEndereco(q->arg1);
+            saida_char('\n');
+            return;
+
+        case CG_ADD: simbolo = "+";  break;
+        case CG_SUB: simbolo = "-";  break;
+        case CG_MUL: simbolo = "*";  break;
+        case CG_DIV: simbolo = "/";  break;
+        case CG_LT:  simbolo = "<";  break;
+        case CG_GT:  simbolo = ">";  break;
+        case CG_LTE: simbolo = "<="; break;
+        case CG_GTE: simbolo = ">="; break;
+        case CG_EQ:  simbolo = "=="; break;
+        case CG_NEQ: simbolo = "!="; break;
+        case CG_BIT_AND: simbolo = "&";  break;
+        case CG_BIT_OR:  simbolo = "|";  break;
+        case CG_BIT_XOR: simbolo = "^";  break;
+        case CG_SHL:     simbolo = "<<"; break;
+        case CG_SHR:     simbolo = ">>"; break;
+
+        // Divisão e resto inteiros do C truncam em direção a zero; os
+        // operadores // e % do Python arredondam para baixo
+        case CG_IDIV:
+        case CG_MOD:
+            linha();
+            imprimirEndereco(q->resultado);
+            saida_texto(" = ");
+            if (tipoSemSinal(q->tipo)) {
+                // Operandos não negativos: // e % já truncam
+                imprimirEndereco(q->arg1);
+                saida_texto(q->op == CG_IDIV ? " // " : " % ");
+                imprimirEndereco(q->arg2);
+                saida_char('\n');
+                return;
+            }
+            if (q->op == CG_MOD) {
+                imprimirEndereco(q->arg1);
+                saida_texto(" - ");
+                imprimirEndereco(q->arg2);
+                saida_texto(" * ");
+            }
+            if (bitsTipo(q->tipo) > 32) {
+                // Além de 2**53 o quociente em float perde precisão
+                saida_texto("(");
+                imprimirEndereco(q->arg1);
+                saida_texto(" // ");
+                imprimirEndereco(q->arg2);
+                saida_texto(" if (");
+                imprimirEndereco(q->arg1);
+                saida_texto(" ^ ");
+                imprimirEndereco(q->arg2);
+                saida_texto(") >= 0 else -(-");
+                imprimirEndereco(q->arg1);
+                saida_texto(" // ");
+                imprimirEndereco(q->arg2);
+                saida_texto("))\n");
+                return;
+            }
+            saida_texto("int(");
+            imprimirEndereco(q->arg1);
+            saida_texto(" / ");
+            imprimirEndereco(q->arg2);
+            saida_texto(")\n");
+            return;
+
+        // Conversão para a largura do tipo: os ints do Python não têm limite
+        case CG_CONVERT:
+            linha();
+            imprimirEndereco(q->resultado);
+            if (tipoFlutuante(q->tipo)) {
+                saida_texto(" = float(");
+                imprimirEndereco(q->arg1);
+                saida_texto(")\n");
+                return;
+            }
+            saida_texto(tipoSemSinal(q->tipo) ? " = " : " = (");
+            imprimirEndereco(q->arg1);
+            if (tipoSemSinal(q->tipo)) {
+                saida_printf(" & %llu\n", mascaraTipo(q->tipo));
+            } else {
+                unsigned long long meio = 1ULL << (bitsTipo(q->tipo) - 1);
+                saida_printf(" + %llu & %llu) - %llu\n", meio, mascaraTipo(q->tipo), meio);
+            }
+            return;
+
+        // Arredondamento para float de 32 bits, ida e volta pelo struct
+        case CG_F32:
+            usa_f32 = 1;
+            linha();
+            imprimirEndereco(q->resultado);
+            saida_texto(" = _f32u(_f32p(");
+            imprimirEndereco(q->arg1);
+            saida_texto("))[0]\n");
+            return;
+
+        // Lógicos do C resultam em 0 ou 1
+        case CG_AND:
+        case CG_OR:
+            linha();
+            imprimirEndereco(q->resultado);
+            saida_texto(" = int(");
+            imprimirEndereco(q->arg1);
+            saida_texto(q->op == CG_AND ? " != 0 and " : " != 0 or ");
+            imprimirEndereco(q->arg2);
+            saida_texto(" != 0)\n");
+            return;
+
+        case CG_NOT:
+            linha();
+            imprimirEndereco(q->resultado);
+            saida_texto(" = int(not ");
+            imprimirEndereco(q->arg1);
+            saida_texto(")\n");
+            return;
+
+        case CG_BIT_NOT:
+            linha();
+            imprimirEndereco(q->resultado);
+            saida_texto(" = ~");
+            imprimirEndereco(q->arg1);
+            saida_char('\n');
+            return;
+
+        case CG_UMINUS:
+            linha();
+            imprimirEndereco(q->resultado);
+            saida_texto(" = -");
+            imprimirEndereco(q->arg1);
+            saida_char('\n');
+            return;
+
+        case CG_PARAM:
+            empilhar_param(&q->arg1);
+            return;
+
+        case CG_CALL:
+            gerarChamada(q);
+            return;
+
+        case CG_IF_START:
+            linha();
+            saida_texto("if ");
+            imprimirEndereco(q->arg1);
+            saida_texto(":\n");
+            return;
+
+        case CG_WHILE_START:
+        case CG_DO_WHILE_START:
+            linha();
+            saida_texto("while True:\n");
+            return;
+
+        case CG_THEN_START:
+        case CG_BODY_START:
+            abrir_bloco();
+            return;
+
+        case CG_BREAK_IF_FALSE:
+            linha();
+            saida_texto("if not ");
+            imprimirEndereco(q->arg1);
+            saida_texto(":\n");
+            indentar(nivel + 1);
+            saida_texto("break\n");
+            return;
+
+        case CG_BREAK:
+            linha();
+            saida_texto("break\n");
+            return;
+
+        case CG_CONTINUE:
+            linha();
+            saida_texto("continue\n");
+            return;
+
+        case CG_ELSE_START:
+            completar_bloco();
+            indentar(nivel - 1);
+            saida_texto("else:\n");
+            if (n_blocos > 0) vazio[n_blocos - 1] = 1;
+            return;
+
+        case CG_IF_END:
+        case CG_WHILE_END:
+        case CG_DO_WHILE_END:
+            fechar_bloco();
+            return;
+
+        case CG_RETURN:
+            linha();
+            if (q->arg1.tipo == ADDR_EMPTY) {
+                saida_texto("return\n");
+            } else {
+                saida_texto("return ");
+                imprimirEndereco(q->arg1);
+                saida_char('\n');
+            }
+            return;
+
+        case CG_FUNC_START:
+            linha();
+            saida_texto("def ");
+            saida_texto(q->arg1.val.varName);
+            saida_texto("():\n");
+            if (strcmp(q->arg1.val.varName, "main") == 0) tem_main = 1;
+            abrir_bloco();
+            if (ligar_biblioteca) ligarBiblioteca(q);
+            return;
+
+        case CG_FUNC_END:
+            fechar_bloco();
+            return;
+
+        default:
+            // WHILE_COND: sem tradução direta (como em quad_to_python.py)
+            return;
+    }
+
+    // resultado = arg1 op arg2
+    linha();
+    imprimirEndereco(q->resultado);
+    saida_texto(" = ");
+    imprimirEndereco(q->arg1);
+    saida_char(' ');
+    saida_texto(simbolo);
+    saida_char(' ');
+    imprimirEndereco(q->arg2);
+    saida_char('\n');
+}
+
+void gerarPythonInicio(void) {
+    nivel = 0;
+    n_blocos = 0;
+    n_params = 0;
+    linhas_geradas = 0;
+    tem_main = 0;
+    usa_f32 = 0;
+    usadas = 0;
+
+    saida_texto("#======================================\n"
+                "# Código Python Gerado Automaticamente #\n"
+                "#======================================\n"
+                "\n");
+}
+
+void gerarPython(void) {
+    for (Quadrupla* q = code_head; q; q = q->next) {
+        gerarQuadrupla(q);
+    }
+}
+
+void gerarPythonFim(void) {
+    if (linhas_geradas == 0) saida_texto("# (Nenhum código foi gerado)\n");
+    if (usa_f32) {
+        saida_texto("_f32 = __import__('struct').Struct('f')\n"
+                    "_f32p = _f32.pack\n"
+                    "_f32u = _f32.unpack\n");
+    }
+    if (usadas) {
+        char* preambulo = biblioteca_preambulo(usadas);
+        saida_texto(preambulo);
+        free(preambulo);
+    }
+    if (tem_main) saida_texto("main()\n");
+    saida_texto("\n"
+                "#========================================\n"
+                "#       Fim do Código Gerado         #\n"
+                "#========================================\n");
+
+    free(params);
+    params = NULL;
+    cap_params = 0;
+}
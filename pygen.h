@@ -0,0 +1,16 @@
+#ifndef PYGEN_H
+#define PYGEN_H
+
+// --- Geração de Python a partir do HLIR ---
+// Mesma tradução feita por quad_to_python.py, mas direto das quádruplas em
+// memória (--emit=py), sem reimprimir e reanalisar o texto do HLIR.
+// A saída é escrita pelo buffer de saida.h.
+//
+// gerarPythonInicio() escreve o cabeçalho, gerarPython() traduz as
+// quádruplas correntes (chamada uma vez por função) e gerarPythonFim()
+// escreve a chamada a main() e o rodapé.
+void gerarPythonInicio(void);
+void gerarPython(void);
+void gerarPythonFim(void);
+
+#endif
@@ -18,6 +18,8 @@ e um stack de parâmetros.
 
 import sys
 import re
+import json
+import argparse
 
 def parse_instruction(line):
     """
@@ -28,13 +30,31 @@ def parse_instruction(line):
     if not line:
         return None
 
-    # Padrão geral para capturar opcode e o resto da linha
-    match = re.match(r"^\s*\d*:\s*([A-Z_]+)\s*(.*)$", line)
+    # Padrão geral para capturar opcode e o resto da linha.
+    # A posição no fonte C ("@linha:coluna") é opcional.
+    match = re.match(r"^\s*\d*:\s*(?:@(\d+):(\d+)\s+)?([A-Z_][A-Z0-9_]*)\s*(.*)$", line)
     if not match:
         return None
 
-    opcode, rest = match.groups()
-    instr = {"opcode": opcode, "args": []}
+    c_line, c_col, opcode, rest = match.groups()
+    instr = {"opcode": opcode, "args": [],
+             "line": int(c_line) if c_line else 0,
+             "col": int(c_col) if c_col else 0}
+
+    # Opcodes de um único operando: o operando pode ser uma string com
+    # vírgulas ou "=" dentro (ex: PARAM "a, b <= c\n")
+    if opcode in ('PARAM', 'RETURN', 'IF_START', 'BREAK_IF_FALSE', 'WHILE_COND', 'FUNC_START'):
+        if rest:
+            instr["args"] = [rest.strip()]
+        return instr
+    if opcode == 'CALL':
+        # Com valor: CALL t0 = sqrt, 1
+        match_result = re.match(r"^([^\s=\"]+)\s*=\s*(.*)$", rest)
+        if match_result:
+            instr["result"] = match_result.group(1)
+            rest = match_result.group(2)
+        instr["args"] = [p.strip() for p in rest.rsplit(',', 1)]
+        return instr
 
     # Padrão para "res = arg1 op arg2" ou "res = op arg1"
     # Ex: t0 = a < b, t1 = -t0, res = a
@@ -59,21 +79,185 @@ def parse_instruction(line):
     return instr
 
 
-def translate_hlir_to_python(instructions):
+# Inteiros do C (LP64): largura em bits e se é sem sinal. O HLIR anota com
+# o tipo as conversões (CONV) e as divisões que não são de int.
+INT_TYPES = {
+    'char': (8, False), 'signed char': (8, False), 'unsigned char': (8, True),
+    'short': (16, False), 'unsigned short': (16, True),
+    'int': (32, False), 'unsigned int': (32, True),
+    'long': (64, False), 'unsigned long': (64, True),
+    'long long': (64, False), 'unsigned long long': (64, True),
+}
+
+# Arredondamento para float de 32 bits (F32, com --float32=1)
+F32_HELPER = [
+    "_f32 = __import__('struct').Struct('f')",
+    "_f32p = _f32.pack",
+    "_f32u = _f32.unpack",
+]
+
+
+# Biblioteca padrão do C, como em biblioteca.c: ligações (`_x = valor`),
+# auxiliares de nível de módulo e, para cada função, o número de argumentos
+# e o modelo da expressão ($0, $1: argumentos; @x: ligação)
+LIBRARY_BINDINGS = {
+    'sqrt': '_math.sqrt', 'exp': '_math.exp', 'log': '_math.log', 'log10': '_math.log10',
+    'sin': '_math.sin', 'cos': '_math.cos', 'atan2': '_math.atan2', 'fmod': '_math.fmod',
+    'fabs': '_math.fabs', 'floor': '_math.floor', 'ceil': '_math.ceil', 'trunc': '_math.trunc',
+    'copysign': '_math.copysign', 'inf': '_math.inf', 'nan': '_math.nan',
+    'pow': '_c_pow', 'abs': 'abs', 'rand': '_c_rand', 'srand': '_c_srand',
+    'write': '_sys.stdout.write', 'chr': 'chr',
+}
+
+LIBRARY_POW = """\
+def _c_pow(x, y):
+    try:
+        return _math.pow(x, y)
+    except OverflowError:
+        return -_math.inf if x < 0.0 and y % 2.0 == 1.0 else _math.inf
+    except ValueError:
+        if x == 0.0:
+            return _math.copysign(_math.inf, x) if y % 2.0 == 1.0 else _math.inf
+        return _math.nan
+"""
+
+LIBRARY_RAND = """\
+_c_rand_estado = [0] * 33
+def _c_srand(semente, _s=_c_rand_estado):
+    w = semente & 0xffffffff or 1
+    if w > 0x7fffffff:
+        w -= 0x100000000
+    _s[0] = w & 0xffffffff
+    for i in range(1, 31):
+        hi = w // 127773 if w >= 0 else -(-w // 127773)
+        w = 16807 * (w - hi * 127773) - 2836 * hi
+        if w < 0:
+            w += 2147483647
+        _s[i] = w
+    _s[31], _s[32] = 3, 0
+    for _ in range(310):
+        _c_rand()
+def _c_rand(_s=_c_rand_estado):
+    f = _s[31]
+    r = _s[32]
+    v = _s[f] = (_s[f] + _s[r]) & 0xffffffff
+    _s[31] = f + 1 if f < 30 else 0
+    _s[32] = r + 1 if r < 30 else 0
+    return v >> 1
+_c_srand(1)
+"""
+
+_ROUND = "(@copysign(@{0}($0), $0) if -4503599627370496.0 < $0 < 4503599627370496.0 else $0)"
+
+LIBRARY = {
+    'sqrt': (1, "(@sqrt($0) if $0 >= 0.0 else @nan)", None),
+    'pow': (2, "@pow($0, $1)", LIBRARY_POW),
+    'exp': (1, "(@inf if $0 > 709.782712893384 else @exp($0))", None),
+    'log': (1, "(@log($0) if $0 > 0.0 else -@inf if $0 == 0.0 else @nan)", None),
+    'log10': (1, "(@log10($0) if $0 > 0.0 else -@inf if $0 == 0.0 else @nan)", None),
+    'sin': (1, "(@sin($0) if -@inf < $0 < @inf else @nan)", None),
+    'cos': (1, "(@cos($0) if -@inf < $0 < @inf else @nan)", None),
+    'atan2': (2, "@atan2($0, $1)", None),
+    'fmod': (2, "(@fmod($0, $1) if $1 != 0.0 and -@inf < $0 < @inf else @nan)", None),
+    'fabs': (1, "@fabs($0)", None),
+    'floor': (1, _ROUND.format('floor'), None),
+    'ceil': (1, _ROUND.format('ceil'), None),
+    'trunc': (1, _ROUND.format('trunc'), None),
+    'abs': (1, "@abs($0)", None),
+    'labs': (1, "@abs($0)", None),
+    'llabs': (1, "@abs($0)", None),
+    'rand': (0, "@rand()", LIBRARY_RAND),
+    'srand': (1, "@srand($0)", LIBRARY_RAND),
+    'puts': (1, "(print($0) or len($0) + 1)", None),
+    'putchar': (1, "(@write(@chr($0 & 255)) and $0 & 255)", None),
+}
+
+
+def library_function(func_name, num_params):
+    entry = LIBRARY.get(func_name)
+    return entry if entry and entry[0] == num_params else None
+
+
+def library_bindings(template):
+    """ Ligações usadas por um modelo, na ordem de LIBRARY_BINDINGS """
+    used = set(re.findall(r"@(\w+)", template))
+    return [name for name in LIBRARY_BINDINGS if name in used]
+
+
+def library_expression(template, call_args, bind):
+    text = re.sub(r"\$(\d)", lambda m: call_args[int(m.group(1))], template)
+    return re.sub(r"@(\w+)", lambda m: "_" + m.group(1) if bind else LIBRARY_BINDINGS[m.group(1)], text)
+
+
+def library_prelude(used):
+    """ Imports e auxiliares (cada um uma vez) das funções usadas """
+    lines = ["_math = __import__('math')", "_sys = __import__('sys')"]
+    helpers = []
+    for name in LIBRARY:
+        helper = LIBRARY[name][2]
+        if name in used and helper and helper not in helpers:
+            helpers.append(helper)
+            lines.extend(helper.splitlines())
+    return lines
+
+
+def split_type(args):
+    """ "(unsigned int) a" já dividido -> ("unsigned int", ["a"]) """
+    text = " ".join(args)
+    match = re.match(r"^\(([a-z ]+)\)\s*(.*)$", text)
+    if not match:
+        return None, args
+    return match.group(1), match.group(2).split()
+
+
+def translate_hlir_to_python(instructions, origins=None, profile=False, bind=True):
     """
     Traduz uma lista de instruções HLIR (já analisadas) para código Python.
+
+    Se `origins` for uma lista, recebe para cada linha Python gerada a posição
+    C (linha, coluna) que a originou. Com `profile`, cada comando C passa a
+    chamar `_prof(linha)` antes de executar (veja PROFILE_PRELUDE). Com
+    `bind`, as ligações da biblioteca padrão viram variáveis locais de cada
+    função (como --ligar=1 no compilador).
     """
     python_code = []
     indent_level = 0
     param_stack = []
+    if origins is None:
+        origins = []
+    last_marked = [0]    # Última linha C instrumentada
+    new_block = [True]   # Início de bloco sempre recebe um marcador
+    block_empty = []     # Para cada bloco aberto: ainda não recebeu comandos?
+    has_main = False     # Alguma função se chama main? (chamada no fim)
+    uses_f32 = False     # Algum F32? (define _f32p e _f32u no fim)
+    used_library = set() # Funções da biblioteca chamadas (preâmbulo no fim)
+
+    def emit(text, instr, marker=True):
+        line = instr.get("line", 0)
+        if profile and marker and line and (line != last_marked[0] or new_block[0]):
+            indent = text[:len(text) - len(text.lstrip())]
+            python_code.append(f"{indent}_prof({line})")
+            origins.append((line, instr.get("col", 0)))
+            last_marked[0] = line
+            new_block[0] = False
+        python_code.append(text)
+        origins.append((line, instr.get("col", 0)))
+        if block_empty:
+            block_empty[-1] = False
+
+    def close_block(instr):
+        # Um bloco C vazio precisa de `pass` para ser Python válido
+        if block_empty and block_empty[-1]:
+            emit("    " * indent_level + "pass", instr, marker=False)
 
     # Mapeia opcodes do HLIR para operadores Python
     op_map = {
-        'ADD': '+', 'SUB': '-', 'MUL': '*', 'DIV': '/', 'MOD': '%',
-        'LT': '<', 'GT': '>', 'LTE': '<=', 'GTE': '>=', 'EQ': '==', 'NEQ': '!='
+        'ADD': '+', 'SUB': '-', 'MUL': '*', 'DIV': '/',
+        'LT': '<', 'GT': '>', 'LTE': '<=', 'GTE': '>=', 'EQ': '==', 'NEQ': '!=',
+        'BAND': '&', 'BOR': '|', 'BXOR': '^', 'SHL': '<<', 'SHR': '>>'
     }
 
-    for instr in instructions:
+    for position, instr in enumerate(instructions):
         opcode = instr["opcode"]
         args = instr.get("args", [])
         result = instr.get("result")
@@ -81,19 +265,65 @@ def translate_hlir_to_python(instructions):
 
         # --- Expressões e Atribuições ---
         if opcode == 'ASSIGN':
-            python_code.append(f"{indent_str}{result} = {args[0]}")
+            emit(f"{indent_str}{result} = {args[0]}", instr)
         
         elif opcode in op_map:
             # Formato: resultado = arg1 op arg2
             arg1 = args[0]
             op_symbol = op_map[opcode]
             arg2 = args[2] # Pula o próprio operador que está em args[1]
-            python_code.append(f"{indent_str}{result} = {arg1} {op_symbol} {arg2}")
-
-        elif opcode == 'UMINUS':
-            # Formato: resultado = -arg1
-            arg1 = args[1] # Pula o "-" que está em args[0]
-            python_code.append(f"{indent_str}{result} = -{arg1}")
+            emit(f"{indent_str}{result} = {arg1} {op_symbol} {arg2}", instr)
+
+        # Divisão e resto inteiros do C truncam em direção a zero; os
+        # operadores // e % do Python arredondam para baixo
+        # (só int(a / b) é exato até 32 bits; sem sinal, // e % já truncam)
+        elif opcode in ('IDIV', 'MOD'):
+            arg1, arg2 = args[0], args[2]
+            c_type = " ".join(args[3:]).strip("()") or 'int'
+            bits, unsigned = INT_TYPES.get(c_type, (32, False))
+            if unsigned:
+                quotient = None
+                emit(f"{indent_str}{result} = {arg1} {'//' if opcode == 'IDIV' else '%'} {arg2}", instr)
+            elif bits > 32:
+                quotient = f"({arg1} // {arg2} if ({arg1} ^ {arg2}) >= 0 else -(-{arg1} // {arg2}))"
+            else:
+                quotient = f"int({arg1} / {arg2})"
+            if quotient and opcode == 'IDIV':
+                emit(f"{indent_str}{result} = {quotient}", instr)
+            elif quotient:
+                emit(f"{indent_str}{result} = {arg1} - {arg2} * {quotient}", instr)
+
+        # Conversão para a largura do tipo: os ints do Python não têm limite
+        elif opcode == 'CONV':
+            c_type, operand = split_type(args)
+            arg1 = operand[0]
+            if c_type in INT_TYPES:
+                bits, unsigned = INT_TYPES[c_type]
+                mask, half = (1 << bits) - 1, 1 << (bits - 1)
+                if unsigned:
+                    emit(f"{indent_str}{result} = {arg1} & {mask}", instr)
+                else:
+                    emit(f"{indent_str}{result} = ({arg1} + {half} & {mask}) - {half}", instr)
+            else:
+                emit(f"{indent_str}{result} = float({arg1})", instr)
+
+        elif opcode == 'F32':
+            uses_f32 = True
+            emit(f"{indent_str}{result} = _f32u(_f32p({args[0]}))[0]", instr)
+
+        # Lógicos do C resultam em 0 ou 1
+        elif opcode in ('AND', 'OR'):
+            py_op = opcode.lower()
+            emit(f"{indent_str}{result} = int({args[0]} != 0 {py_op} {args[2]} != 0)", instr)
+
+        elif opcode in ('UMINUS', 'BNOT', 'NOT'):
+            # Formato: resultado = -arg1 (ou ~arg1, !arg1); o operador vem
+            # colado ao operando
+            arg1 = args[0][1:]
+            if opcode == 'NOT':
+                emit(f"{indent_str}{result} = int(not {arg1})", instr)
+            else:
+                emit(f"{indent_str}{result} = {args[0][0]}{arg1}", instr)
 
         # --- Chamada de Função ---
         elif opcode == 'PARAM':
@@ -106,6 +336,9 @@ def translate_hlir_to_python(instructions):
             # Parâmetros foram empilhados na ordem inversa, então pop() os recupera na ordem correta
             call_args = [param_stack.pop() for _ in range(num_params)]
 
+            library = library_function(func_name, num_params)
+            assign = f"{result} = " if result and result != '_' else ""
+
             # Tratamento especial para printf, que não existe em Python
             if func_name == 'printf':
                 format_str = call_args[0]
@@ -115,61 +348,79 @@ def translate_hlir_to_python(instructions):
                 if vars_to_format:
                     # Se for mais de uma variável, o operador % espera uma tupla
                     vars_str = f"({', '.join(vars_to_format)})" if len(vars_to_format) > 1 else vars_to_format[0]
-                    python_code.append(f'{indent_str}print({format_str} % {vars_str})')
+                    emit(f'{indent_str}print({format_str} % {vars_str})', instr)
                 else:
                     # Se não houver, apenas imprime a string
-                    python_code.append(f'{indent_str}print({format_str})')
+                    emit(f'{indent_str}print({format_str})', instr)
+            elif library:
+                used_library.add(func_name)
+                emit(f"{indent_str}{assign}{library_expression(library[1], call_args, bind)}", instr)
             else:
                 # Para outras funções, gera uma chamada de função normal
                 args_str = ", ".join(call_args)
-                python_code.append(f"{indent_str}{func_name}({args_str})")
+                emit(f"{indent_str}{assign}{func_name}({args_str})", instr)
 
         # --- Controle de Fluxo Estruturado ---
         elif opcode == 'IF_START':
             condition = args[0]
-            python_code.append(f"{indent_str}if {condition}:")
+            emit(f"{indent_str}if {condition}:", instr)
         
         elif opcode == 'WHILE_START' or opcode == 'DO_WHILE_START':
-            python_code.append(f"{indent_str}while True:")
+            # A condição (avaliada no corpo) é que recebe o marcador de perfil
+            emit(f"{indent_str}while True:", instr, marker=False)
 
         elif opcode == 'THEN_START' or opcode == 'BODY_START':
             indent_level += 1
+            new_block[0] = True
+            block_empty.append(True)
             
         elif opcode == 'BREAK_IF_FALSE':
             condition = args[0]
-            python_code.append(f"{indent_str}if not {condition}:")
-            python_code.append(f"{indent_str}    break")
-
-        elif opcode == 'ELSE_START':
-            else_indent_str = "    " * (indent_level - 1)
-            python_code.append(f"{else_indent_str}else:")
+            emit(f"{indent_str}if not {condition}:", instr)
+            emit(f"{indent_str}    break", instr)
 
-        elif opcode == 'IF_END' or opcode == 'WHILE_END' or opcode == 'DO_WHILE_END':
-            indent_level -= 1
+        elif opcode == 'BREAK':
+            emit(f"{indent_str}break", instr)
 
-        elif opcode == 'THEN_START' or opcode == 'BODY_START':
-            indent_level += 1
+        elif opcode == 'CONTINUE':
+            emit(f"{indent_str}continue", instr)
 
         elif opcode == 'ELSE_START':
-            # O 'else' pertence ao nível de indentação anterior
+            close_block(instr)
             else_indent_str = "    " * (indent_level - 1)
-            python_code.append(f"{else_indent_str}else:")
-
-        elif opcode == 'IF_END' or opcode == 'WHILE_END':
-            indent_level -= 1
-
-        elif opcode == 'WHILE_START':
-            python_code.append(f"{indent_str}while True:")
-        
-        elif opcode == 'THEN_START' or opcode == 'BODY_START':
+            emit(f"{else_indent_str}else:", instr, marker=False)
+            new_block[0] = True
+            if block_empty:
+                block_empty[-1] = True
+
+        elif opcode == 'RETURN':
+            value = f" {args[0]}" if args and args[0] != '_' else ""
+            emit(f"{indent_str}return{value}", instr)
+
+        # --- Funções: cada uma vira um def ---
+        elif opcode == 'FUNC_START':
+            emit(f"{indent_str}def {args[0]}():", instr, marker=False)
+            has_main = has_main or args[0] == 'main'
             indent_level += 1
-            
-        elif opcode == 'BREAK_IF_FALSE':
-            condition = args[0]
-            python_code.append(f"{indent_str}if not {condition}:")
-            python_code.append(f"{indent_str}    break")
-
-        elif opcode == 'IF_END' or opcode == 'WHILE_END':
+            new_block[0] = True
+            block_empty.append(True)
+            if bind:
+                # Ligações das funções da biblioteca chamadas até FUNC_END
+                bindings = []
+                for later in instructions[position + 1:]:
+                    if later["opcode"] == 'FUNC_END':
+                        break
+                    library = later["opcode"] == 'CALL' and library_function(
+                        later["args"][0].strip('"'), int(later["args"][1]))
+                    if library:
+                        bindings.extend(b for b in library_bindings(library[1]) if b not in bindings)
+                for name in sorted(bindings, key=list(LIBRARY_BINDINGS).index):
+                    emit(f"{indent_str}    _{name} = {LIBRARY_BINDINGS[name]}", instr, marker=False)
+
+        elif opcode in ('IF_END', 'WHILE_END', 'DO_WHILE_END', 'FUNC_END'):
+            close_block(instr)
+            if block_empty:
+                block_empty.pop()
             indent_level -= 1
 
         # Opcodes que são apenas marcadores para o gerador de código
@@ -177,17 +428,94 @@ def translate_hlir_to_python(instructions):
         elif opcode in ['WHILE_START']:
             pass
 
+    if uses_f32:
+        python_code.extend(F32_HELPER)
+        origins.extend([(0, 0)] * len(F32_HELPER))
+    if used_library:
+        prelude = library_prelude(used_library)
+        python_code.extend(prelude)
+        origins.extend([(0, 0)] * len(prelude))
+    if has_main:
+        python_code.append("main()")
+        origins.append((0, 0))
+
     return python_code
 
 
+# --- Instrumentação de Perfil ---
+# Inserida no topo do programa gerado com --profile. Cada comando C chama
+# _prof(linha), que conta execuções (em laços, o marcador da condição conta
+# as iterações) e registra a linha corrente; um temporizador SIGPROF amostra
+# essa linha para estimar o tempo gasto em cada uma. Ao final, o relatório
+# com as linhas C mais quentes é escrito em stderr.
+PROFILE_PRELUDE = """\
+import atexit as _prof_atexit
+import sys as _prof_sys
+from collections import defaultdict as _prof_defaultdict
+_prof_contagem = _prof_defaultdict(int)
+_prof_amostras = _prof_defaultdict(int)
+_prof_atual = [0]
+_PROF_INTERVALO = 0.001  # segundos de CPU entre amostras
+_PROF_TOP = 10
+def _prof(linha):
+    _prof_atual[0] = linha
+    _prof_contagem[linha] += 1
+def _prof_amostrar(signum, frame):
+    _prof_amostras[_prof_atual[0]] += 1
+try:
+    import signal as _prof_signal
+    _prof_signal.signal(_prof_signal.SIGPROF, _prof_amostrar)
+    _prof_signal.setitimer(_prof_signal.ITIMER_PROF, _PROF_INTERVALO, _PROF_INTERVALO)
+except (ImportError, AttributeError, ValueError):
+    _prof_signal = None  # Sem SIGPROF (ex: Windows): apenas contagens
+def _prof_relatorio():
+    if _prof_signal is not None:
+        _prof_signal.setitimer(_prof_signal.ITIMER_PROF, 0, 0)
+    total = sum(_prof_amostras.values()) or 1
+    linhas = sorted(set(_prof_contagem) | set(_prof_amostras),
+                    key=lambda l: (_prof_amostras[l], _prof_contagem[l]), reverse=True)
+    err = _prof_sys.stderr
+    print("==== Perfil por linha C (mais quentes primeiro) ====", file=err)
+    print(f"{'linha':>6} {'execuções':>12} {'amostras':>9} {'tempo(ms)':>10} {'%':>6}  código", file=err)
+    for linha in linhas[:_PROF_TOP]:
+        amostras = _prof_amostras[linha]
+        print(f"{linha:>6} {_prof_contagem[linha]:>12} {amostras:>9} "
+              f"{amostras * _PROF_INTERVALO * 1000:>10.1f} {100.0 * amostras / total:>5.1f}%  "
+              f"{_PROF_FONTE.get(linha, '')}", file=err)
+_prof_atexit.register(_prof_relatorio)
+"""
+
+
+def build_source_map(origins, first_line, py_file=None, c_file=None):
+    """
+    Monta o mapa de fontes: para cada linha Python gerada (numeradas a partir
+    de `first_line`) que veio de um comando C, o par (linha, coluna) de origem.
+    """
+    mappings = [[first_line + i, line, col]
+                for i, (line, col) in enumerate(origins) if line]
+    return {"version": 1, "file": py_file, "source": c_file, "mappings": mappings}
+
+
 # --- Bloco de Execução Principal ---
 def main():
     """
     Ponto de entrada do script. Lê um arquivo de entrada (ou stdin)
     e imprime o código Python traduzido.
     """
-    if len(sys.argv) > 1:
-        input_file = sys.argv[1]
+    parser = argparse.ArgumentParser(description="Traduz o HLIR do compilador para Python.")
+    parser.add_argument("input", nargs="?", help="arquivo HLIR (padrão: stdin)")
+    parser.add_argument("-o", "--output", help="arquivo Python de saída (padrão: stdout)")
+    parser.add_argument("--map", help="arquivo do mapa de fontes C->Python "
+                        "(padrão: <saída>.map quando -o é usado)")
+    parser.add_argument("--profile", action="store_true",
+                        help="instrumenta o programa para medir as linhas C mais quentes")
+    parser.add_argument("--source", help="fonte C original (incluído no mapa e no relatório de perfil)")
+    parser.add_argument("--ligar", type=int, choices=(0, 1), default=1,
+                        help="ligações da biblioteca padrão em variáveis locais (padrão: 1)")
+    options = parser.parse_args()
+
+    if options.input:
+        input_file = options.input
         try:
             with open(input_file, 'r', encoding='utf-8') as f:
                 hlir_lines = f.readlines()
@@ -203,25 +531,48 @@ def main():
     instructions = [instr for instr in instructions if instr] # Remove linhas nulas/vazias
 
     # Realiza a tradução
-    python_output_lines = translate_hlir_to_python(instructions)
-
-    # Imprime o resultado formatado
-    print("#" + "="*38)
-    print("# Código Python Gerado Automaticamente #")
-    print("#" + "="*38)
-    print()
-    
+    origins = []
+    python_output_lines = translate_hlir_to_python(instructions, origins, options.profile, options.ligar == 1)
+
+    # Monta o resultado formatado
+    output = []
+    output.append("#" + "="*38)
+    output.append("# Código Python Gerado Automaticamente #")
+    output.append("#" + "="*38)
+    output.append("")
+
+    if options.profile:
+        source_lines = {}
+        if options.source:
+            with open(options.source, 'r', encoding='utf-8') as f:
+                source_lines = {i + 1: text.strip() for i, text in enumerate(f)}
+        output.extend(PROFILE_PRELUDE.splitlines())
+        output.append(f"_PROF_FONTE = {source_lines!r}")
+        output.append("")
+
+    first_line = len(output) + 1
     if not python_output_lines:
-        print("# (Nenhum código foi gerado)")
+        output.append("# (Nenhum código foi gerado)")
     else:
-        for py_line in python_output_lines:
-            print(py_line)
-    
-    print()
-    print("#" + "="*40)
-    print("#       Fim do Código Gerado         #")
-    print("#" + "="*40)
+        output.extend(python_output_lines)
+
+    output.append("")
+    output.append("#" + "="*40)
+    output.append("#       Fim do Código Gerado         #")
+    output.append("#" + "="*40)
+
+    if options.output:
+        with open(options.output, 'w', encoding='utf-8') as f:
+            f.write("\n".join(output) + "\n")
+    else:
+        print("\n".join(output))
+
+    map_file = options.map or (options.output + ".map" if options.output else None)
+    if map_file:
+        source_map = build_source_map(origins, first_line, options.output, options.source)
+        with open(map_file, 'w', encoding='utf-8') as f:
+            json.dump(source_map, f)
 
 
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main()
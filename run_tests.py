@@ -1,11 +1,15 @@
+import json
 import subprocess
 import os
 import sys
 import platform
+import time
 from typing import List
 
 # --- Configuração de Cores e Comandos ---
 COMPILER_EXECUTABLE = "compiler.exe" if platform.system() == "Windows" else "./compiler"
+# Lexer usado na compilação: SCANNER=flex (padrão, lexer.l) ou SCANNER=simd (scanner.c)
+SCANNER = os.environ.get("SCANNER", "flex")
 
 class Colors:
     GREEN = '\033[92m'
@@ -22,17 +26,19 @@ def print_red(text):
 
 def build(verbose=False):
     """Compila o projeto usando flex, bison e um compilador C."""
-    print("Compilando o projeto...")
+    print(f"Compilando o projeto (lexer: {SCANNER})...")
     try:
-        compile_commands = [
-            "flex lexer.l",
-            "bison -d parser.y"
-        ]
+        if SCANNER == "simd":
+            compile_commands = ["bison -d parser.y"]
+            lexer_c, lfl = "scanner.c", ""
+        else:
+            compile_commands = ["flex lexer.l", "bison -d parser.y"]
+            lexer_c, lfl = "lex.yy.c", " -lfl"
         
         if platform.system() == "Darwin":  # macOS
-            c_compiler_cmd = f"clang parser.tab.c lex.yy.c ast.c tabela.c codegen.c -o {COMPILER_EXECUTABLE.replace('./', '')}"
+            c_compiler_cmd = f"clang parser.tab.c {lexer_c} ast.c tabela.c codegen.c preproc.c servidor.c incremental.c saida.c pygen.c hlirbin.c desenrolar.c simplificar.c eliminar.c pycgen.c biblioteca.c -o {COMPILER_EXECUTABLE.replace('./', '')}"
         else:  # Linux e Windows
-            c_compiler_cmd = f"gcc parser.tab.c lex.yy.c ast.c tabela.c codegen.c -o {COMPILER_EXECUTABLE.replace('./', '')} -lfl"
+            c_compiler_cmd = f"gcc parser.tab.c {lexer_c} ast.c tabela.c codegen.c preproc.c servidor.c incremental.c saida.c pygen.c hlirbin.c desenrolar.c simplificar.c eliminar.c pycgen.c biblioteca.c -o {COMPILER_EXECUTABLE.replace('./', '')}{lfl}"
         
         compile_commands.append(c_compiler_cmd)
 
@@ -52,15 +58,19 @@ def run_c_tests():
     print("-" * 40)
     print("Executando testes em C...")
 
-    # Testes que devem compilar sem a palavra "Erro" no stderr
+    # Testes que devem compilar sem a palavra "Erro" no stderr (e com status 0)
     success_tests = [
         "teste/teste.c", "teste/teste2.c", "teste/testeAst.c",
-        "teste/teste_semantica_ok.c"
+        "teste/teste_semantica_ok.c", "teste/teste_multiplas_funcoes.c",
+        "teste/teste_desenrolar.c", "teste/teste_bits.c", "teste/teste_mortos.c",
+        "teste/teste_tipos.c", "teste/teste_biblioteca.c", "teste/teste_desvios.c",
+        "teste/teste_curto_circuito.c"
     ]
-    # Testes que DEVEM produzir um "Erro" no stderr para passar
+    # Testes que DEVEM produzir um "Erro" no stderr (e status diferente de 0) para passar
     failure_tests = [
         "teste/testeTabela.c", "teste/teste_semantica_erro.c",
         "teste/erro_tipos_incompativeis.c", "teste/erro_variavel_nao_declarada.c",
+        "teste/erro_break_fora_laco.c",
         "teste/teste_estruturado_ok.c" # Este arquivo falha a sintaxe 'main()', então é um teste de falha esperado.
     ]
 
@@ -72,7 +82,7 @@ def run_c_tests():
         with open(test_path, 'r') as f:
             result = subprocess.run([COMPILER_EXECUTABLE], stdin=f, capture_output=True, text=True)
         
-        test_ok = "Erro" not in result.stderr
+        test_ok = "Erro" not in result.stderr and result.returncode == 0
         status = f"[{'PASS' if test_ok else 'FAIL'}]"
         print(f"Testando: {test_path:<35} {Colors.GREEN if test_ok else Colors.RED}{status}{Colors.ENDC}")
         if test_ok: passed_tests += 1
@@ -82,7 +92,7 @@ def run_c_tests():
         with open(test_path, 'r') as f:
             result = subprocess.run([COMPILER_EXECUTABLE], stdin=f, capture_output=True, text=True)
 
-        test_ok = "Erro" in result.stderr
+        test_ok = "Erro" in result.stderr and result.returncode != 0
         status_msg = "Erro detectado" if test_ok else "Erro não detectado"
         status = f"[{'PASS' if test_ok else 'FAIL'}] ({status_msg})"
         print(f"Testando: {test_path:<35} {Colors.GREEN if test_ok else Colors.RED}{status}{Colors.ENDC}")
@@ -106,7 +116,7 @@ def run_py_test():
 
     try:
         # 1. Gera quádruplas do compilador
-        with open("teste/teste_semantica_ok.c", 'r') as f_in, open(quads_filename, 'w') as f_out:
+        with open("teste/teste.c", 'r') as f_in, open(quads_filename, 'w') as f_out:
             subprocess.run([COMPILER_EXECUTABLE], stdin=f_in, stdout=f_out, check=True)
 
         # 2. Converte para Python passando o NOME DO ARQUIVO como argumento
@@ -122,12 +132,190 @@ def run_py_test():
         # print(f"  (Comando que falhou: {e})") # Uncomment for debugging
         return False
 
+def run_pyc_test():
+    """Confere que o .pyc gerado direto (--emit=pyc) se comporta como o .py."""
+    print("-" * 40)
+    print("Executando teste de geração de .pyc...")
+
+    # O .pyc é do CPython 3.11; outras versões o recusam pelo número mágico
+    if sys.version_info[:2] != (3, 11):
+        print("Testando .pyc contra .py... [ SKIP ] (requer Python 3.11)")
+        return True
+
+    programas = [
+        "teste/teste.c", "teste/teste_multiplas_funcoes.c", "teste/teste_desenrolar.c",
+        "teste/teste_bits.c", "teste/teste_mortos.c", "teste/teste_tipos.c",
+        "teste/teste_biblioteca.c", "teste/teste_desvios.c", "teste/teste_curto_circuito.c",
+        "teste/teste_preproc.c"
+    ]
+    ok = True
+    for programa in programas:
+        saidas = []
+        for formato, destino in (("py", "teste/output_program.py"), ("pyc", "teste/output_program.pyc")):
+            subprocess.run([COMPILER_EXECUTABLE, f"--emit={formato}", programa, "-o", destino], check=False)
+            r = subprocess.run([sys.executable, destino], capture_output=True, text=True)
+            saidas.append((r.returncode, r.stdout))
+        # Os programas que conferem o próprio resultado imprimem "ERRO" quando falham
+        mesmo = saidas[0] == saidas[1] and saidas[0][0] == 0 and "ERRO" not in saidas[0][1]
+        ok = ok and mesmo
+        status = f"{Colors.GREEN}[ PASS ]{Colors.ENDC}" if mesmo else f"{Colors.RED}[ FAIL ]{Colors.ENDC}"
+        print(f"Testando .pyc contra .py: {programa:<30} {status}")
+    return ok
+
+def iniciar_servidor():
+    """Inicia ./compiler --servir com um único worker (o cache de headers é o mesmo entre pedidos)."""
+    socket = f"/tmp/compilador_teste_{os.getpid()}.sock"
+    servidor = subprocess.Popen([COMPILER_EXECUTABLE, "--servir", socket, "--workers", "1"],
+                                stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    for _ in range(100):
+        if os.path.exists(socket): break
+        time.sleep(0.05)
+    return socket, servidor
+
+def run_servidor_test():
+    """Compila pelo servidor (--servir) com o cliente e confere saída e status com o compilador direto."""
+    print("-" * 40)
+    print("Executando teste do servidor de compilação...")
+
+    if subprocess.run("gcc cliente.c servidor.c -o cliente", shell=True,
+                      stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL).returncode != 0:
+        print(f"Testando servidor... {Colors.RED}[ FAIL ]{Colors.ENDC} (falha ao compilar o cliente)")
+        return False
+    socket, servidor = iniciar_servidor()
+    ok = True
+    try:
+        # Um programa válido e um com erro: o status do cliente é o do compilador
+        for programa in ("teste/teste.c", "teste/erro_variavel_nao_declarada.c"):
+            with open(programa, "rb") as f:
+                direto = subprocess.run([COMPILER_EXECUTABLE], stdin=f, capture_output=True)
+            with open(programa, "rb") as f:
+                remoto = subprocess.run(["./cliente"], stdin=f, capture_output=True,
+                                        env={**os.environ, "COMPILADOR_SOCKET": socket})
+            esperado = 0 if programa == "teste/teste.c" else 1
+            mesmo = (direto.returncode == remoto.returncode == esperado and direto.stdout == remoto.stdout
+                     and direto.stderr == remoto.stderr)
+            ok = ok and mesmo
+            status = f"{Colors.GREEN}[ PASS ]{Colors.ENDC}" if mesmo else f"{Colors.RED}[ FAIL ]{Colors.ENDC}"
+            print(f"Testando servidor: {programa:<35} {status}")
+    finally:
+        servidor.terminate()
+        servidor.wait()
+    return ok
+
+def run_preproc_test():
+    """Posições depois de #include, header protegido incluído duas vezes e invalidação do cache de headers."""
+    print("-" * 40)
+    print("Executando testes do pré-processador...")
+
+    def resultado(nome, passou):
+        status = f"{Colors.GREEN}[ PASS ]{Colors.ENDC}" if passou else f"{Colors.RED}[ FAIL ]{Colors.ENDC}"
+        print(f"Testando pré-processador: {nome:<32} {status}")
+        return passou
+
+    def linha_de(arquivo, trecho):
+        with open(arquivo) as f:
+            return next(i for i, linha in enumerate(f, 1) if trecho in linha)
+
+    ok = True
+    r = subprocess.run([COMPILER_EXECUTABLE, "teste/teste_preproc.c"], capture_output=True, text=True)
+    hlir = r.stdout.splitlines()
+    # Cada instrução leva a linha do arquivo de onde veio: o header e o .c depois de cada #include
+    posicoes = [("FUNC_START limite_ao_quadrado", "teste/teste_preproc.h", "int limite_ao_quadrado"),
+                ("ASSIGN  depois_include", "teste/teste_preproc.c", "depois_include = PASSO"),
+                ("ASSIGN  depois_cache", "teste/teste_preproc.c", "depois_cache = PASSO")]
+    certas = r.returncode == 0 and all(
+        any(instr in l and f"@{linha_de(arquivo, trecho)}:" in l for l in hlir)
+        for instr, arquivo, trecho in posicoes)
+    ok &= resultado("linhas depois de #include", certas)
+    # O include guard impede que a segunda inclusão repita a função do header
+    ok &= resultado("header protegido incluído 2x",
+                    r.returncode == 0 and sum("FUNC_START limite_ao_quadrado" in l for l in hlir) == 1)
+
+    if subprocess.run("gcc cliente.c servidor.c -o cliente", shell=True,
+                      stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL).returncode != 0:
+        return resultado("cache (falha ao compilar o cliente)", False)
+    socket, servidor = iniciar_servidor()
+    env = {**os.environ, "COMPILADOR_SOCKET": socket}
+    diretorio = f"/tmp/compilador_preproc_{os.getpid()}"
+    os.makedirs(diretorio, exist_ok=True)
+    cabecalho = os.path.join(diretorio, "cabecalho.h")
+    principal = os.path.join(diretorio, "principal.c")
+    def compilar(arquivo):
+        return subprocess.run(["./cliente", arquivo], capture_output=True, text=True, env=env).stdout
+    def escrever(texto, mtime):
+        with open(cabecalho, "w") as f:
+            f.write(texto)
+        os.utime(cabecalho, (mtime, mtime))
+    try:
+        # Pelo servidor, a segunda compilação reproduz os headers do cache
+        ok &= resultado("cache com header protegido",
+                        compilar("teste/teste_preproc.c") == compilar("teste/teste_preproc.c") == r.stdout)
+
+        with open(principal, "w") as f:
+            f.write('#include "cabecalho.h"\nint main() {\n    printf("%d\\n", VALOR);\n    return 0;\n}\n')
+        mtime = int(time.time()) - 100
+        escrever("#define VALOR 111\n", mtime)
+        certo = "PARAM   111" in compilar(principal) and "PARAM   111" in compilar(principal)
+        # Mesmo tamanho, outra data de modificação
+        escrever("#define VALOR 222\n", mtime + 10)
+        certo = certo and "PARAM   222" in compilar(principal)
+        # Mesma data de modificação, outro tamanho
+        escrever("#define VALOR 3333\n", mtime + 10)
+        certo = certo and "PARAM   3333" in compilar(principal)
+        ok &= resultado("cache após editar o header", certo)
+    finally:
+        servidor.terminate()
+        servidor.wait()
+        for arquivo in (cabecalho, principal):
+            if os.path.exists(arquivo): os.remove(arquivo)
+        os.rmdir(diretorio)
+    return ok
+
+def run_incremental_test():
+    """Edita um documento no modo incremental e confere cada resposta com a tradução completa."""
+    print("-" * 40)
+    print("Executando teste do modo incremental...")
+
+    with open("teste/teste_multiplas_funcoes.c", "rb") as f:
+        texto = f.read()
+    digito = texto.index(b"x = 7;") + 4
+    # (início, fim, texto novo): muda uma função, insere uma linha no topo, quebra e conserta
+    edicoes = [(digito, digito + 1, b"9"), (0, 0, b"\n"), (digito + 1, digito + 2, b"y"), (digito + 1, digito + 2, b"9")]
+
+    processo = subprocess.Popen([COMPILER_EXECUTABLE, "--incremental"], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+    def pedir(**campos):
+        processo.stdin.write((json.dumps(campos) + "\n").encode())
+        processo.stdin.flush()
+        return json.loads(processo.stdout.readline())
+
+    ok = True
+    try:
+        resposta = pedir(id=0, metodo="abrir", nome="<stdin>", texto=texto.decode())
+        for i, (inicio, fim, novo) in enumerate([(0, 0, b"")] + edicoes):
+            if i > 0:
+                texto = texto[:inicio] + novo + texto[fim:]
+                resposta = pedir(id=i, metodo="editar", inicio=inicio, fim=fim, texto=novo.decode())
+            completa = subprocess.run([COMPILER_EXECUTABLE], input=texto, capture_output=True)
+            esperado_ok = b"Falha" not in completa.stderr
+            mesmo = resposta["ok"] == esperado_ok and (not esperado_ok or resposta["saida"].encode() == completa.stdout)
+            # Só a função editada é reanalisada
+            if i > 0 and resposta["reaproveitados"] == 0:
+                mesmo = False
+            ok = ok and mesmo
+            status = f"{Colors.GREEN}[ PASS ]{Colors.ENDC}" if mesmo else f"{Colors.RED}[ FAIL ]{Colors.ENDC}"
+            print(f"Testando edição incremental {i}... {status}")
+    finally:
+        processo.stdin.close()
+        processo.wait()
+    return ok
+
 def clean():
     """Remove os arquivos gerados."""
     print("Limpando arquivos gerados...")
     files_to_remove = [
         "compiler", "compiler.exe", "lex.yy.c", "parser.tab.c", 
-        "parser.tab.h", "quads_output.txt", "teste/output_program.py"
+        "parser.tab.h", "quads_output.txt", "teste/output_program.py",
+        "teste/output_program.pyc", "cliente"
     ]
     for f in files_to_remove:
         if os.path.exists(f):
@@ -147,12 +335,20 @@ def main():
             if not build(verbose): return
         run_c_tests()
         run_py_test()
+        run_pyc_test()
+        run_incremental_test()
+        run_servidor_test()
+        run_preproc_test()
     elif command == "clean":
         clean()
     elif command == "all":
         if build(verbose):
             run_c_tests()
             run_py_test()
+            run_pyc_test()
+            run_incremental_test()
+            run_servidor_test()
+            run_preproc_test()
     else:
         print("Uso: python3 run.py [comando]")
         print("Comandos: all, build, test, clean")
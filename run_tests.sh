@@ -11,18 +11,27 @@ if [[ "$1" == "--verbose" ]]; then
     VERBOSE=true
 fi
 
+# Lexer usado na compilação: SCANNER=flex (padrão, lexer.l) ou
+# SCANNER=simd (scanner.c, escrito à mão, dispensa o flex)
+SCANNER=${SCANNER:-flex}
+
 # Função para compilar o projeto
 build() {
-    echo "Compilando o projeto para macOS..."
+    echo "Compilando o projeto para macOS (lexer: $SCANNER)..."
+    if [ "$SCANNER" = "simd" ]; then
+        LEXER_C=scanner.c
+    else
+        LEXER_C=lex.yy.c
+    fi
     if [ "$VERBOSE" = true ]; then
-        flex lexer.l
+        [ "$SCANNER" = "simd" ] || flex lexer.l
         bison -d parser.y
-        clang parser.tab.c lex.yy.c ast.c tabela.c codegen.c -o compiler
+        clang parser.tab.c $LEXER_C ast.c tabela.c codegen.c preproc.c servidor.c incremental.c saida.c pygen.c hlirbin.c desenrolar.c simplificar.c eliminar.c pycgen.c biblioteca.c -o compiler
     else
         # Compilação silenciosa
-        flex lexer.l > /dev/null 2>&1
+        [ "$SCANNER" = "simd" ] || flex lexer.l > /dev/null 2>&1
         bison -d parser.y > /dev/null 2>&1
-        clang parser.tab.c lex.yy.c ast.c tabela.c codegen.c -o compiler > /dev/null 2>&1
+        clang parser.tab.c $LEXER_C ast.c tabela.c codegen.c preproc.c servidor.c incremental.c saida.c pygen.c hlirbin.c desenrolar.c simplificar.c eliminar.c pycgen.c biblioteca.c -o compiler > /dev/null 2>&1
     fi
 
     if [ $? -eq 0 ]; then
@@ -45,6 +54,14 @@ test_c() {
         "teste/testeAst.c"
         "teste/teste_semantica_ok.c"
         "teste/teste_estruturado_ok.c"
+        "teste/teste_multiplas_funcoes.c"
+        "teste/teste_desenrolar.c"
+        "teste/teste_bits.c"
+        "teste/teste_mortos.c"
+        "teste/teste_tipos.c"
+        "teste/teste_biblioteca.c"
+        "teste/teste_desvios.c"
+        "teste/teste_curto_circuito.c"
     )
 
     # Testes que devem falhar
@@ -53,6 +70,7 @@ test_c() {
         "teste/teste_semantica_erro.c"
         "teste/erro_tipos_incompativeis.c"
         "teste/erro_variavel_nao_declarada.c"
+        "teste/erro_break_fora_laco.c"
     )
 
     TOTAL_TESTS=0
@@ -63,8 +81,9 @@ test_c() {
         ((TOTAL_TESTS++))
         printf "Testando: %-35s" "$test_file"
         ERROR_OUTPUT=$(./compiler < "$test_file" 2>&1 >/dev/null)
-        # Sucesso significa que a palavra "Erro" NÃO está na saída de erro
-        if [[ "$ERROR_OUTPUT" != *"Erro"* ]]; then
+        STATUS=$?
+        # Sucesso significa status 0 e a palavra "Erro" NÃO está na saída de erro
+        if [ $STATUS -eq 0 ] && [[ "$ERROR_OUTPUT" != *"Erro"* ]]; then
             echo -e "${GREEN}[ PASS ]${NC}"
             ((PASSED_TESTS++))
         else
@@ -77,8 +96,9 @@ test_c() {
         ((TOTAL_TESTS++))
         printf "Testando: %-35s" "$test_file"
         ERROR_OUTPUT=$(./compiler < "$test_file" 2>&1 >/dev/null)
-        # Sucesso aqui significa que a palavra "Erro" ESTÁ na saída de erro
-        if [[ "$ERROR_OUTPUT" == *"Erro"* ]]; then
+        STATUS=$?
+        # Sucesso aqui significa status diferente de 0 e a palavra "Erro" na saída de erro
+        if [ $STATUS -ne 0 ] && [[ "$ERROR_OUTPUT" == *"Erro"* ]]; then
             echo -e "${GREEN}[ PASS ] (Erro detectado corretamente)${NC}"
             ((PASSED_TESTS++))
         else
@@ -101,7 +121,7 @@ test_py() {
     printf "Testando geração e execução de Python..."
 
     # Gera quádruplas e converte para Python, verificando cada passo
-    ./compiler < "teste/teste_semantica_ok.c" > quads_teste_c.txt 2>/dev/null
+    ./compiler < "teste/teste.c" > quads_teste_c.txt 2>/dev/null
     if [ $? -ne 0 ]; then
         echo -e "${RED}[ FAIL ] (Compilador falhou ao gerar quádruplas)${NC}"
         return
@@ -121,11 +141,142 @@ test_py() {
     fi
 }
 
+# Confere que o .pyc gerado direto (--emit=pyc) se comporta como o .py
+test_pyc() {
+    echo "----------------------------------------"
+    echo "Executando teste de geração de .pyc..."
+
+    # O .pyc é do CPython 3.11; outras versões o recusam pelo número mágico
+    if ! python3 -c 'import sys; sys.exit(sys.version_info[:2] != (3, 11))'; then
+        echo "Testando .pyc contra .py... [ SKIP ] (requer Python 3.11)"
+        return
+    fi
+
+    for programa in teste/teste.c teste/teste_multiplas_funcoes.c teste/teste_desenrolar.c \
+                    teste/teste_bits.c teste/teste_mortos.c teste/teste_tipos.c \
+                    teste/teste_biblioteca.c teste/teste_desvios.c teste/teste_curto_circuito.c \
+                    teste/teste_preproc.c; do
+        printf "Testando .pyc contra .py: %-30s " "$programa"
+        ./compiler --emit=py "$programa" -o teste/output_program.py 2>/dev/null
+        ./compiler --emit=pyc "$programa" -o teste/output_program.pyc 2>/dev/null
+        esperado=$(python3 teste/output_program.py 2>&1)
+        st_py=$?
+        obtido=$(python3 teste/output_program.pyc 2>&1)
+        # Os programas que conferem o próprio resultado imprimem "ERRO" quando falham
+        if [ $st_py -eq 0 ] && [ "$esperado" = "$obtido" ] && [[ "$esperado" != *ERRO* ]]; then
+            echo -e "${GREEN}[ PASS ]${NC}"
+        else
+            echo -e "${RED}[ FAIL ]${NC}"
+        fi
+    done
+}
+
+# Inicia ./compiler --servir com um único worker (o cache de headers é o mesmo entre pedidos)
+iniciar_servidor() {
+    SOCKET=/tmp/compilador_teste_$$.sock
+    ./compiler --servir "$SOCKET" --workers 1 > /dev/null 2>&1 &
+    SERVIDOR=$!
+    for _ in $(seq 100); do
+        [ -S "$SOCKET" ] && break
+        sleep 0.05
+    done
+}
+
+# Servidor de compilação: o cliente devolve a saída e o status do compilador
+test_servidor() {
+    echo "----------------------------------------"
+    echo "Executando teste do servidor de compilação..."
+
+    if ! gcc cliente.c servidor.c -o cliente > /dev/null 2>&1; then
+        echo -e "Testando servidor... ${RED}[ FAIL ] (falha ao compilar o cliente)${NC}"
+        return
+    fi
+    iniciar_servidor
+
+    # Um programa válido e um com erro
+    for programa in teste/teste.c teste/erro_variavel_nao_declarada.c; do
+        printf "Testando servidor: %-35s " "$programa"
+        esperado=$(./compiler < "$programa" 2>&1)
+        st_direto=$?
+        obtido=$(COMPILADOR_SOCKET="$SOCKET" ./cliente < "$programa" 2>&1)
+        st_cliente=$?
+        if [ "$programa" = teste/teste.c ]; then st_esperado=0; else st_esperado=1; fi
+        if [ $st_direto -eq $st_esperado ] && [ $st_cliente -eq $st_esperado ] && [ "$esperado" = "$obtido" ]; then
+            echo -e "${GREEN}[ PASS ]${NC}"
+        else
+            echo -e "${RED}[ FAIL ]${NC}"
+        fi
+    done
+    kill $SERVIDOR
+    wait $SERVIDOR 2>/dev/null
+}
+
+# Pré-processador: posições depois de #include, header protegido incluído
+# duas vezes e invalidação do cache de headers
+test_preproc() {
+    echo "----------------------------------------"
+    echo "Executando testes do pré-processador..."
+
+    resultado() {
+        printf "Testando pré-processador: %s%*s " "$1" $((32 - ${#1})) ""
+        if [ "$2" -eq 0 ]; then echo -e "${GREEN}[ PASS ]${NC}"; else echo -e "${RED}[ FAIL ]${NC}"; fi
+    }
+    # Número da linha de `arquivo` que contém `trecho`
+    linha_de() { grep -n -F "$2" "$1" | head -n 1 | cut -d: -f1; }
+
+    HLIR=$(./compiler teste/teste_preproc.c 2>/dev/null)
+    STATUS=$?
+    # Cada instrução leva a linha do arquivo de onde veio: o header e o .c depois de cada #include
+    certo=$STATUS
+    for posicao in "FUNC_START limite_ao_quadrado|teste/teste_preproc.h|int limite_ao_quadrado" \
+                   "ASSIGN  depois_include|teste/teste_preproc.c|depois_include = PASSO" \
+                   "ASSIGN  depois_cache|teste/teste_preproc.c|depois_cache = PASSO"; do
+        IFS='|' read -r instr arquivo trecho <<< "$posicao"
+        echo "$HLIR" | grep -F "$instr" | grep -q -F "@$(linha_de "$arquivo" "$trecho"):" || certo=1
+    done
+    resultado "linhas depois de #include" $certo
+    # O include guard impede que a segunda inclusão repita a função do header
+    [ $STATUS -eq 0 ] && [ "$(echo "$HLIR" | grep -c -F "FUNC_START limite_ao_quadrado")" -eq 1 ]
+    resultado "header protegido incluído 2x" $?
+
+    if ! gcc cliente.c servidor.c -o cliente > /dev/null 2>&1; then
+        resultado "cache (falha ao compilar o cliente)" 1
+        return
+    fi
+    iniciar_servidor
+    compilar() { COMPILADOR_SOCKET="$SOCKET" ./cliente "$1" 2>/dev/null; }
+
+    # Pelo servidor, a segunda compilação reproduz os headers do cache
+    [ "$(compilar teste/teste_preproc.c)" = "$HLIR" ] && [ "$(compilar teste/teste_preproc.c)" = "$HLIR" ]
+    resultado "cache com header protegido" $?
+
+    DIR=/tmp/compilador_preproc_$$
+    mkdir -p "$DIR"
+    printf '#include "cabecalho.h"\nint main() {\n    printf("%%d\\n", VALOR);\n    return 0;\n}\n' > "$DIR/principal.c"
+    echo "#define VALOR 111" > "$DIR/cabecalho.h"
+    touch -t 202001010000 "$DIR/cabecalho.h"
+    compilar "$DIR/principal.c" | grep -q "PARAM   111" && compilar "$DIR/principal.c" | grep -q "PARAM   111"
+    certo=$?
+    # Mesmo tamanho, outra data de modificação
+    echo "#define VALOR 222" > "$DIR/cabecalho.h"
+    touch -t 202001010010 "$DIR/cabecalho.h"
+    compilar "$DIR/principal.c" | grep -q "PARAM   222" || certo=1
+    # Mesma data de modificação, outro tamanho
+    echo "#define VALOR 3333" > "$DIR/cabecalho.h"
+    touch -t 202001010010 "$DIR/cabecalho.h"
+    compilar "$DIR/principal.c" | grep -q "PARAM   3333" || certo=1
+    resultado "cache após editar o header" $certo
+
+    kill $SERVIDOR
+    wait $SERVIDOR 2>/dev/null
+    rm -rf "$DIR"
+}
+
 # Função para limpar os arquivos gerados
 clean() {
     echo "Limpando arquivos gerados..."
-    rm -f compiler lex.yy.c parser.tab.c parser.tab.h
-    rm -f teste/output_quads.txt teste/output_program.py quads_teste_c.txt
+    rm -f compiler cliente lex.yy.c parser.tab.c parser.tab.h
+    rm -f teste/output_quads.txt teste/output_program.py teste/output_program.pyc quads_teste_c.txt
     echo "Limpeza concluída."
 }
 
@@ -159,6 +310,9 @@ main() {
             build
             test_c
             test_py
+            test_pyc
+            test_servidor
+            test_preproc
             ;;
         build)
             build
@@ -166,6 +320,9 @@ main() {
         test)
             test_c
             test_py
+            test_pyc
+            test_servidor
+            test_preproc
             ;;
         clean)
             clean
@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "saida.h"
+
+#define TAM_BUFFER_SAIDA (1 << 20)
+
+static char   buffer[TAM_BUFFER_SAIDA];
+static size_t usado = 0;
+static int    fd_saida = STDOUT_FILENO;
+static int    falhou = 0;
+static char*  caminho_saida = NULL;   // arquivo aberto (NULL = saída padrão)
+
+// Saída em memória (fd_saida == -1)
+static char*  memoria = NULL;
+static size_t n_memoria = 0, cap_memoria = 0;
+
+static void escrever_memoria(const char* dados, size_t n) {
+    if (n_memoria + n + 1 > cap_memoria) {
+        size_t cap = cap_memoria ? cap_memoria : TAM_BUFFER_SAIDA;
+        while (n_memoria + n + 1 > cap) cap *= 2;
+        char* novo = realloc(memoria, cap);
+        if (!novo) {
+            if (!falhou) fprintf(stderr, "Erro: falha ao alocar memória para a saída\n");
+            falhou = 1;
+            return;
+        }
+        memoria = novo;
+        cap_memoria = cap;
+    }
+    memcpy(memoria + n_memoria, dados, n);
+    n_memoria += n;
+}
+
+static void escrever_fd(const char* dados, size_t n) {
+    if (fd_saida < 0) {
+        escrever_memoria(dados, n);
+        return;
+    }
+    while (n > 0) {
+        ssize_t k = write(fd_saida, dados, n);
+        if (k < 0) {
+            if (errno == EINTR) continue;
+            if (!falhou) fprintf(stderr, "Erro: falha ao escrever a saída: %s\n", strerror(errno));
+            falhou = 1;
+            return;
+        }
+        dados += k;
+        n -= (size_t)k;
+    }
+}
+
+static void descarregar(void) {
+    escrever_fd(buffer, usado);
+    usado = 0;
+}
+
+int saida_abrir(const char* caminho) {
+    usado = 0;
+    falhou = 0;
+    fd_saida = STDOUT_FILENO;
+    free(caminho_saida);
+    caminho_saida = NULL;
+    if (!caminho || strcmp(caminho, "-") == 0) {
+        // O que já estiver no buffer do stdio precisa sair antes
+        fflush(stdout);
+        return 1;
+    }
+    fd_saida = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_saida < 0) {
+        fprintf(stderr, "Erro: não foi possível criar '%s': %s\n", caminho, strerror(errno));
+        fd_saida = STDOUT_FILENO;
+        return 0;
+    }
+    caminho_saida = strdup(caminho);
+    return 1;
+}
+
+int saida_fechar(void) {
+    descarregar();
+    if (fd_saida != STDOUT_FILENO && close(fd_saida) != 0) falhou = 1;
+    fd_saida = STDOUT_FILENO;
+    free(caminho_saida);
+    caminho_saida = NULL;
+    return !falhou;
+}
+
+void saida_descartar(void) {
+    usado = 0;
+    if (fd_saida < 0) {
+        free(memoria);
+        memoria = NULL;
+        n_memoria = cap_memoria = 0;
+    } else if (fd_saida != STDOUT_FILENO) {
+        close(fd_saida);
+        unlink(caminho_saida);
+    }
+    fd_saida = STDOUT_FILENO;
+    free(caminho_saida);
+    caminho_saida = NULL;
+}
+
+void saida_abrir_memoria(void) {
+    saida_abrir(NULL);
+    fd_saida = -1;
+    n_memoria = 0;
+}
+
+char* saida_fechar_memoria(size_t* n) {
+    descarregar();
+    escrever_memoria("", 1);
+    char* texto = falhou ? NULL : memoria;
+    if (falhou) free(memoria);
+    if (n) *n = texto ? n_memoria - 1 : 0;
+    memoria = NULL;
+    n_memoria = cap_memoria = 0;
+    fd_saida = STDOUT_FILENO;
+    return texto;
+}
+
+void saida_escrever(const char* dados, size_t n) {
+    if (usado + n > TAM_BUFFER_SAIDA) {
+        descarregar();
+        if (n > TAM_BUFFER_SAIDA) {
+            // Bloco maior que o buffer inteiro: vai direto para o arquivo
+            escrever_fd(dados, n);
+            return;
+        }
+    }
+    memcpy(buffer + usado, dados, n);
+    usado += n;
+}
+
+void saida_texto(const char* s) {
+    saida_escrever(s, strlen(s));
+}
+
+void saida_char(char c) {
+    if (usado == TAM_BUFFER_SAIDA) descarregar();
+    buffer[usado++] = c;
+}
+
+void saida_int(long v) {
+    char tmp[24];
+    char* p = tmp + sizeof(tmp);
+    unsigned long u = v < 0 ? 0UL - (unsigned long)v : (unsigned long)v;
+    do {
+        *--p = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (v < 0) *--p = '-';
+    saida_escrever(p, (size_t)(tmp + sizeof(tmp) - p));
+}
+
+void saida_printf(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    size_t livre = TAM_BUFFER_SAIDA - usado;
+    int n = vsnprintf(buffer + usado, livre, fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    if ((size_t)n < livre) {
+        usado += (size_t)n;
+        return;
+    }
+
+    // Não coube: formata em memória à parte
+    char* tmp = malloc((size_t)n + 1);
+    if (!tmp) return;
+    va_start(args, fmt);
+    vsnprintf(tmp, (size_t)n + 1, fmt, args);
+    va_end(args);
+    saida_escrever(tmp, (size_t)n);
+    free(tmp);
+}
+
+void saida_json_texto(const char* s) {
+    for (const unsigned char* p = (const unsigned char*)s; *p; p++) {
+        switch (*p) {
+            case '"':  saida_escrever("\\\"", 2); break;
+            case '\\': saida_escrever("\\\\", 2); break;
+            case '\n': saida_escrever("\\n", 2); break;
+            case '\r': saida_escrever("\\r", 2); break;
+            case '\t': saida_escrever("\\t", 2); break;
+            default:
+                if (*p < 0x20) saida_printf("\\u%04x", *p);
+                else saida_char((char)*p);
+        }
+    }
+}
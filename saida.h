@@ -0,0 +1,34 @@
+#ifndef SAIDA_H
+#define SAIDA_H
+
+#include <stddef.h>
+
+// --- Saída do compilador ---
+// Todos os artefatos (AST, HLIR, Python, JSON) são escritos por este único
+// buffer grande, descarregado com write() só quando enche ou ao fechar, em
+// vez de um printf por nó/quádrupla.
+
+// Abre a saída: `caminho` NULL ou "-" usa a saída padrão. Retorna 0 em erro.
+int  saida_abrir(const char* caminho);
+// Descarrega o buffer e fecha o arquivo (a saída padrão não é fechada).
+// Retorna 0 se alguma escrita falhou.
+int  saida_fechar(void);
+// Abandona a saída depois de um erro: o que ainda está no buffer é jogado
+// fora e o arquivo (se não for a saída padrão) é removido.
+void saida_descartar(void);
+
+// Saída em memória (modo incremental): o artefato inteiro é acumulado e
+// devolvido por saida_fechar_memoria() (terminado em '\0', liberado por
+// quem chamou; NULL se alguma escrita falhou).
+void  saida_abrir_memoria(void);
+char* saida_fechar_memoria(size_t* n);
+
+void saida_escrever(const char* dados, size_t n);
+void saida_texto(const char* s);
+void saida_char(char c);
+void saida_int(long v);
+void saida_printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+// Escreve `s` como conteúdo de uma string JSON (sem as aspas externas)
+void saida_json_texto(const char* s);
+
+#endif
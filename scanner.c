@@ -0,0 +1,729 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+#include "parser.tab.h"
+#include "preproc.h"
+#include "scanner.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SCANNER_X86 1
+#include <immintrin.h>
+#endif
+
+// Bytes zerados depois do fim dos dados na janela: as rotinas vetoriais
+// leem blocos inteiros de 16/32 bytes e param no primeiro byte fora da
+// classe, então sempre encontram um zero antes de sair do buffer.
+#define PREENCHIMENTO 64
+
+// A entrada é lida numa janela deslizante de SCANNER_BLOCO bytes (cresce só
+// se um único token for maior), como o buffer do Flex: a memória não depende
+// do tamanho do arquivo. Antes de cada token há pelo menos MARGEM bytes à
+// frente (ou o fim da entrada); tokens longos que chegam ao fim da janela
+// são relidos depois de recarregá-la.
+#ifndef SCANNER_BLOCO
+#define SCANNER_BLOCO (1 << 16)
+#endif
+#define MARGEM 64
+
+int yylineno = 1;
+int yycolumn = 1;      // coluna (1-based) do próximo caractere, como em lexer.l
+
+// buffer[0] guarda o byte anterior à janela ('\n' no início da entrada),
+// para saber se um '#' está no começo de uma linha
+static char*       buffer = NULL;
+static size_t      capacidade = 0;
+static const char* p;          // próximo caractere
+static const char* fim;        // fim dos dados lidos na janela
+static int         carregado = 0;
+static int         fim_entrada = 0;
+
+// ==========================================================
+// Classes de caracteres (versão escalar)
+// ==========================================================
+
+static unsigned char eh_id[256];       // [A-Za-z0-9_]
+static unsigned char eh_espaco[256];   // ' ', '\t', '\r', '\n'
+
+static void iniciar_classes(void) {
+    for (int c = 0; c < 256; c++) {
+        eh_id[c] = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        eh_espaco[c] = c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+}
+
+#define EH_DIGITO(c) ((unsigned char)((c) - '0') < 10)
+#define EH_HEXA(c)   (EH_DIGITO(c) || (unsigned char)(((c) | 0x20) - 'a') < 6)
+
+// ==========================================================
+// Rotinas de varredura
+// ==========================================================
+// Cada rotina existe em versão escalar, SSE2 e AVX2; a tabela `varrer` é
+// preenchida uma vez com a melhor disponível na CPU.
+//
+//   espacos(p, &quebras, &ultima)  fim da sequência de espaços em p; conta as
+//                                  quebras de linha e devolve a última
+//   identificador(p)               primeiro byte fora de [A-Za-z0-9_]
+//   digitos(p)                     primeiro byte fora de [0-9]
+//   quebra(p, fim)                 primeiro '\n' (ou fim)
+//   fecha_comentario(p, fim)       primeiro "*/" (ou NULL)
+//   aspas(p, fim)                  primeiro '"', '\\' ou '\n' (ou fim)
+
+typedef struct {
+    const char* nome;
+    const char* (*espacos)(const char* p, int* quebras, const char** ultima);
+    const char* (*identificador)(const char* p);
+    const char* (*digitos)(const char* p);
+    const char* (*quebra)(const char* p, const char* fim);
+    const char* (*fecha_comentario)(const char* p, const char* fim);
+    const char* (*aspas)(const char* p, const char* fim);
+} Varredura;
+
+static Varredura varrer;
+
+// --- Escalar ---
+
+static const char* espacos_escalar(const char* p, int* quebras, const char** ultima) {
+    while (eh_espaco[(unsigned char)*p]) {
+        if (*p == '\n') { (*quebras)++; *ultima = p; }
+        p++;
+    }
+    return p;
+}
+
+static const char* identificador_escalar(const char* p) {
+    while (eh_id[(unsigned char)*p]) p++;
+    return p;
+}
+
+static const char* digitos_escalar(const char* p) {
+    while (EH_DIGITO(*p)) p++;
+    return p;
+}
+
+static const char* quebra_escalar(const char* p, const char* fim) {
+    const char* q = memchr(p, '\n', (size_t)(fim - p));
+    return q ? q : fim;
+}
+
+static const char* fecha_comentario_escalar(const char* p, const char* fim) {
+    for (; p + 1 < fim; p++) {
+        if (p[0] == '*' && p[1] == '/') return p;
+    }
+    return NULL;
+}
+
+static const char* aspas_escalar(const char* p, const char* fim) {
+    while (p < fim && *p != '"' && *p != '\\' && *p != '\n') p++;
+    return p;
+}
+
+#ifdef SCANNER_X86
+
+// --- SSE2 (16 bytes por iteração) ---
+// Comparações com sinal: bytes >= 0x80 são negativos e nunca caem nas
+// faixas ASCII testadas.
+
+static inline __m128i faixa_sse2(__m128i v, char min, char max) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8((char)(min - 1))),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8((char)(max + 1))));
+}
+
+static inline unsigned mascara_espacos_sse2(__m128i v) {
+    __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                          _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                             _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')),
+                                          _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+    return (unsigned)_mm_movemask_epi8(m);
+}
+
+static const char* espacos_sse2(const char* p, int* quebras, const char** ultima) {
+    for (;;) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        unsigned fora = ~mascara_espacos_sse2(v) & 0xFFFFu;
+        unsigned nl = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+        int n = fora ? __builtin_ctz(fora) : 16;
+        nl &= (n == 16) ? 0xFFFFu : ((1u << n) - 1);
+        if (nl) {
+            *quebras += __builtin_popcount(nl);
+            *ultima = p + 31 - __builtin_clz(nl);
+        }
+        if (fora) return p + n;
+        p += 16;
+    }
+}
+
+static const char* identificador_sse2(const char* p) {
+    for (;;) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i letra  = faixa_sse2(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z');
+        __m128i digito = faixa_sse2(v, '0', '9');
+        __m128i sub    = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+        unsigned fora = ~(unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(letra, digito), sub)) & 0xFFFFu;
+        if (fora) return p + __builtin_ctz(fora);
+        p += 16;
+    }
+}
+
+static const char* digitos_sse2(const char* p) {
+    for (;;) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        unsigned fora = ~(unsigned)_mm_movemask_epi8(faixa_sse2(v, '0', '9')) & 0xFFFFu;
+        if (fora) return p + __builtin_ctz(fora);
+        p += 16;
+    }
+}
+
+static const char* quebra_sse2(const char* p, const char* fim) {
+    for (; p < fim; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+        if (m) {
+            const char* q = p + __builtin_ctz(m);
+            return q < fim ? q : fim;
+        }
+    }
+    return fim;
+}
+
+static const char* fecha_comentario_sse2(const char* p, const char* fim) {
+    for (; p < fim; p += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)p);
+        __m128i b = _mm_loadu_si128((const __m128i*)(p + 1));
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, _mm_set1_epi8('*')),
+                                                               _mm_cmpeq_epi8(b, _mm_set1_epi8('/'))));
+        if (m) {
+            const char* q = p + __builtin_ctz(m);
+            return q + 1 < fim ? q : NULL;
+        }
+    }
+    return NULL;
+}
+
+static const char* aspas_sse2(const char* p, const char* fim) {
+    for (; p < fim; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                                              _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))),
+                                 _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+        unsigned bits = (unsigned)_mm_movemask_epi8(m);
+        if (bits) {
+            const char* q = p + __builtin_ctz(bits);
+            return q < fim ? q : fim;
+        }
+    }
+    return fim;
+}
+
+// --- AVX2 (32 bytes por iteração) ---
+
+#define AVX2 __attribute__((target("avx2")))
+
+static AVX2 inline __m256i faixa_avx2(__m256i v, char min, char max) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8((char)(min - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(max + 1)), v));
+}
+
+static AVX2 const char* espacos_avx2(const char* p, int* quebras, const char** ultima) {
+    for (;;) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i nlv = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+        __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                                     _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')), nlv));
+        unsigned fora = ~(unsigned)_mm256_movemask_epi8(ws);
+        unsigned nl = (unsigned)_mm256_movemask_epi8(nlv);
+        int n = fora ? __builtin_ctz(fora) : 32;
+        if (n < 32) nl &= (1u << n) - 1;
+        if (nl) {
+            *quebras += __builtin_popcount(nl);
+            *ultima = p + 31 - __builtin_clz(nl);
+        }
+        if (fora) return p + n;
+        p += 32;
+    }
+}
+
+static AVX2 const char* identificador_avx2(const char* p) {
+    for (;;) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i letra  = faixa_avx2(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z');
+        __m256i digito = faixa_avx2(v, '0', '9');
+        __m256i sub    = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'));
+        unsigned fora = ~(unsigned)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(letra, digito), sub));
+        if (fora) return p + __builtin_ctz(fora);
+        p += 32;
+    }
+}
+
+static AVX2 const char* digitos_avx2(const char* p) {
+    for (;;) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        unsigned fora = ~(unsigned)_mm256_movemask_epi8(faixa_avx2(v, '0', '9'));
+        if (fora) return p + __builtin_ctz(fora);
+        p += 32;
+    }
+}
+
+static AVX2 const char* quebra_avx2(const char* p, const char* fim) {
+    for (; p < fim; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+        if (m) {
+            const char* q = p + __builtin_ctz(m);
+            return q < fim ? q : fim;
+        }
+    }
+    return fim;
+}
+
+static AVX2 const char* fecha_comentario_avx2(const char* p, const char* fim) {
+    for (; p < fim; p += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)p);
+        __m256i b = _mm256_loadu_si256((const __m256i*)(p + 1));
+        unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, _mm256_set1_epi8('*')),
+                                                                     _mm256_cmpeq_epi8(b, _mm256_set1_epi8('/'))));
+        if (m) {
+            const char* q = p + __builtin_ctz(m);
+            return q + 1 < fim ? q : NULL;
+        }
+    }
+    return NULL;
+}
+
+static AVX2 const char* aspas_avx2(const char* p, const char* fim) {
+    for (; p < fim; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+                                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))),
+                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+        unsigned bits = (unsigned)_mm256_movemask_epi8(m);
+        if (bits) {
+            const char* q = p + __builtin_ctz(bits);
+            return q < fim ? q : fim;
+        }
+    }
+    return fim;
+}
+
+#endif // SCANNER_X86
+
+static const Varredura VARREDURA_ESCALAR = {
+    "escalar", espacos_escalar, identificador_escalar, digitos_escalar,
+    quebra_escalar, fecha_comentario_escalar, aspas_escalar
+};
+#ifdef SCANNER_X86
+static const Varredura VARREDURA_SSE2 = {
+    "sse2", espacos_sse2, identificador_sse2, digitos_sse2,
+    quebra_sse2, fecha_comentario_sse2, aspas_sse2
+};
+static const Varredura VARREDURA_AVX2 = {
+    "avx2", espacos_avx2, identificador_avx2, digitos_avx2,
+    quebra_avx2, fecha_comentario_avx2, aspas_avx2
+};
+#endif
+
+static void escolher_varredura(void) {
+    const char* forcada = getenv("SCANNER_SIMD");
+    varrer = VARREDURA_ESCALAR;
+#ifdef SCANNER_X86
+    __builtin_cpu_init();
+    if (forcada && strcmp(forcada, "escalar") == 0) return;
+    varrer = VARREDURA_SSE2;   // presente em todo x86-64
+    if (forcada && strcmp(forcada, "sse2") == 0) return;
+    if (__builtin_cpu_supports("avx2")) varrer = VARREDURA_AVX2;
+#else
+    (void)forcada;
+#endif
+}
+
+const char* scanner_implementacao(void) {
+    if (!varrer.nome) {
+        iniciar_classes();
+        escolher_varredura();
+    }
+    return varrer.nome;
+}
+
+// ==========================================================
+// Palavras-chave: hash perfeito
+// ==========================================================
+// h = (tamanho + 9 * primeiro + 3 * último) & 63 não colide para as 24
+// palavras-chave; cada posição guarda no máximo uma, conferida com memcmp.
+
+typedef struct {
+    const char* texto;
+    int         tamanho;
+    int         token;
+} PalavraChave;
+
+static const PalavraChave palavras_chave[64] = {
+    [ 0] = { "else",     4, KW_ELSE },
+    [ 3] = { "sizeof",   6, KW_SIZEOF },
+    [ 5] = { "long",     4, KW_LONG },
+    [ 9] = { "switch",   6, KW_SWITCH },
+    [16] = { "int",      3, KW_INT },
+    [17] = { "unsigned", 8, KW_UNSIGNED },
+    [18] = { "return",   6, KW_RETURN },
+    [19] = { "do",       2, KW_DO },
+    [21] = { "char",     4, KW_CHAR },
+    [22] = { "void",     4, KW_VOID },
+    [24] = { "enum",     4, KW_ENUM },
+    [28] = { "const",    5, KW_CONST },
+    [35] = { "while",    5, KW_WHILE },
+    [37] = { "if",       2, KW_IF },
+    [39] = { "default",  7, KW_DEFAULT },
+    [44] = { "short",    5, KW_SHORT },
+    [46] = { "case",     4, KW_CASE },
+    [47] = { "for",      3, KW_FOR },
+    [50] = { "continue", 8, KW_CONTINUE },
+    [55] = { "float",    5, KW_FLOAT },
+    [56] = { "break",    5, KW_BREAK },
+    [57] = { "double",   6, KW_DOUBLE },
+    [58] = { "static",   6, KW_STATIC },
+    [61] = { "signed",   6, KW_SIGNED },
+};
+
+static int buscar_palavra_chave(const char* s, int n) {
+    if (n < 2 || n > 8) return 0;
+    const PalavraChave* k = &palavras_chave[(n + 9 * (unsigned char)s[0] + 3 * (unsigned char)s[n - 1]) & 63];
+    if (k->tamanho == n && memcmp(k->texto, s, (size_t)n) == 0) return k->token;
+    return 0;
+}
+
+// ==========================================================
+// Entrada
+// ==========================================================
+
+// Move o que falta consumir (e o byte anterior) para o início da janela e
+// completa-a com a saída do pré-processador
+static void recarregar(void) {
+    size_t manter = carregado ? (size_t)(fim - p) + 1 : 0;
+    size_t tam;
+    if (carregado) {
+        memmove(buffer, p - 1, manter);
+        tam = manter;
+    } else {
+        buffer[0] = '\n';
+        tam = 1;
+    }
+    if (capacidade - tam < SCANNER_BLOCO) {
+        capacidade = tam + SCANNER_BLOCO;
+        buffer = realloc(buffer, capacidade + PREENCHIMENTO);
+        if (!buffer) {
+            fprintf(stderr, "Erro: Falha ao alocar memória no scanner\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    while (tam < capacidade && !fim_entrada) {
+        size_t n = preproc_ler(buffer + tam, capacidade - tam);
+        if (n == 0) fim_entrada = 1;
+        tam += n;
+    }
+    memset(buffer + tam, 0, PREENCHIMENTO);
+    p = buffer + 1;
+    fim = buffer + tam;
+    carregado = 1;
+}
+
+static void carregar(void) {
+    capacidade = 2 * SCANNER_BLOCO;
+    buffer = malloc(capacidade + PREENCHIMENTO);
+    if (!buffer) {
+        fprintf(stderr, "Erro: Falha ao alocar memória no scanner\n");
+        exit(EXIT_FAILURE);
+    }
+    fim_entrada = 0;
+    scanner_implementacao();
+    recarregar();
+}
+
+// O token que começa em p chegou ao fim da janela e a entrada ainda não
+// acabou: recarrega e volta a lê-lo desde o início
+#define INCOMPLETO(q) (!fim_entrada && (q) >= fim)
+
+void lexer_reiniciar(void) {
+    free(buffer);
+    buffer = NULL;
+    capacidade = 0;
+    carregado = 0;
+    fim_entrada = 0;
+    yylineno = 1;
+    yycolumn = 1;
+}
+
+// ==========================================================
+// yylex
+// ==========================================================
+
+// Conta quebras de linha em [ini, fim) e devolve a última (ou NULL)
+static int contar_quebras(const char* ini, const char* fim, const char** ultima) {
+    int n = 0;
+    *ultima = NULL;
+    while ((ini = memchr(ini, '\n', (size_t)(fim - ini))) != NULL) {
+        n++;
+        *ultima = ini++;
+    }
+    return n;
+}
+
+// Registra em yylloc o token [ini, ini+n) e avança a coluna (YY_USER_ACTION)
+static inline void marcar(int n) {
+    yylloc.first_line   = yylloc.last_line = yylineno;
+    yylloc.first_column = yycolumn;
+    yylloc.last_column  = yycolumn + n - 1;
+    yycolumn += n;
+}
+
+static int token_texto(int token, const char* ini, const char* q) {
+    int n = (int)(q - ini);
+    marcar(n);
+    yylval.str = strndup(ini, (size_t)n);
+    p = q;
+    return token;
+}
+
+static void caractere_desconhecido(void) {
+    marcar(1);
+    fprintf(stderr, "Caractere não reconhecido: %.1s\n", p);
+    p++;
+}
+
+// "# N ..." no início de uma linha (marcador de linha do pré-processador).
+// Retorna -1 se a linha não cabe na janela.
+static int marcador_de_linha(void) {
+    const char* q = p + 1;
+    while (*q == ' ' || *q == '\t') q++;
+    if (INCOMPLETO(q)) return -1;
+    if (!EH_DIGITO(*q)) return 0;
+    const char* nl = varrer.quebra(q, fim);
+    if (INCOMPLETO(nl)) return -1;
+    if (nl >= fim) return 0;
+    yylineno = (int)strtol(p + 1, NULL, 10);
+    yycolumn = 1;
+    p = nl + 1;
+    return 1;
+}
+
+// Literal de string: "..." com escapes, sem barra invertida antes de '\n'.
+// Retorna o fim (depois da aspa final) ou NULL se não fechar; *incompleto
+// indica que a string chegou ao fim da janela.
+static const char* fim_string(const char* q, int* incompleto) {
+    *incompleto = 0;
+    for (;;) {
+        q = varrer.aspas(q, fim);
+        if (q + 1 >= fim) *incompleto = INCOMPLETO(q + 1);
+        if (q >= fim) return NULL;
+        if (*q == '"') return q + 1;
+        if (*q == '\\') {
+            if (q + 1 >= fim || q[1] == '\n') return NULL;
+            q += 2;
+        } else {
+            q++;   // '\n' dentro da string (aceito, como em lexer.l)
+        }
+    }
+}
+
+// A maioria dos identificadores e números tem poucos caracteres: os primeiros
+// CURTO bytes são vistos um a um e só sequências mais longas vão para a
+// rotina vetorial.
+#define CURTO 8
+
+static inline const char* identificador_curto(const char* q) {
+    const char* limite = q + CURTO;
+    while (q < limite && eh_id[(unsigned char)*q]) q++;
+    return q == limite ? varrer.identificador(q) : q;
+}
+
+static inline const char* digitos_curtos(const char* q) {
+    const char* limite = q + CURTO;
+    while (q < limite && EH_DIGITO(*q)) q++;
+    return q == limite ? varrer.digitos(q) : q;
+}
+
+// Sufixo de inteiro do C: u, l, ll (na mesma caixa) e as combinações
+// ul, lu, ull, llu... Equivale a SUFIXO_INT no lexer.l.
+static inline const char* sufixo_inteiro(const char* q) {
+    int sem_sinal = *q == 'u' || *q == 'U';
+    if (sem_sinal) q++;
+    if (*q == 'l' || *q == 'L') {
+        q += q[1] == q[0] ? 2 : 1;
+        if (!sem_sinal && (*q == 'u' || *q == 'U')) q++;
+    }
+    return q;
+}
+
+int yylex(void) {
+    if (!carregado) carregar();
+
+    for (;;) {
+        if (!fim_entrada && fim - p < MARGEM) recarregar();
+        if (p >= fim) return 0;
+        const char* ini = p;
+        unsigned char c = (unsigned char)*p;
+
+        // Espaços e quebras de linha. Um espaço isolado (o caso mais comum)
+        // não compensa uma chamada à rotina vetorial.
+        if (c == ' ' && !eh_espaco[(unsigned char)p[1]]) {
+            yycolumn++;
+            p++;
+            continue;
+        }
+        if (eh_espaco[c]) {
+            int quebras = 0;
+            const char* ultima = NULL;
+            const char* q = varrer.espacos(p, &quebras, &ultima);
+            if (q > fim) q = fim;
+            if (quebras) {
+                yylineno += quebras;
+                yycolumn = (int)(q - ultima);
+            } else {
+                yycolumn += (int)(q - p);
+            }
+            p = q;
+            continue;
+        }
+
+        // Identificadores e palavras-chave
+        if (eh_id[c] && !EH_DIGITO(c)) {
+            const char* q = identificador_curto(p + 1);
+            if (INCOMPLETO(q)) { recarregar(); continue; }
+            int token = buscar_palavra_chave(ini, (int)(q - ini));
+            if (token) {
+                marcar((int)(q - ini));
+                p = q;
+                return token;
+            }
+            return token_texto(ID, ini, q);
+        }
+
+        // Números: 0x[0-9a-fA-F]+ e [0-9]+ com sufixo de inteiro, ou
+        // [0-9]+(\.[0-9]+)?([eE][-+]?[0-9]+)? com sufixo f/l se for real
+        if (EH_DIGITO(c)) {
+            const char* q;
+            int real = 0;
+            if (c == '0' && (p[1] == 'x' || p[1] == 'X') && EH_HEXA(p[2])) {
+                q = p + 3;
+                while (EH_HEXA(*q)) q++;
+            } else {
+                q = digitos_curtos(p + 1);
+                if (q[0] == '.' && EH_DIGITO(q[1])) {
+                    q = digitos_curtos(q + 2);
+                    real = 1;
+                }
+                if (q[0] == 'e' || q[0] == 'E') {
+                    const char* r = q + 1;
+                    if (*r == '+' || *r == '-') r++;
+                    if (EH_DIGITO(*r)) {
+                        q = digitos_curtos(r + 1);
+                        real = 1;
+                    }
+                }
+            }
+            if (!real) q = sufixo_inteiro(q);
+            else if (*q == 'f' || *q == 'F' || *q == 'l' || *q == 'L') q++;
+            if (INCOMPLETO(q + 3)) { recarregar(); continue; }
+            if (q > fim) q = fim;
+            return token_texto(NUMBER, ini, q);
+        }
+
+        switch (c) {
+            case '/':
+                if (p[1] == '/') {
+                    const char* q = varrer.quebra(p + 2, fim);
+                    if (INCOMPLETO(q)) { recarregar(); continue; }
+                    marcar((int)(q - p));
+                    p = q;
+                    continue;
+                }
+                if (p[1] == '*') {
+                    const char* q = varrer.fecha_comentario(p + 2, fim);
+                    if (!q && !fim_entrada) { recarregar(); continue; }
+                    if (!q) break;   // sem "*/": é só uma divisão
+                    q += 2;
+                    const char* ultima;
+                    int quebras = contar_quebras(p, q, &ultima);
+                    yylineno += quebras;
+                    marcar((int)(q - p));
+                    if (quebras) yycolumn = (int)(q - ultima);
+                    p = q;
+                    continue;
+                }
+                break;
+
+            case '"': {
+                int incompleto;
+                const char* q = fim_string(p + 1, &incompleto);
+                if (!q && incompleto) { recarregar(); continue; }
+                if (!q) { caractere_desconhecido(); continue; }
+                const char* ultima;
+                yylineno += contar_quebras(p, q, &ultima);
+                return token_texto(STRING, ini, q);
+            }
+
+            case '\'': {
+                const char* q = NULL;
+                if (p + 2 < fim && p[1] != '\'' && p[1] != '\\' && p[2] == '\'') q = p + 3;
+                else if (p + 3 < fim && p[1] == '\\' && p[2] != '\n' && p[3] == '\'') q = p + 4;
+                if (!q) { caractere_desconhecido(); continue; }
+                if (p[1] == '\n') yylineno++;
+                return token_texto(CHAR, ini, q);
+            }
+
+            case '#':
+                if (p[-1] == '\n') {
+                    int marcador = marcador_de_linha();
+                    if (marcador < 0) { recarregar(); continue; }
+                    if (marcador) continue;
+                }
+                caractere_desconhecido();
+                continue;
+        }
+
+        // Operadores e pontuação (o mais longo primeiro)
+        int token = 0, n = 2;
+        char d = p[1];
+        switch (c) {
+            case '=': if (d == '=') token = OP_EQ;  break;
+            case '!': if (d == '=') token = OP_NEQ; break;
+            case '<': if (d == '=') token = OP_LEQ; else if (d == '<') token = OP_SHL; break;
+            case '>': if (d == '=') token = OP_GEQ; else if (d == '>') token = OP_SHR; break;
+            case '&': if (d == '&') token = OP_AND; break;
+            case '|': if (d == '|') token = OP_OR;  break;
+            case '+': if (d == '+') token = OP_INC; break;
+            case '-': if (d == '-') token = OP_DEC; break;
+        }
+        if (!token) {
+            n = 1;
+            switch (c) {
+                case '+': token = OP_PLUS;    break;
+                case '-': token = OP_MINUS;   break;
+                case '*': token = OP_MUL;     break;
+                case '/': token = OP_DIV;     break;
+                case '=': token = OP_ASSIGN;  break;
+                case '<': token = OP_LT;      break;
+                case '>': token = OP_GT;      break;
+                case '&': token = OP_BIT_AND; break;
+                case '|': token = OP_BIT_OR;  break;
+                case '^': token = OP_BIT_XOR; break;
+                case '~': token = OP_BIT_NOT; break;
+                case '!': token = OP_NOT;     break;
+                case '%': token = OP_MOD;     break;
+                case ';': token = SEMICOLON;  break;
+                case ',': token = COMMA;      break;
+                case '(': token = LPAREN;     break;
+                case ')': token = RPAREN;     break;
+                case '{': token = LBRACE;     break;
+                case '}': token = RBRACE;     break;
+                case '[': token = LBRACKET;   break;
+                case ']': token = RBRACKET;   break;
+            }
+        }
+        if (token) {
+            marcar(n);
+            p += n;
+            return token;
+        }
+        caractere_desconhecido();
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+// --- Scanner escrito à mão (alternativa ao lexer.l) ---
+// scanner.c implementa yylex() com o mesmo contrato do lexer gerado pelo
+// Flex: mesmos códigos de token, yylval.str (strdup do texto) para ID,
+// NUMBER, STRING e CHAR, yylloc/yylineno/yycolumn e marcadores de linha do
+// pré-processador. Espaços, comentários e sequências de identificadores e
+// dígitos são percorridos com SSE2 ou AVX2, escolhidos em tempo de execução;
+// palavras-chave usam uma tabela de hash perfeito.
+//
+// A escolha entre os dois lexers é feita na compilação: lex.yy.c (Flex) ou
+// scanner.c entram no link, nunca os dois.
+
+// Implementação de varredura em uso: "avx2", "sse2" ou "escalar".
+// A variável de ambiente SCANNER_SIMD força uma delas (para testes).
+const char* scanner_implementacao(void);
+
+#endif
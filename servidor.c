@@ -0,0 +1,293 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <arpa/inet.h>
+#include "servidor.h"
+
+#define MAX_WORKERS                 256
+#define MAX_ARGS                    256
+#define MAX_BLOCO                   (64u * 1024 * 1024)
+// Um worker é substituído depois de tantos pedidos, limitando o efeito de
+// vazamentos de memória em caminhos de erro do compilador.
+#define MAX_PEDIDOS_POR_WORKER      10000
+#define TIMEOUT_CONEXAO_SEG         10
+
+static volatile sig_atomic_t encerrar = 0;
+static int fd_log = STDERR_FILENO;   // stderr original (o do worker é capturado)
+
+// ==========================================================
+// Enquadramento
+// ==========================================================
+
+int protocolo_escrever(int fd, const void* dados, size_t n) {
+    const char* p = dados;
+    while (n > 0) {
+        ssize_t k = write(fd, p, n);
+        if (k < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        p += k;
+        n -= (size_t)k;
+    }
+    return 1;
+}
+
+int protocolo_ler(int fd, void* dados, size_t n) {
+    char* p = dados;
+    while (n > 0) {
+        ssize_t k = read(fd, p, n);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return 0;
+        p += k;
+        n -= (size_t)k;
+    }
+    return 1;
+}
+
+int protocolo_escrever_u32(int fd, uint32_t v) {
+    uint32_t rede = htonl(v);
+    return protocolo_escrever(fd, &rede, sizeof(rede));
+}
+
+int protocolo_ler_u32(int fd, uint32_t* v) {
+    uint32_t rede;
+    if (!protocolo_ler(fd, &rede, sizeof(rede))) return 0;
+    *v = ntohl(rede);
+    return 1;
+}
+
+int protocolo_escrever_bloco(int fd, const void* dados, size_t n) {
+    if (n > MAX_BLOCO) return 0;
+    return protocolo_escrever_u32(fd, (uint32_t)n) && protocolo_escrever(fd, dados, n);
+}
+
+char* protocolo_ler_bloco(int fd, size_t* n) {
+    uint32_t tam;
+    if (!protocolo_ler_u32(fd, &tam) || tam > MAX_BLOCO) return NULL;
+    char* dados = malloc((size_t)tam + 1);
+    if (!dados) return NULL;
+    if (!protocolo_ler(fd, dados, tam)) {
+        free(dados);
+        return NULL;
+    }
+    dados[tam] = '\0';
+    if (n) *n = tam;
+    return dados;
+}
+
+// ==========================================================
+// Worker
+// ==========================================================
+
+typedef struct {
+    int    argc;
+    char*  argv[MAX_ARGS + 1];
+    char*  cwd;
+    char*  entrada;      // NULL: o cliente não enviou entrada padrão
+    size_t n_entrada;
+} Pedido;
+
+static void liberar_pedido(Pedido* p) {
+    for (int i = 0; i < p->argc; i++) free(p->argv[i]);
+    free(p->cwd);
+    free(p->entrada);
+    memset(p, 0, sizeof(*p));
+}
+
+static int ler_pedido(int fd, Pedido* p) {
+    char magico[4];
+    uint32_t n_args, tem_entrada;
+
+    memset(p, 0, sizeof(*p));
+    if (!protocolo_ler(fd, magico, sizeof(magico)) || memcmp(magico, SERVIDOR_MAGICO, 4) != 0) return 0;
+    if (!protocolo_ler_u32(fd, &n_args) || n_args == 0 || n_args > MAX_ARGS) return 0;
+    for (uint32_t i = 0; i < n_args; i++) {
+        p->argv[i] = protocolo_ler_bloco(fd, NULL);
+        if (!p->argv[i]) return 0;
+        p->argc++;
+    }
+    p->argv[p->argc] = NULL;
+    if (!(p->cwd = protocolo_ler_bloco(fd, NULL))) return 0;
+    if (!protocolo_ler_u32(fd, &tem_entrada)) return 0;
+    if (tem_entrada && !(p->entrada = protocolo_ler_bloco(fd, &p->n_entrada))) return 0;
+    return 1;
+}
+
+// Esvazia o arquivo que recebe stdout/stderr do compilador
+static void limpar_captura(int fd) {
+    if (ftruncate(fd, 0) != 0 || lseek(fd, 0, SEEK_SET) < 0) {
+        dprintf(fd_log, "Erro (Servidor): falha ao limpar captura: %s\n", strerror(errno));
+    }
+}
+
+// Envia o conteúdo capturado em `fd` como um bloco
+static int enviar_captura(int conexao, int fd) {
+    off_t tam = lseek(fd, 0, SEEK_CUR);
+    if (tam < 0) return 0;
+    char* dados = malloc((size_t)tam + 1);
+    if (!dados) return 0;
+    int ok = pread(fd, dados, (size_t)tam, 0) == tam
+          && protocolo_escrever_bloco(conexao, dados, (size_t)tam);
+    free(dados);
+    return ok;
+}
+
+static void atender(int conexao, FuncaoCompilar compilar) {
+    Pedido p;
+    struct timeval limite = { TIMEOUT_CONEXAO_SEG, 0 };
+
+    setsockopt(conexao, SOL_SOCKET, SO_RCVTIMEO, &limite, sizeof(limite));
+    setsockopt(conexao, SOL_SOCKET, SO_SNDTIMEO, &limite, sizeof(limite));
+    if (!ler_pedido(conexao, &p)) {
+        dprintf(fd_log, "Erro (Servidor): pedido malformado ou incompleto\n");
+        liberar_pedido(&p);
+        return;
+    }
+
+    limpar_captura(STDOUT_FILENO);
+    limpar_captura(STDERR_FILENO);
+
+    int status;
+    if (chdir(p.cwd) != 0) {
+        fprintf(stderr, "Erro: diretório inválido '%s': %s\n", p.cwd, strerror(errno));
+        status = 1;
+    } else {
+        status = compilar(p.argc, p.argv, p.entrada, p.n_entrada);
+    }
+    fflush(stdout);
+    fflush(stderr);
+
+    if (!protocolo_escrever_u32(conexao, (uint32_t)status)
+        || !enviar_captura(conexao, STDOUT_FILENO)
+        || !enviar_captura(conexao, STDERR_FILENO)) {
+        dprintf(fd_log, "Erro (Servidor): falha ao enviar resposta\n");
+    }
+    liberar_pedido(&p);
+}
+
+static void executar_worker(int fd_escuta, FuncaoCompilar compilar) {
+    // stdout e stderr do compilador passam a ir para arquivos temporários,
+    // devolvidos ao cliente ao fim de cada pedido
+    FILE* cap_saida = tmpfile();
+    FILE* cap_erro  = tmpfile();
+    if (!cap_saida || !cap_erro) {
+        dprintf(fd_log, "Erro (Servidor): não foi possível criar arquivos temporários\n");
+        _exit(1);
+    }
+    fflush(stdout);
+    fflush(stderr);
+    fd_log = dup(STDERR_FILENO);
+    if (fd_log < 0) fd_log = STDERR_FILENO;
+    dup2(fileno(cap_saida), STDOUT_FILENO);
+    dup2(fileno(cap_erro), STDERR_FILENO);
+
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+
+    for (int atendidos = 0; atendidos < MAX_PEDIDOS_POR_WORKER; atendidos++) {
+        int conexao = accept(fd_escuta, NULL, NULL);
+        if (conexao < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            dprintf(fd_log, "Erro (Servidor): accept: %s\n", strerror(errno));
+            _exit(1);
+        }
+        atender(conexao, compilar);
+        close(conexao);
+    }
+    _exit(0);
+}
+
+// ==========================================================
+// Processo principal
+// ==========================================================
+
+static void ao_sinal(int sinal) {
+    (void)sinal;
+    encerrar = 1;
+}
+
+static pid_t iniciar_worker(int fd_escuta, FuncaoCompilar compilar) {
+    pid_t pid = fork();
+    if (pid == 0) executar_worker(fd_escuta, compilar);
+    if (pid < 0) fprintf(stderr, "Erro (Servidor): fork: %s\n", strerror(errno));
+    return pid;
+}
+
+int servidor_executar(const char* caminho, int n_workers, FuncaoCompilar compilar) {
+    struct sockaddr_un endereco;
+    pid_t workers[MAX_WORKERS];
+
+    if (n_workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        n_workers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (n_workers > MAX_WORKERS) n_workers = MAX_WORKERS;
+
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        fprintf(stderr, "Erro (Servidor): caminho do socket muito longo: %s\n", caminho);
+        return 1;
+    }
+    int fd_escuta = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd_escuta < 0) {
+        fprintf(stderr, "Erro (Servidor): socket: %s\n", strerror(errno));
+        return 1;
+    }
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+    unlink(caminho);
+    if (bind(fd_escuta, (struct sockaddr*)&endereco, sizeof(endereco)) != 0
+        || listen(fd_escuta, 128) != 0) {
+        fprintf(stderr, "Erro (Servidor): não foi possível escutar em %s: %s\n", caminho, strerror(errno));
+        close(fd_escuta);
+        return 1;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = ao_sinal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);   // cliente que desconecta não derruba o worker
+
+    for (int i = 0; i < n_workers; i++) workers[i] = iniciar_worker(fd_escuta, compilar);
+    fprintf(stderr, "Servidor de compilação em %s (%d workers)\n", caminho, n_workers);
+
+    // Repõe workers que terminarem (limite de pedidos ou falha)
+    while (!encerrar) {
+        int status;
+        pid_t pid = wait(&status);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (int i = 0; i < n_workers; i++) {
+            if (workers[i] == pid) {
+                if (WIFSIGNALED(status)) {
+                    fprintf(stderr, "Aviso (Servidor): worker %d terminou com sinal %d\n",
+                            (int)pid, WTERMSIG(status));
+                }
+                if (!encerrar) workers[i] = iniciar_worker(fd_escuta, compilar);
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < n_workers; i++) {
+        if (workers[i] > 0) kill(workers[i], SIGTERM);
+    }
+    while (wait(NULL) > 0 || errno == EINTR) {}
+    close(fd_escuta);
+    unlink(caminho);
+    return 0;
+}
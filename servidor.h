@@ -0,0 +1,41 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// --- Servidor de compilação ---
+// O compilador pode ficar residente (`./compiler --servir SOCKET`) e atender
+// pedidos de tradução por um socket Unix local. Um conjunto de processos
+// worker (pré-criados com fork) aceita as conexões em paralelo; cada worker
+// reinicia o estado do compilador entre pedidos e mantém o cache de headers
+// do pré-processador. O programa `cliente` repassa argumentos, diretório
+// atual e entrada padrão, e devolve stdout/stderr/status como se fosse o
+// próprio compilador.
+//
+// Protocolo (inteiros de 32 bits em ordem de rede):
+//   pedido:   "CMP1" n_args {arg}... {cwd} tem_entrada [{entrada}]
+//   resposta: status {stdout} {stderr}
+// onde {x} é um bloco: tamanho (u32) seguido dos bytes.
+
+#define SERVIDOR_SOCKET_PADRAO "/tmp/compilador.sock"
+#define SERVIDOR_MAGICO        "CMP1"
+
+// Função que executa uma tradução completa. Quando `entrada` não é NULL,
+// ela substitui a entrada padrão.
+typedef int (*FuncaoCompilar)(int argc, char** argv, const char* entrada, size_t n);
+
+// Cria o socket em `caminho`, inicia `n_workers` processos (0 = número de
+// CPUs) e fica atendendo até receber SIGINT/SIGTERM.
+int servidor_executar(const char* caminho, int n_workers, FuncaoCompilar compilar);
+
+// --- Enquadramento (usado também pelo cliente) ---
+int protocolo_escrever(int fd, const void* dados, size_t n);
+int protocolo_ler(int fd, void* dados, size_t n);
+int protocolo_escrever_u32(int fd, uint32_t v);
+int protocolo_ler_u32(int fd, uint32_t* v);
+int protocolo_escrever_bloco(int fd, const void* dados, size_t n);
+// Lê um bloco alocando memória (terminada em '\0'); retorna NULL em erro
+char* protocolo_ler_bloco(int fd, size_t* n);
+
+#endif
@@ -0,0 +1,889 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include "codegen.h"
+#include "simplificar.h"
+
+// Quádruplas da função (NULL = removida; a lista ligada é refeita no fim)
+typedef struct {
+    Quadrupla** q;
+    int n, cap;
+} Lista;
+
+// Variáveis da função, por nome (endereçamento aberto)
+typedef struct {
+    char*       nome;
+    TipoDadoCG  tipo;           // tipo das escritas (TIPO_NENHUM: nunca escrita)
+    int         nao_negativa;   // nenhuma escrita produz valor negativo
+    int         escritas;       // no laço em análise
+} Variavel;
+
+typedef struct {
+    int         defs, usos;
+    int         pos;            // posição da definição na Lista corrente
+    int         uso;            // posição da última leitura
+    TipoDadoCG  tipo;
+    int         nao_negativo;
+    int         copia;          // `t = origem` pode substituir as leituras de t
+    Endereco    origem;         // (aponta para o arg1 da definição)
+} Temporario;
+
+// Variável de indução de um laço: `var = var + passo` em `pos`
+typedef struct {
+    const char* var;
+    int         passo;
+    int         pos;
+} Inducao;
+
+#define MAX_INDUCOES 8
+
+static Lista lista;
+static Variavel* vars = NULL;
+static size_t cap_vars = 0, n_vars = 0;
+static Temporario* temps = NULL;
+static int cap_temps = 0;
+static int* ativos = NULL;      // temporários com cópia ativa
+static int n_ativos = 0, cap_ativos = 0;
+static int n_alteracoes = 0;
+
+static void* crescer(void* v, size_t tam) {
+    v = realloc(v, tam);
+    if (!v) {
+        fprintf(stderr, "Erro: Falha ao alocar memória para a simplificação\n");
+        exit(EXIT_FAILURE);
+    }
+    return v;
+}
+
+static void anexar(Lista* l, Quadrupla* q) {
+    if (l->n == l->cap) {
+        l->cap = l->cap ? l->cap * 2 : 64;
+        l->q = crescer(l->q, sizeof(Quadrupla*) * l->cap);
+    }
+    l->q[l->n++] = q;
+}
+
+static Quadrupla* nova(OpCodeCG op, Endereco arg1, Endereco arg2, Endereco resultado, const Quadrupla* origem) {
+    Quadrupla* q = malloc(sizeof(Quadrupla));
+    if (!q) crescer(NULL, 0);
+    q->op = op;
+    q->tipo = TIPO_INT;
+    q->arg1 = arg1;
+    q->arg2 = arg2;
+    q->resultado = resultado;
+    q->linha = origem->linha;
+    q->coluna = origem->coluna;
+    q->next = NULL;
+    return q;
+}
+
+static void liberarQuadrupla(Quadrupla* q) {
+    liberarEndereco(&q->arg1);
+    liberarEndereco(&q->arg2);
+    liberarEndereco(&q->resultado);
+    free(q);
+}
+
+// --- Tabelas de variáveis e temporários ---
+
+static uint32_t hashNome(const char* s) {
+    uint32_t h = 2166136261u;   // FNV-1a
+    for (; *s; s++) h = (h ^ (unsigned char)*s) * 16777619u;
+    return h;
+}
+
+static Variavel* buscarVar(const char* nome);
+
+static void crescerVars(void) {
+    Variavel* antigas = vars;
+    size_t cap_antiga = cap_vars;
+    cap_vars = cap_vars ? cap_vars * 2 : 64;
+    vars = calloc(cap_vars, sizeof(Variavel));
+    if (!vars) crescer(NULL, 0);
+    n_vars = 0;
+    for (size_t i = 0; i < cap_antiga; i++) {
+        if (antigas[i].nome) {
+            Variavel* v = buscarVar(antigas[i].nome);
+            free(v->nome);
+            *v = antigas[i];
+        }
+    }
+    free(antigas);
+}
+
+// A variável `nome`, criada na primeira busca
+static Variavel* buscarVar(const char* nome) {
+    if ((n_vars + 1) * 2 > cap_vars) crescerVars();
+    size_t i = hashNome(nome) & (cap_vars - 1);
+    while (vars[i].nome && strcmp(vars[i].nome, nome) != 0) i = (i + 1) & (cap_vars - 1);
+    if (!vars[i].nome) {
+        vars[i].nome = strdup(nome);
+        n_vars++;
+    }
+    return &vars[i];
+}
+
+static void liberarVars(void) {
+    for (size_t i = 0; i < cap_vars; i++) free(vars[i].nome);
+    free(vars);
+    vars = NULL;
+    cap_vars = n_vars = 0;
+}
+
+// Temporários novos (criarEnderecoTemp) cabem a qualquer momento
+static Temporario* temp(int id) {
+    if (id >= cap_temps) {
+        int cap = cap_temps ? cap_temps : 64;
+        while (cap <= id) cap *= 2;
+        temps = crescer(temps, sizeof(Temporario) * cap);
+        memset(temps + cap_temps, 0, sizeof(Temporario) * (cap - cap_temps));
+        cap_temps = cap;
+    }
+    return &temps[id];
+}
+
+// --- Consultas sobre quádruplas e endereços ---
+
+// CALL e FUNC_START guardam nomes em arg1/arg2, não leituras
+static int leOperandos(OpCodeCG op) { return op != CG_CALL && op != CG_FUNC_START; }
+static int escreve(OpCodeCG op)     { return opcodeDeValor(op) || op == CG_CALL; }
+static int simples(OpCodeCG op)     { return opcodeDeValor(op) || op == CG_PARAM || op == CG_CALL; }
+
+static int abre(OpCodeCG op)  { return op == CG_IF_START || op == CG_WHILE_START || op == CG_DO_WHILE_START; }
+static int fecha(OpCodeCG op) { return op == CG_IF_END || op == CG_WHILE_END || op == CG_DO_WHILE_END; }
+static int laco(OpCodeCG op)  { return op == CG_WHILE_START || op == CG_DO_WHILE_START; }
+
+static int mesmo(const Endereco* a, const Endereco* b) {
+    if (a->tipo != b->tipo) return 0;
+    if (a->tipo == ADDR_VAR)  return strcmp(a->val.varName, b->val.varName) == 0;
+    if (a->tipo == ADDR_TEMP) return a->val.tempId == b->val.tempId;
+    return 0;
+}
+
+static int ehVar(const Endereco* e, const char* nome) {
+    return e->tipo == ADDR_VAR && strcmp(e->val.varName, nome) == 0;
+}
+
+static int ehInt(const Endereco* e, int valor) {
+    return e->tipo == ADDR_CONST_INT && e->val.constInt == valor;
+}
+
+// Constante numérica igual a `valor` (inteira ou de ponto flutuante)
+static int ehNumero(const Endereco* e, int valor) {
+    return ehInt(e, valor) || (e->tipo == ADDR_CONST_FLT && e->val.constFlt == (double)valor);
+}
+
+static int le(const Quadrupla* q, const Endereco* e) {
+    return leOperandos(q->op) && (mesmo(&q->arg1, e) || mesmo(&q->arg2, e));
+}
+
+static TipoDadoCG tipoDe(const Endereco* e) {
+    switch (e->tipo) {
+        case ADDR_CONST_INT: return TIPO_INT;
+        case ADDR_CONST_FLT: return TIPO_DOUBLE;
+        case ADDR_VAR:       return buscarVar(e->val.varName)->tipo;
+        case ADDR_TEMP:      return temp(e->val.tempId)->defs == 1 ? temp(e->val.tempId)->tipo : TIPO_NENHUM;
+        default:             return TIPO_NENHUM;
+    }
+}
+
+static int naoNegativo(const Endereco* e) {
+    switch (e->tipo) {
+        case ADDR_CONST_INT: return e->val.constInt >= 0;
+        case ADDR_VAR: {
+            Variavel* v = buscarVar(e->val.varName);
+            return v->tipo == TIPO_INT && v->nao_negativa;
+        }
+        case ADDR_TEMP:      return temp(e->val.tempId)->nao_negativo;
+        default:             return 0;
+    }
+}
+
+// Contagem de definições e leituras de cada temporário e dos tipos das variáveis
+static void contar(void) {
+    liberarVars();
+    if (temps) memset(temps, 0, sizeof(Temporario) * cap_temps);
+    temp(temp_count);
+    for (int k = 0; k < lista.n; k++) {
+        Quadrupla* q = lista.q[k];
+        if (!q) continue;
+        if (leOperandos(q->op)) {
+            if (q->arg1.tipo == ADDR_TEMP) { temp(q->arg1.val.tempId)->usos++; temp(q->arg1.val.tempId)->uso = k; }
+            if (q->arg2.tipo == ADDR_TEMP) { temp(q->arg2.val.tempId)->usos++; temp(q->arg2.val.tempId)->uso = k; }
+        }
+        if (!escreve(q->op)) continue;
+        if (q->resultado.tipo == ADDR_TEMP) {
+            Temporario* t = temp(q->resultado.val.tempId);
+            t->defs++;
+            t->pos = k;
+            t->tipo = q->tipo;
+        } else if (q->resultado.tipo == ADDR_VAR) {
+            Variavel* v = buscarVar(q->resultado.val.varName);
+            if (v->tipo == TIPO_NENHUM) v->tipo = q->tipo;
+        }
+    }
+}
+
+// --- Análise de sinais ---
+// Maior ponto fixo: toda variável int começa não negativa e deixa de ser
+// quando alguma escrita pode produzir um valor negativo. O Python gerado não
+// tem estouro, então soma e produto de não negativos continuam não negativos.
+
+static int valorNaoNegativo(const Quadrupla* q) {
+    if (q->tipo != TIPO_INT) return 0;
+    switch (q->op) {
+        case CG_ASSIGN:
+            return naoNegativo(&q->arg1);
+        case CG_ADD: case CG_MUL: case CG_IDIV: case CG_BIT_OR: case CG_BIT_XOR:
+            return naoNegativo(&q->arg1) && naoNegativo(&q->arg2);
+        case CG_MOD: case CG_SHL: case CG_SHR:
+            return naoNegativo(&q->arg1);
+        case CG_BIT_AND:
+            return naoNegativo(&q->arg1) || naoNegativo(&q->arg2);
+        case CG_LT: case CG_GT: case CG_LTE: case CG_GTE: case CG_EQ: case CG_NEQ:
+        case CG_NOT: case CG_AND: case CG_OR:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static void analisarSinais(void) {
+    for (size_t i = 0; i < cap_vars; i++) {
+        if (vars[i].nome) vars[i].nao_negativa = vars[i].tipo == TIPO_INT;
+    }
+    // Temporários escritos mais de uma vez (acumuladores) entram como variáveis
+    for (int i = 0; i < cap_temps; i++) temps[i].nao_negativo = temps[i].defs > 1 && temps[i].tipo == TIPO_INT;
+    int mudou = 1;
+    while (mudou) {
+        mudou = 0;
+        for (int k = 0; k < lista.n; k++) {
+            Quadrupla* q = lista.q[k];
+            if (!q || !escreve(q->op)) continue;
+            int nn = q->op != CG_CALL && valorNaoNegativo(q);
+            if (q->resultado.tipo == ADDR_TEMP) {
+                Temporario* t = temp(q->resultado.val.tempId);
+                if (t->defs == 1) {
+                    t->nao_negativo = nn;
+                } else if (t->nao_negativo && !nn) {
+                    t->nao_negativo = 0;
+                    mudou = 1;
+                }
+            } else if (q->resultado.tipo == ADDR_VAR && !nn) {
+                Variavel* v = buscarVar(q->resultado.val.varName);
+                if (v->nao_negativa) {
+                    v->nao_negativa = 0;
+                    mudou = 1;
+                }
+            }
+        }
+    }
+}
+
+// --- Redução de força das variáveis de indução ---
+
+// Índice do fechamento da estrutura aberta em lista.q[i]
+static int fimDaEstrutura(int i) {
+    int nivel = 0;
+    for (; i < lista.n; i++) {
+        Quadrupla* q = lista.q[i];
+        if (!q) continue;
+        if (abre(q->op)) nivel++;
+        else if (fecha(q->op) && --nivel == 0) return i;
+    }
+    return lista.n - 1;
+}
+
+// `var ± c` com int, em que var é ehVar(nome)
+static int passoDe(const Quadrupla* q, const char* var, int* passo) {
+    if (q->tipo != TIPO_INT) return 0;
+    if (q->op == CG_ADD && ehVar(&q->arg1, var) && q->arg2.tipo == ADDR_CONST_INT) {
+        *passo = q->arg2.val.constInt;
+    } else if (q->op == CG_ADD && ehVar(&q->arg2, var) && q->arg1.tipo == ADDR_CONST_INT) {
+        *passo = q->arg1.val.constInt;
+    } else if (q->op == CG_SUB && ehVar(&q->arg1, var) && q->arg2.tipo == ADDR_CONST_INT &&
+               q->arg2.val.constInt != INT_MIN) {
+        *passo = -q->arg2.val.constInt;
+    } else {
+        return 0;
+    }
+    return *passo != 0;
+}
+
+// Variáveis de indução do laço com corpo em [ini, fim): escritas uma única
+// vez, no nível de fora, por `var = t` com `t = var ± c`
+static int acharInducoes(int ini, int fim, Inducao* ivs) {
+    int n = 0, nivel = 0;
+    for (int k = ini; k < fim; k++) {
+        Quadrupla* q = lista.q[k];
+        if (q && escreve(q->op) && q->resultado.tipo == ADDR_VAR) buscarVar(q->resultado.val.varName)->escritas = 0;
+    }
+    for (int k = ini; k < fim; k++) {
+        Quadrupla* q = lista.q[k];
+        if (q && escreve(q->op) && q->resultado.tipo == ADDR_VAR) buscarVar(q->resultado.val.varName)->escritas++;
+    }
+    for (int k = ini; k < fim && n < MAX_INDUCOES; k++) {
+        Quadrupla* q = lista.q[k];
+        if (!q) continue;
+        if (abre(q->op)) nivel++;
+        else if (fecha(q->op)) nivel--;
+        if (nivel != 0 || q->op != CG_ASSIGN || q->tipo != TIPO_INT ||
+            q->resultado.tipo != ADDR_VAR || q->arg1.tipo != ADDR_TEMP) continue;
+        const char* var = q->resultado.val.varName;
+        Temporario* t = temp(q->arg1.val.tempId);
+        if (buscarVar(var)->escritas != 1 || t->defs != 1 || t->usos != 1 || t->pos < ini || t->pos > k) continue;
+        if (!passoDe(lista.q[t->pos], var, &ivs[n].passo)) continue;
+        ivs[n].var = var;
+        ivs[n].pos = k;
+        n++;
+    }
+    return n;
+}
+
+// Quádruplas a inserir antes/depois de cada posição, encadeadas por next
+static Quadrupla** antes = NULL;
+static Quadrupla** depois = NULL;
+
+static void inserir(Quadrupla** fila, int k, Quadrupla* q) {
+    Quadrupla** p = &fila[k];
+    while (*p) p = &(*p)->next;
+    *p = q;
+}
+
+// Tenta reduzir a cadeia que começa no MUL em lista.q[k], no laço que começa
+// em `inicio`; `nivel`/`nivel_laco` são as estruturas/laços que envolvem o MUL
+static void reduzirCadeia(int inicio, int fim, int k, const Inducao* iv, int nivel, int nivel_laco) {
+    Quadrupla* mul = lista.q[k];
+    const Endereco* fator = ehVar(&mul->arg1, iv->var) ? &mul->arg2 : &mul->arg1;
+    long long a = fator->val.constInt, b = 0;
+    int comprimento = 1, ultimo = k;
+
+    // Segue o temporário enquanto ele só alimenta `± constante`
+    for (;;) {
+        Temporario* t = temp(lista.q[ultimo]->resultado.val.tempId);
+        if (t->usos != 1 || t->uso <= ultimo || t->uso >= fim) break;
+        Quadrupla* u = lista.q[t->uso];
+        const Endereco* resultado = &lista.q[ultimo]->resultado;
+        if (!u || u->tipo != TIPO_INT || u->resultado.tipo != ADDR_TEMP ||
+            temp(u->resultado.val.tempId)->defs != 1) break;
+        long long c;
+        if (u->op == CG_ADD && mesmo(&u->arg1, resultado) && u->arg2.tipo == ADDR_CONST_INT) c = u->arg2.val.constInt;
+        else if (u->op == CG_ADD && mesmo(&u->arg2, resultado) && u->arg1.tipo == ADDR_CONST_INT) c = u->arg1.val.constInt;
+        else if (u->op == CG_SUB && mesmo(&u->arg1, resultado) && u->arg2.tipo == ADDR_CONST_INT) c = -(long long)u->arg2.val.constInt;
+        else break;
+        if (b + c < INT_MIN || b + c > INT_MAX) break;
+        b += c;
+        comprimento++;
+        ultimo = t->uso;
+    }
+
+    // Em Python trocar um MUL por uma cópia e uma soma não ganha nada
+    int lucro = (nivel == 0 && comprimento >= 2) || (nivel_laco > 0 && nivel == nivel_laco);
+    long long incremento = a * iv->passo;
+    if (!lucro || incremento < INT_MIN || incremento > INT_MAX) return;
+
+    Endereco s = criarEnderecoTemp();
+    inserir(antes, inicio, nova(CG_MUL, criarEnderecoVar(iv->var), criarEnderecoConstInt((int)a), s, mul));
+    if (b != 0) inserir(antes, inicio, nova(CG_ADD, s, criarEnderecoConstInt((int)b), s, mul));
+    inserir(depois, iv->pos, nova(CG_ADD, s, criarEnderecoConstInt((int)incremento), s, mul));
+
+    // A cadeia some; o último elemento vira `t = s`
+    for (int p = k; p != ultimo; ) {
+        int proximo = temp(lista.q[p]->resultado.val.tempId)->uso;
+        liberarQuadrupla(lista.q[p]);
+        lista.q[p] = NULL;
+        p = proximo;
+    }
+    Quadrupla* final = lista.q[ultimo];
+    liberarEndereco(&final->arg1);
+    liberarEndereco(&final->arg2);
+    final->op = CG_ASSIGN;
+    final->arg1 = s;
+    final->arg2 = criarEnderecoVazio();
+    n_alteracoes++;
+}
+
+static void reduzirInducao(void) {
+    antes = calloc(lista.n + 1, sizeof(Quadrupla*));
+    depois = calloc(lista.n + 1, sizeof(Quadrupla*));
+    if (!antes || !depois) crescer(NULL, 0);
+
+    int houve = 0;
+    for (int i = 0; i < lista.n; i++) {
+        if (!lista.q[i] || !laco(lista.q[i]->op)) continue;
+        int fim = fimDaEstrutura(i);
+        Inducao ivs[MAX_INDUCOES];
+        int n_ivs = acharInducoes(i + 2, fim, ivs);
+        if (n_ivs == 0) continue;
+
+        int nivel = 0, nivel_laco = 0;
+        for (int k = i + 2; k < fim; k++) {
+            Quadrupla* q = lista.q[k];
+            if (!q) continue;
+            if (abre(q->op)) { nivel++; nivel_laco += laco(q->op); continue; }
+            if (fecha(q->op)) { nivel--; nivel_laco -= q->op != CG_IF_END; continue; }
+            if (q->op != CG_MUL || q->tipo != TIPO_INT || q->resultado.tipo != ADDR_TEMP ||
+                temp(q->resultado.val.tempId)->defs != 1) continue;
+            for (int v = 0; v < n_ivs; v++) {
+                int lado = ehVar(&q->arg1, ivs[v].var) ? 2 : ehVar(&q->arg2, ivs[v].var) ? 1 : 0;
+                const Endereco* c = lado == 2 ? &q->arg2 : &q->arg1;
+                if (lado == 0 || c->tipo != ADDR_CONST_INT || c->val.constInt == 0 || c->val.constInt == 1) continue;
+                reduzirCadeia(i, fim, k, &ivs[v], nivel, nivel_laco);
+                houve = 1;
+                break;
+            }
+        }
+    }
+
+    if (houve) {
+        Lista nova_lista = { NULL, 0, 0 };
+        for (int k = 0; k < lista.n; k++) {
+            for (Quadrupla* q = antes[k]; q; ) { Quadrupla* p = q->next; q->next = NULL; anexar(&nova_lista, q); q = p; }
+            if (lista.q[k]) anexar(&nova_lista, lista.q[k]);
+            for (Quadrupla* q = depois[k]; q; ) { Quadrupla* p = q->next; q->next = NULL; anexar(&nova_lista, q); q = p; }
+        }
+        free(lista.q);
+        lista = nova_lista;
+    }
+    free(antes);
+    free(depois);
+    antes = depois = NULL;
+}
+
+// --- Reescrita para frente: cópias, constantes, identidades e potências de dois ---
+
+static Lista saida;
+
+static void descontarLeituras(const Quadrupla* q) {
+    if (!leOperandos(q->op)) return;
+    if (q->arg1.tipo == ADDR_TEMP) temp(q->arg1.val.tempId)->usos--;
+    if (q->arg2.tipo == ADDR_TEMP) temp(q->arg2.val.tempId)->usos--;
+}
+
+static void contarLeituras(const Quadrupla* q) {
+    if (!leOperandos(q->op)) return;
+    if (q->arg1.tipo == ADDR_TEMP) temp(q->arg1.val.tempId)->usos++;
+    if (q->arg2.tipo == ADDR_TEMP) temp(q->arg2.val.tempId)->usos++;
+}
+
+static void desativarCopia(int id) {
+    temp(id)->copia = 0;
+    for (int i = 0; i < n_ativos; i++) {
+        if (ativos[i] == id) {
+            ativos[i] = ativos[--n_ativos];
+            return;
+        }
+    }
+}
+
+static void limparCopias(void) {
+    for (int i = 0; i < n_ativos; i++) temp(ativos[i])->copia = 0;
+    n_ativos = 0;
+}
+
+// Uma escrita em `e` invalida as cópias que vêm dele
+static void invalidar(const Endereco* e) {
+    for (int i = 0; i < n_ativos; ) {
+        Temporario* t = temp(ativos[i]);
+        if (mesmo(&t->origem, e)) {
+            t->copia = 0;
+            ativos[i] = ativos[--n_ativos];
+        } else {
+            i++;
+        }
+    }
+}
+
+// Apaga a definição de um temporário que ficou sem leituras
+static void removerSeMorto(int id) {
+    Temporario* t = temp(id);
+    if (t->usos != 0 || t->defs != 1 || t->pos < 0 || t->pos >= saida.n) return;
+    Quadrupla* d = saida.q[t->pos];
+    if (!d || !opcodeDeValor(d->op) || d->resultado.tipo != ADDR_TEMP || d->resultado.val.tempId != id) return;
+    if (t->copia) desativarCopia(id);
+    saida.q[t->pos] = NULL;
+    descontarLeituras(d);
+    int a = d->arg1.tipo == ADDR_TEMP ? d->arg1.val.tempId : -1;
+    int b = d->arg2.tipo == ADDR_TEMP ? d->arg2.val.tempId : -1;
+    liberarQuadrupla(d);
+    if (a >= 0) removerSeMorto(a);
+    if (b >= 0 && b != a) removerSeMorto(b);
+}
+
+static void substituir(Endereco* e) {
+    if (e->tipo != ADDR_TEMP || !temp(e->val.tempId)->copia) return;
+    int id = e->val.tempId;
+    *e = duplicarEndereco(temp(id)->origem);
+    if (e->tipo == ADDR_TEMP) temp(e->val.tempId)->usos++;
+    temp(id)->usos--;
+    removerSeMorto(id);
+}
+
+// Novas quádruplas antes da corrente
+static void emitirAntes(Quadrupla* q) {
+    anexar(&saida, q);
+    contarLeituras(q);
+    Temporario* t = temp(q->resultado.val.tempId);
+    t->defs = 1;
+    t->pos = saida.n - 1;
+    t->tipo = q->tipo;
+}
+
+// q passa a ser `resultado = valor` (valor já pertence a q)
+static void virarCopia(Quadrupla* q, Endereco valor) {
+    descontarLeituras(q);
+    int a = q->arg1.tipo == ADDR_TEMP ? q->arg1.val.tempId : -1;
+    int b = q->arg2.tipo == ADDR_TEMP ? q->arg2.val.tempId : -1;
+    liberarEndereco(&q->arg1);
+    liberarEndereco(&q->arg2);
+    q->op = CG_ASSIGN;
+    q->arg1 = valor;
+    q->arg2 = criarEnderecoVazio();
+    contarLeituras(q);
+    if (a >= 0) removerSeMorto(a);
+    if (b >= 0 && b != a) removerSeMorto(b);
+}
+
+static void virarUnario(Quadrupla* q, OpCodeCG op, Endereco valor) {
+    virarCopia(q, valor);
+    q->op = op;
+}
+
+// Conversões de constantes: o ajuste de largura ou o arredondamento para float
+static int dobrarConversao(Quadrupla* q) {
+    if (q->op == CG_CONVERT && q->arg1.tipo == ADDR_CONST_INT) {
+        long long v;
+        if (tipoFlutuante(q->tipo)) {
+            virarCopia(q, criarEnderecoConstFlt((double)q->arg1.val.constInt));
+            return 1;
+        }
+        if (!ajustarInteiro(q->arg1.val.constInt, q->tipo, &v)) return 0;
+        virarCopia(q, criarEnderecoConstInt(v));
+        return 1;
+    }
+    if (q->op == CG_F32 && q->arg1.tipo == ADDR_CONST_FLT) {
+        virarCopia(q, criarEnderecoConstFlt((double)(float)q->arg1.val.constFlt));
+        return 1;
+    }
+    return 0;
+}
+
+// Operações entre constantes inteiras, com a aritmética sem limite do Python:
+// só dobra o que cabe em 64 bits (e em int, quando o tipo é int ou menor)
+static int dobrar(Quadrupla* q) {
+    long long a, b = 0, r;
+    int unario = q->op == CG_UMINUS || q->op == CG_BIT_NOT || q->op == CG_NOT;
+    if (q->op == CG_CONVERT || q->op == CG_F32) return dobrarConversao(q);
+    if (q->op == CG_ASSIGN || q->arg1.tipo != ADDR_CONST_INT) return 0;
+    if (!unario && q->arg2.tipo != ADDR_CONST_INT) return 0;
+    a = q->arg1.val.constInt;
+    if (!unario) b = q->arg2.val.constInt;
+
+    switch (q->op) {
+        case CG_ADD: if (__builtin_add_overflow(a, b, &r)) return 0; break;
+        case CG_SUB: if (__builtin_sub_overflow(a, b, &r)) return 0; break;
+        case CG_MUL: if (__builtin_mul_overflow(a, b, &r)) return 0; break;
+        case CG_IDIV:
+        case CG_MOD:
+            // Operandos sem sinal são não negativos: truncar e arredondar
+            // para baixo coincidem
+            if (b == 0 || (a == LLONG_MIN && b == -1)) return 0;
+            r = q->op == CG_IDIV ? a / b : a % b;
+            break;
+        case CG_SHL:
+            if (b < 0 || b > 62 || __builtin_mul_overflow(a, 1LL << b, &r)) return 0;
+            break;
+        case CG_SHR:
+            if (b < 0 || b > 63) return 0;
+            r = a >> b;
+            break;
+        case CG_BIT_AND: r = a & b; break;
+        case CG_BIT_OR:  r = a | b; break;
+        case CG_BIT_XOR: r = a ^ b; break;
+        case CG_LT:      r = a < b; break;
+        case CG_GT:      r = a > b; break;
+        case CG_LTE:     r = a <= b; break;
+        case CG_GTE:     r = a >= b; break;
+        case CG_EQ:      r = a == b; break;
+        case CG_NEQ:     r = a != b; break;
+        case CG_AND:     r = a && b; break;
+        case CG_OR:      r = a || b; break;
+        case CG_UMINUS:  if (a == LLONG_MIN) return 0; r = -a; break;
+        case CG_BIT_NOT: r = ~a; break;
+        case CG_NOT:     r = !a; break;
+        default:         return 0;
+    }
+    if (bitsTipo(q->tipo) <= 32 && !tipoSemSinal(q->tipo) && (r < INT_MIN || r > INT_MAX)) return 0;
+    virarCopia(q, criarEnderecoConstInt(r));
+    return 1;
+}
+
+static int identidade(Quadrupla* q) {
+    const Endereco *x = &q->arg1, *y = &q->arg2;
+
+    if (tipoFlutuante(q->tipo)) {
+        // Só as exatas: x+0 muda o sinal de -0.0
+        if ((q->op == CG_MUL && ehNumero(y, 1)) || (q->op == CG_DIV && ehNumero(y, 1)) ||
+            (q->op == CG_SUB && ehNumero(y, 0))) {
+            if (!tipoFlutuante(tipoDe(x))) return 0;
+        } else if (q->op == CG_MUL && ehNumero(x, 1)) {
+            if (!tipoFlutuante(tipoDe(y))) return 0;
+            x = y;
+        } else {
+            return 0;
+        }
+        virarCopia(q, duplicarEndereco(*x));
+        return 1;
+    }
+    if (q->tipo != TIPO_INT) return 0;
+
+    // Comparações de um valor int consigo mesmo
+    if (q->op >= CG_LT && q->op <= CG_NEQ) {
+        if (!mesmo(x, y) || tipoDe(x) != TIPO_INT) return 0;
+        virarCopia(q, criarEnderecoConstInt(q->op == CG_LTE || q->op == CG_GTE || q->op == CG_EQ));
+        return 1;
+    }
+
+    // Operações comutativas: constante à direita
+    if ((q->op == CG_ADD || q->op == CG_MUL || q->op == CG_BIT_AND || q->op == CG_BIT_OR ||
+         q->op == CG_BIT_XOR) && x->tipo == ADDR_CONST_INT) {
+        const Endereco* t = x; x = y; y = t;
+    }
+
+    const Endereco* valor = NULL;   // o resultado é x
+    int constante = 0, eh_constante = 0;
+    switch (q->op) {
+        case CG_ADD:
+        case CG_BIT_OR:
+        case CG_BIT_XOR:
+            if (ehInt(y, 0)) valor = x;
+            else if (q->op == CG_BIT_OR && ehInt(y, -1)) eh_constante = 1, constante = -1;
+            else if (q->op == CG_BIT_OR && mesmo(x, y)) valor = x;
+            else if (q->op == CG_BIT_XOR && mesmo(x, y)) eh_constante = 1;
+            break;
+        case CG_SUB:
+            if (ehInt(y, 0)) valor = x;
+            else if (mesmo(x, y)) eh_constante = 1;
+            else if (ehInt(x, 0)) { virarUnario(q, CG_UMINUS, duplicarEndereco(*y)); return 1; }
+            break;
+        case CG_MUL:
+            if (ehInt(y, 1)) valor = x;
+            else if (ehInt(y, 0)) eh_constante = 1;
+            else if (ehInt(y, -1)) { virarUnario(q, CG_UMINUS, duplicarEndereco(*x)); return 1; }
+            break;
+        case CG_IDIV:
+            if (ehInt(y, 1)) valor = x;
+            else if (ehInt(y, -1)) { virarUnario(q, CG_UMINUS, duplicarEndereco(*x)); return 1; }
+            break;
+        case CG_MOD:
+            if (ehInt(y, 1) || ehInt(y, -1)) eh_constante = 1;
+            break;
+        case CG_BIT_AND:
+            if (ehInt(y, 0)) eh_constante = 1;
+            else if (ehInt(y, -1) || mesmo(x, y)) valor = x;
+            break;
+        case CG_SHL:
+        case CG_SHR:
+            if (ehInt(y, 0)) valor = x;
+            else if (ehInt(x, 0)) eh_constante = 1;
+            break;
+        case CG_AND:
+        case CG_OR:
+            // Aqui os dois lados já foram avaliados: quando o da direita pode
+            // falhar ou ter efeito, o gerador usa um if em vez de AND/OR
+            // (gerarCurtoCircuito)
+            if (y->tipo != ADDR_CONST_INT) { const Endereco* t = x; x = y; y = t; }
+            if (q->op == CG_AND && ehInt(y, 0)) eh_constante = 1;
+            else if (q->op == CG_OR && y->tipo == ADDR_CONST_INT && y->val.constInt != 0) eh_constante = 1, constante = 1;
+            break;
+        default:
+            break;
+    }
+    if (valor) virarCopia(q, duplicarEndereco(*valor));
+    else if (eh_constante) virarCopia(q, criarEnderecoConstInt(constante));
+    else return 0;
+    return 1;
+}
+
+static int log2Exato(int c) {
+    if (c < 2 || (c & (c - 1)) != 0) return -1;
+    int k = 0;
+    while ((1 << k) != c) k++;
+    return k;
+}
+
+// x / 2^k e x % 2^k sem divisão. Para x negativo o C arredonda para zero e o
+// deslocamento para baixo; somar m = 2^k - 1 antes (só quando x < 0) corrige:
+//   s = (x >> 31) & m        x / 2^k = (x + s) >> k       x % 2^k = ((x + s) & m) - s
+static int potenciaDeDois(Quadrupla* q) {
+    if (q->tipo != TIPO_INT || (q->op != CG_IDIV && q->op != CG_MOD) || q->arg2.tipo != ADDR_CONST_INT) return 0;
+    int k = log2Exato(q->arg2.val.constInt);
+    if (k < 0 || q->arg1.tipo == ADDR_CONST_INT) return 0;
+    int m = q->arg2.val.constInt - 1;
+    int divisao = q->op == CG_IDIV;
+
+    if (naoNegativo(&q->arg1)) {
+        q->op = divisao ? CG_SHR : CG_BIT_AND;
+        q->arg2.val.constInt = divisao ? k : m;
+        return 1;
+    }
+
+    Endereco x = q->arg1;
+    Endereco sinal = criarEnderecoTemp(), s = criarEnderecoTemp(), soma = criarEnderecoTemp();
+    emitirAntes(nova(CG_SHR, duplicarEndereco(x), criarEnderecoConstInt(31), sinal, q));
+    emitirAntes(nova(CG_BIT_AND, sinal, criarEnderecoConstInt(m), s, q));
+    emitirAntes(nova(CG_ADD, duplicarEndereco(x), s, soma, q));
+    if (divisao) {
+        virarCopia(q, soma);
+        q->op = CG_SHR;
+        q->arg2 = criarEnderecoConstInt(k);
+    } else {
+        Endereco resto = criarEnderecoTemp();
+        emitirAntes(nova(CG_BIT_AND, soma, criarEnderecoConstInt(m), resto, q));
+        virarCopia(q, resto);
+        q->op = CG_SUB;
+        q->arg2 = s;
+        temp(s.val.tempId)->usos++;
+    }
+    return 1;
+}
+
+static void propagar(void) {
+    saida.q = NULL;
+    saida.n = saida.cap = 0;
+    n_ativos = 0;
+
+    for (int k = 0; k < lista.n; k++) {
+        Quadrupla* q = lista.q[k];
+        if (!q) continue;
+        if (leOperandos(q->op)) {
+            substituir(&q->arg1);
+            substituir(&q->arg2);
+        }
+        if (!simples(q->op) && q->op != CG_RETURN && q->op != CG_BREAK_IF_FALSE && q->op != CG_IF_START) {
+            limparCopias();
+        }
+
+        if (opcodeDeValor(q->op) && (dobrar(q) || identidade(q) || potenciaDeDois(q))) n_alteracoes++;
+
+        // x = x
+        if (q->op == CG_ASSIGN && mesmo(&q->arg1, &q->resultado)) {
+            descontarLeituras(q);
+            liberarQuadrupla(q);
+            n_alteracoes++;
+            continue;
+        }
+
+        if (escreve(q->op)) invalidar(&q->resultado);
+        anexar(&saida, q);
+        if (!escreve(q->op) || q->resultado.tipo != ADDR_TEMP) continue;
+
+        int id = q->resultado.val.tempId;
+        Temporario* t = temp(id);
+        t->pos = saida.n - 1;
+        if (q->op == CG_ASSIGN && t->defs == 1 && q->arg1.tipo != ADDR_CONST_STR && q->arg1.tipo != ADDR_EMPTY) {
+            if (n_ativos == cap_ativos) {
+                cap_ativos = cap_ativos ? cap_ativos * 2 : 32;
+                ativos = crescer(ativos, sizeof(int) * cap_ativos);
+            }
+            t->copia = 1;
+            t->origem = q->arg1;
+            ativos[n_ativos++] = id;
+        }
+    }
+    limparCopias();
+    free(lista.q);
+    lista = saida;
+}
+
+// --- `t = expr; x = t` vira `x = expr` ---
+
+static void coalescer(void) {
+    for (int k = 0; k < lista.n; k++) {
+        Quadrupla* a = lista.q[k];
+        if (!a || a->op != CG_ASSIGN || a->resultado.tipo != ADDR_VAR || a->arg1.tipo != ADDR_TEMP) continue;
+        Temporario* t = temp(a->arg1.val.tempId);
+        if (t->defs != 1 || t->usos != 1 || t->pos >= k) continue;
+        Quadrupla* d = lista.q[t->pos];
+        if (!d || !opcodeDeValor(d->op) || d->tipo != a->tipo) continue;
+
+        // Entre as duas, nada pode ler nem escrever x
+        int livre = 1;
+        for (int p = t->pos + 1; p < k && livre; p++) {
+            Quadrupla* q = lista.q[p];
+            if (q && (!simples(q->op) || le(q, &a->resultado) ||
+                      (escreve(q->op) && mesmo(&q->resultado, &a->resultado)))) livre = 0;
+        }
+        if (!livre) continue;
+
+        d->resultado = a->resultado;
+        a->resultado = criarEnderecoVazio();
+        liberarQuadrupla(a);
+        lista.q[k] = NULL;
+        n_alteracoes++;
+        if (d->op == CG_ASSIGN && mesmo(&d->arg1, &d->resultado)) {
+            liberarQuadrupla(d);
+            lista.q[t->pos] = NULL;
+        }
+    }
+}
+
+// --- Divisão de não negativos ---
+// Com os dois operandos não negativos, truncar e arredondar para baixo
+// coincidem: a divisão de int é marcada como unsigned int e os backends usam
+// // e % direto em vez de int(a / b). Vem depois de coalescer(), que só junta
+// quádruplas do mesmo tipo.
+
+static void dividirNaoNegativos(void) {
+    for (int k = 0; k < lista.n; k++) {
+        Quadrupla* q = lista.q[k];
+        if (!q || q->tipo != TIPO_INT || (q->op != CG_IDIV && q->op != CG_MOD)) continue;
+        if (!naoNegativo(&q->arg1) || !naoNegativo(&q->arg2)) continue;
+        q->tipo = TIPO_UINT;
+        n_alteracoes++;
+    }
+}
+
+int simplificarCodigo(void) {
+    lista.q = NULL;
+    lista.n = lista.cap = 0;
+    for (Quadrupla* q = code_head; q; q = q->next) anexar(&lista, q);
+    n_alteracoes = 0;
+
+    contar();
+    reduzirInducao();
+    contar();
+    analisarSinais();
+    propagar();
+    contar();
+    coalescer();
+    contar();
+    analisarSinais();
+    dividirNaoNegativos();
+
+    // Refaz a lista ligada sem as removidas
+    Quadrupla* anterior = NULL;
+    code_head = NULL;
+    for (int k = 0; k < lista.n; k++) {
+        Quadrupla* q = lista.q[k];
+        if (!q) continue;
+        if (anterior) anterior->next = q;
+        else code_head = q;
+        anterior = q;
+    }
+    if (anterior) anterior->next = NULL;
+    code_tail = anterior;
+
+    free(lista.q);
+    lista.q = NULL;
+    liberarVars();
+    free(temps);
+    temps = NULL;
+    cap_temps = 0;
+    free(ativos);
+    ativos = NULL;
+    cap_ativos = n_ativos = 0;
+    return n_alteracoes;
+}
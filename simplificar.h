@@ -0,0 +1,27 @@
+#ifndef SIMPLIFICAR_H
+#define SIMPLIFICAR_H
+
+// --- Simplificação algébrica e redução de força ---
+// Passo sobre as quádruplas da função corrente (code_head), aplicado logo
+// depois de gerarCodigo(), antes do desenrolamento de laços. Tudo respeita a
+// semântica do C para int (divisão truncada, resto com o sinal do dividendo,
+// deslocamento aritmético); estouros e divisões por zero não são dobrados.
+//
+//  - Redução de força de indução: em um laço cuja variável `i` só muda por
+//    `i = i ± d` no nível de fora, uma cadeia `i * c + b` vira um acumulador
+//    iniciado antes do laço e somado de `c*d` logo após o incremento. Só é
+//    feita quando poupa trabalho no Python gerado: a cadeia tem mais de uma
+//    operação ou está dentro de um laço interno (onde sai do laço).
+//  - Dobramento de constantes e identidades (x+0, x*1, x*0, x&0, x^x, x-x,
+//    x<<0...). Para float, só as exatas: x*1, x/1 e x-0.
+//  - Divisão e resto por potência de dois: `x >> k` e `x & m` quando `x`
+//    nunca é negativo (análise de sinais sobre as variáveis da função); senão
+//    as sequências sem divisão que corrigem o arredondamento para zero.
+//    Multiplicações continuam multiplicações: no CPython `x * 8` custa menos
+//    que `x << 3`.
+//  - Propagação de cópias e `t = expr; x = t` reescrito como `x = expr`.
+
+// Retorna o número de quádruplas reescritas, removidas ou reduzidas.
+int simplificarCodigo(void);
+
+#endif
@@ -0,0 +1,8 @@
+int main() {
+    int x;
+    x = 1;
+    if (x) {
+        break; // Erro: 'break' fora de um laço
+    }
+    return 0;
+}
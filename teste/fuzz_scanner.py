@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+"""
+Fuzz de equivalência entre os lexers.
+
+Gera entradas aleatórias (tokens válidos, espaços, comentários, strings e
+caracteres com escapes, números, marcadores de linha, bytes inválidos e
+sequências longas que atravessam vários blocos SIMD) e confere que o lexer
+do Flex e o scanner vetorizado produzem exatamente os mesmos tokens,
+posições e mensagens de erro. O scanner é testado com cada implementação
+de varredura (escalar, sse2, avx2).
+
+Uso (depois de compilar os dois programas, veja benchmarks/bench_scanner.c):
+    python3 teste/fuzz_scanner.py [--casos N] [--semente S] \\
+        [--referencia "./bench_flex --tokens"] [--candidato "./bench_simd --tokens"]
+"""
+
+import argparse
+import os
+import random
+import shlex
+import subprocess
+import sys
+import tempfile
+
+PALAVRAS = ("break case char const continue default do double else enum float for if "
+            "int long return short signed sizeof static switch unsigned void while").split()
+OPERADORES = ["==", "!=", "<=", ">=", "&&", "||", "++", "--", "+", "-", "*", "/", "=",
+              "<", ">", "&", "|", "^", "~", "!", "%", ";", ",", "(", ")", "{", "}", "[", "]"]
+IMPLEMENTACOES = ["escalar", "sse2", "avx2"]
+
+
+def identificador(r):
+    if r.random() < 0.3:
+        base = r.choice(PALAVRAS)
+        # Prefixos/sufixos de palavras-chave precisam virar ID
+        return r.choice([base, base + r.choice("_a1"), base[:-1], "_" + base])
+    n = r.choice([1, 2, 5, 12, 31, 32, 33, 70])
+    primeiro = r.choice("abcxyzABCXYZ_")
+    resto = "".join(r.choice("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_")
+                    for _ in range(n - 1))
+    return primeiro + resto
+
+
+def numero(r):
+    n = "".join(r.choice("0123456789") for _ in range(r.choice([1, 3, 17, 40])))
+    if r.random() < 0.3:
+        n += "." + "".join(r.choice("0123456789") for _ in range(r.randint(0, 4)))
+    if r.random() < 0.2:
+        n += r.choice("eE") + r.choice(["", "+", "-"]) + "".join(
+            r.choice("0123456789") for _ in range(r.randint(0, 3)))
+    return n
+
+
+def texto_livre(r, n):
+    return "".join(r.choice("ab *\"'/\\\n\t%#x") for _ in range(n))
+
+
+def string(r):
+    partes = []
+    for _ in range(r.randint(0, 12)):
+        partes.append(r.choice(["a", " ", "\\n", "\\\"", "\\\\", "%d", "ç", "\t", "\n", "'"]))
+    s = '"' + "".join(partes)
+    return s + r.choice(['"', '"', '"', "\\\n", ""])
+
+
+def caractere(r):
+    return r.choice(["'a'", "'\\n'", "'\\''", "''", "'ab'", "'\n'", "'\\\n'", "'", "'\\x'"])
+
+
+def comentario(r):
+    if r.random() < 0.5:
+        return "//" + texto_livre(r, r.randint(0, 80)).replace("\n", " ")
+    corpo = texto_livre(r, r.randint(0, 90))
+    return "/*" + corpo + r.choice(["*/", "**/", "*/", "*", ""])
+
+
+def espacos(r):
+    return "".join(r.choice(" \t\n\r") for _ in range(r.choice([1, 1, 2, 4, 15, 16, 17, 33, 64])))
+
+
+def marcador(r):
+    return "\n" + r.choice(["# 12 \"x.c\"\n", "#7\n", "# \t3 lixo\n", "#define X\n", "# x\n", "#"])
+
+
+def gerar(r):
+    geradores = [identificador, numero, string, caractere, comentario, espacos, marcador,
+                 lambda r: r.choice(OPERADORES),
+                 lambda r: r.choice(["@", "$", "`", "\\", ".", "\x00", "\xff", "\x80", "é", "?", ":"])]
+    pesos = [20, 8, 4, 3, 5, 20, 2, 20, 2]
+    pecas = []
+    for _ in range(r.randint(1, 120)):
+        pecas.append(r.choices(geradores, pesos)[0](r))
+        if r.random() < 0.5:
+            pecas.append(" ")
+    return "".join(pecas).encode("utf-8", "surrogateescape")
+
+
+def executar(comando, caminho, impl=None):
+    env = dict(os.environ)
+    if impl:
+        env["SCANNER_SIMD"] = impl
+    r = subprocess.run(shlex.split(comando) + [caminho], capture_output=True, env=env)
+    return r.returncode, r.stdout, r.stderr
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compara os tokens do lexer Flex e do scanner SIMD.")
+    parser.add_argument("--casos", type=int, default=500)
+    parser.add_argument("--semente", type=int, default=1)
+    parser.add_argument("--referencia", default="./bench_flex --tokens")
+    parser.add_argument("--candidato", default="./bench_simd --tokens")
+    opcoes = parser.parse_args()
+
+    r = random.Random(opcoes.semente)
+    falhas = 0
+    with tempfile.TemporaryDirectory() as tmp:
+        caminho = os.path.join(tmp, "caso.c")
+        for caso in range(opcoes.casos):
+            dados = gerar(r)
+            with open(caminho, "wb") as f:
+                f.write(dados)
+            esperado = executar(opcoes.referencia, caminho)
+            for impl in IMPLEMENTACOES:
+                obtido = executar(opcoes.candidato, caminho, impl)
+                if obtido != esperado:
+                    falhas += 1
+                    salvo = f"fuzz_falha_{caso}.c"
+                    with open(salvo, "wb") as f:
+                        f.write(dados)
+                    print(f"[FAIL] caso {caso} ({impl}): tokens diferentes, entrada salva em {salvo}")
+                    break
+
+    total = opcoes.casos
+    print(f"{total - falhas} de {total} casos com a mesma sequência de tokens")
+    return 1 if falhas else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
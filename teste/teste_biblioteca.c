@@ -0,0 +1,71 @@
+// Biblioteca padrão do C: <math.h> com os casos de borda do C (NaN,
+// infinito, -0.0), rand() com a sequência da glibc e puts/putchar.
+int main() {
+    double x;
+    double zero;
+    int i;
+    int soma;
+    int z;
+    int primeiro;
+    long l;
+
+    zero = 0.0;
+    x = sqrt(2.0) + pow(2, 10);
+    printf("sqrt e pow: %.6f\n", x);
+    printf("arredondamento: %.1f %.1f %.1f %.1f\n", floor(-2.5), ceil(-0.5), trunc(7.9), floor(1e300) / 1e300);
+    printf("exp e log: %.6f %.6f %.6f\n", exp(1.0), log(10.0), log10(1000.0));
+    printf("trigonometria: %.6f %.6f %.6f\n", sin(1.0), cos(1.0), atan2(1.0, -1.0));
+    printf("fmod e fabs: %.2f %.2f %.2f\n", fmod(7.5, 2.0), fmod(-7.5, 2.0), fabs(-3.25));
+
+    // Fora do domínio: NaN (diferente de si mesmo); polos e estouro: infinito
+    x = sqrt(-1.0);
+    if (x != x) {
+        printf("sqrt(-1): nan\n");
+    }
+    printf("infinitos: %f %f %f %f\n", pow(10.0, 400.0), pow(-10.0, 401.0), log(zero), exp(800.0));
+
+    // Inteiros
+    l = -5000000000;
+    printf("abs: %d %ld\n", abs(-7), labs(l));
+
+    // rand() reproduz a sequência da glibc para a mesma semente
+    srand(42);
+    soma = 0;
+    for (i = 0; i < 5; i = i + 1) {
+        soma = soma + rand() % 100;
+    }
+    printf("rand: %d\n", soma);
+    rand();
+
+    // && e || só avaliam a direita quando a esquerda não decide: a
+    // sequência do rand() não pode andar, nem sair 'B' ou 'D', nem dividir por zero
+    srand(7);
+    primeiro = rand();
+    srand(7);
+    i = 0;
+    z = i && rand();
+    z = z || 1 || rand();
+    if (i != 0 && putchar(66)) {
+        z = 0;
+    }
+    if (i == 0 || putchar(68)) {
+        z = z + 1;
+    }
+    z = z + (i || putchar(67));
+    // Sem chamada, mas com divisão: também só avaliado quando preciso
+    if (i != 0 && 10 / i > 1) {
+        z = 0;
+    }
+    z = z + (i == 0 || 7 % i == 0);
+    if (rand() != primeiro || z != 4) {
+        printf("\ncurto-circuito: ERRO\n");
+        return 1;
+    }
+    printf("\ncurto-circuito: %d\n", z);
+
+    putchar(65);
+    putchar(10);
+    i = puts("puts");
+    printf("puts devolveu %d\n", i);
+    return 0;
+}
@@ -0,0 +1,51 @@
+// Operadores bit a bit, divisão e resto com a semântica do C, e as
+// reescritas do passo de simplificação (--simplificar).
+int main() {
+    int a;
+    int b;
+    int i;
+    int j;
+    int h;
+    int soma;
+
+    // Bit a bit e deslocamentos; precedência como no C
+    a = 90;
+    b = -7;
+    printf("and: %d, or: %d, xor: %d, not: %d\n", a & 12, a | 5, a ^ b, ~b);
+    printf("shl: %d, shr: %d, shr neg: %d\n", 1 << 10, a >> 3, b >> 1);
+    printf("precedencia: %d\n", 1 + 2 << 3 & 255 | 4 ^ 1);
+
+    // Divisão e resto truncam em direção a zero
+    printf("div: %d %d, mod: %d %d\n", b / 2, b / -2, b % 4, 7 % -4);
+
+    // Lógicos resultam em 0 ou 1
+    printf("logicos: %d %d %d\n", !a, a && b, 0 || b);
+
+    // Potências de dois: deslocamento e máscara quando o valor nunca é
+    // negativo, a sequência com correção de sinal quando pode ser
+    soma = 0;
+    for (i = 0; i < 40; i = i + 1) {
+        soma = soma + i / 8 + i % 16;
+    }
+    printf("nao negativo: %d\n", soma);
+    soma = 0;
+    for (i = -20; i < 20; i = i + 1) {
+        soma = soma + i / 8 * 3 + i % 16;
+    }
+    printf("com sinal: %d\n", soma);
+
+    // Identidades e constantes
+    h = (a + 0) * 1 - 0 + (b - b) + (a ^ a) + (3 * 4 - 12);
+    printf("identidades: %d\n", h);
+
+    // Redução de força: i * 8 + 3 vira um acumulador
+    soma = 0;
+    for (i = 0; i < 6; i = i + 1) {
+        for (j = 0; j < 5; j = j + 1) {
+            h = i * 8 + 3 + j;
+            soma = soma ^ (h << 2);
+        }
+    }
+    printf("inducao: %d\n", soma);
+    return 0;
+}
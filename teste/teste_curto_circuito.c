@@ -0,0 +1,41 @@
+// && e || em curto-circuito: o lado direito só é avaliado quando o
+// esquerdo não decide, o que protege divisões e deslocamentos
+int main() {
+    int x;
+    int y;
+    int z;
+    double d;
+
+    x = 0;
+    y = 7;
+    if (x != 0 && 10 / x > 1) {
+        printf("ERRO: && avaliou 10 / x\n");
+    }
+    if (x == 0 || y % x == 1) {
+        printf("|| protege o resto\n");
+    }
+    z = x != 0 && y / x;
+    z = z + (x == 0 || y / x);
+    printf("z = %d\n", z);
+
+    // Encadeados e dentro da condição de um laço
+    x = 4;
+    y = 0;
+    while (x > 0 && 100 / x > 20 && (y == 0 || 12 % y == 0)) {
+        x = x - 1;
+        y = y + 1;
+    }
+    printf("laco: %d %d\n", x, y);
+
+    // Deslocamento com contagem negativa (indefinido no C, erro no Python)
+    x = -1;
+    z = x >= 0 && (1 << x) > 0;
+    printf("deslocamento: %d\n", z);
+
+    d = 0.0;
+    if (d != 0.0 && 1.0 / d > 2.0) {
+        printf("ERRO: && avaliou 1.0 / d\n");
+    }
+    printf("fim\n");
+    return 0;
+}
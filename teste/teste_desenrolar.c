@@ -0,0 +1,49 @@
+// Laços contados: os de poucas iterações viram código reto e os demais são
+// desenrolados parcialmente (--desenrolar=N), com um laço para o resto.
+int main() {
+    int i;
+    int j;
+    int n;
+    int soma;
+
+    // for com número de iterações conhecido: desenrolado por completo
+    soma = 0;
+    for (i = 0; i < 4; i = i + 1) {
+        soma = soma + i;
+    }
+    printf("soma: %d, i: %d\n", soma, i);
+
+    // Aninhados: o interno é desenrolado antes do externo
+    soma = 0;
+    for (i = 0; i < 3; i = i + 1) {
+        for (j = 3; j > 0; j = j - 1) {
+            soma = soma + i * j;
+        }
+    }
+    printf("aninhados: %d\n", soma);
+
+    // Limite em variável: desenrolamento parcial mais o resto
+    n = 10;
+    soma = 0;
+    i = 0;
+    while (i < n) {
+        soma = soma + i;
+        i = i + 1;
+    }
+    printf("parcial: %d\n", soma);
+
+    // do-while de iterações conhecidas
+    i = 5;
+    do {
+        soma = soma - 1;
+        i = i - 2;
+    } while (i > 0);
+    printf("do-while: %d, i: %d\n", soma, i);
+
+    // Nenhuma iteração
+    for (i = 0; i > 5; i = i + 1) {
+        soma = 0;
+    }
+    printf("final: %d\n", soma);
+    return 0;
+}
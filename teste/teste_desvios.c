@@ -0,0 +1,61 @@
+// break e continue nativos nos três laços (viram `break`/`continue` do
+// Python, sem variáveis de controle)
+int main() {
+    int i;
+    int j;
+    int n;
+    int soma;
+    int achou;
+
+    // for: o continue ainda executa o incremento
+    soma = 0;
+    for (i = 0; i < 20; i = i + 1) {
+        if (i % 3 == 0) {
+            continue;
+        }
+        if (i > 15) {
+            break;
+        }
+        soma = soma + i;
+    }
+    printf("for: %d %d\n", soma, i);
+
+    // while com busca: o break só sai do laço de dentro
+    achou = 0;
+    n = 0;
+    while (n < 10) {
+        n = n + 1;
+        for (j = 2; j < n; j = j + 1) {
+            if (n % j == 0) {
+                break;
+            }
+        }
+        if (j < n) {
+            continue;
+        }
+        achou = achou + 1;
+    }
+    printf("primos: %d\n", achou);
+
+    // do-while: o continue ainda testa a condição do fim
+    i = 0;
+    soma = 0;
+    do {
+        i = i + 1;
+        if (i == 5) {
+            continue;
+        }
+        soma = soma + i;
+    } while (i < 10);
+    printf("do: %d %d\n", soma, i);
+
+    i = 0;
+    do {
+        i = i + 1;
+        if (i > 3) {
+            break;
+        }
+    } while (1);
+    printf("laco infinito: %d\n", i);
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Código morto removido pelo passo de eliminação (--eliminar): nada do que
+// some aqui pode mudar a saída.
+int main() {
+    int a;
+    int b;
+    int c;
+    int i;
+    int soma;
+
+    // Escritas mortas: só a última atribuição de `a` é lida
+    a = 1;
+    a = 2;
+    b = a * 10;
+    a = 7;
+    c = b + a;
+    printf("escritas: %d %d\n", b, c);
+
+    // Braços vazios e condições constantes
+    if (c > 10) {
+    } else {
+        printf("nunca\n");
+    }
+    if (b == 20) {
+    } else {
+    }
+    if (0) {
+        printf("nunca\n");
+    }
+    if (1) {
+        printf("sempre: %d\n", c);
+    } else {
+        printf("nunca\n");
+    }
+    while (0) {
+        printf("nunca\n");
+    }
+
+    // Valor morto dentro do laço, mas vivo na volta seguinte
+    soma = 0;
+    a = 0;
+    for (i = 0; i < 10; i = i + 1) {
+        soma = soma + a;
+        a = i;
+        b = i * 3;
+    }
+    printf("laco: %d\n", soma);
+
+    // Laço que só sai por return: o que vem depois é inalcançável
+    i = 0;
+    while (1) {
+        i = i + 3;
+        if (i > 20) {
+            printf("saiu: %d\n", i);
+            return 0;
+            printf("nunca\n");
+        }
+    }
+    printf("nunca\n");
+    return 1;
+}
@@ -0,0 +1,20 @@
+// Várias funções no mesmo arquivo: cada uma é traduzida e liberada
+// assim que termina, e as variáveis de uma não são vistas pelas outras.
+int quadrado() {
+    int x;
+    x = 7;
+    return x * x;
+}
+
+void vazia() {
+}
+
+int main() {
+    int x;
+    x = 3;
+    printf("x = %d\n", x);
+    while (x > 0) {
+        x = x - 1;
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+// Pré-processador: macros, header protegido incluído duas vezes e a
+// numeração de linhas depois de cada #include (as posições de
+// depois_include e depois_cache são conferidas no HLIR pelos scripts de teste)
+#include "teste_preproc.h"
+#include "teste_preproc.h"
+#include "teste_preproc_passo.h"
+
+#define DOBRO(x) ((x) + (x))
+#define SOMA3(a, b, c) (DOBRO(a) + (b) * (c))
+#define DEPURAR
+
+int main() {
+    int erros;
+    int depois_include;
+    int depois_cache;
+
+    erros = 0;
+    depois_include = PASSO;
+    if (QUADRADO(LIMITE + 1) != 121) {
+        erros = erros + 1;
+    }
+    if (SOMA3(2, 3, 4) != 16) {
+        erros = erros + 1;
+    }
+#include "teste_preproc_passo.h"
+    depois_cache = PASSO * 2;
+    if (depois_include != 5 || depois_cache != 10) {
+        erros = erros + 1;
+    }
+
+#ifdef DEPURAR
+    printf("DEPURAR definida\n");
+#else
+    erros = erros + 1;
+#endif
+#if LIMITE * 2 > 15 && defined(DEPURAR)
+    printf("LIMITE = %d\n", LIMITE);
+#else
+    erros = erros + 1;
+#endif
+#undef DEPURAR
+#ifdef DEPURAR
+    erros = erros + 1;
+#endif
+
+    if (erros != 0) {
+        printf("macros: ERRO (%d)\n", erros);
+    }
+    return 0;
+}
@@ -0,0 +1,13 @@
+// Header com include guard, incluído duas vezes por teste_preproc.c
+#ifndef TESTE_PREPROC_H
+#define TESTE_PREPROC_H
+
+#define LIMITE 10
+#define QUADRADO(x) ((x) * (x))
+
+// Aparece uma única vez no HLIR, com a linha do header
+int limite_ao_quadrado() {
+    return QUADRADO(LIMITE);
+}
+
+#endif
@@ -0,0 +1,3 @@
+// Sem include guard: a segunda inclusão é reproduzida do cache
+#undef PASSO
+#define PASSO (LIMITE / 2)
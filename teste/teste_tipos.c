@@ -0,0 +1,66 @@
+// Tipos escalares do C (LP64): larguras, sinal, conversões, literais com
+// sufixo e em hexadecimal/octal, divisão exata em 64 bits e double.
+int main() {
+    char c;
+    signed char sc;
+    unsigned char uc;
+    short s;
+    unsigned short us;
+    unsigned int u;
+    long l;
+    unsigned long ul;
+    long long ll;
+    unsigned long long ull;
+    float f;
+    double d;
+
+    // Atribuição ajusta o valor à largura do destino
+    uc = 250;
+    uc = uc + 10;
+    sc = 127;
+    sc = sc + 1;
+    s = 40000;
+    us = -1;
+    printf("estreitos: %d %d %d %d\n", uc, sc, s, us);
+
+    // Sem sinal: aritmética módulo 2^N
+    u = 0;
+    u = u - 1;
+    printf("unsigned: %u %u %u\n", u, u * u, u + 2);
+    ull = 18446744073709551615ULL;
+    ull = ull + 2;
+    printf("unsigned long long: %llu\n", ull);
+
+    // Conversões usuais: -1 vira unsigned na comparação
+    if (u > -1) {
+        printf("comparacao: errada\n");
+    } else {
+        printf("comparacao: -1 convertido para unsigned\n");
+    }
+
+    // Literais: hexadecimal, octal, sufixos e caracteres
+    l = 0x7fffffffffffffffL;
+    ul = 0777UL;
+    c = 'A' + 2;
+    printf("literais: %ld %lu %c %d\n", l, ul, c, 'z');
+
+    // Divisão e resto truncam para zero, exatos além de 2^53
+    ll = -9007199254740993LL;
+    printf("long long: %lld %lld\n", ll / 7, ll % 7);
+    ll = 9007199254740993LL;
+    printf("long long: %lld\n", ll / 3);
+    printf("unsigned: %u %u\n", u / 10, u % 10);
+
+    // Deslocamentos usam o tipo do operando da esquerda
+    ul = 1;
+    printf("deslocamento: %lu %d\n", ul << 40, 1 << 4);
+
+    // double com todos os bits; int convertido na atribuição
+    d = 0.1;
+    printf("double: %.17g\n", d * 3);
+    d = s;
+    printf("double: %f\n", d / 3);
+    f = 2.5f;
+    printf("float: %f\n", f * 2);
+    return 0;
+}